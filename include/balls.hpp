@@ -0,0 +1,89 @@
+// balls.hpp - structure-of-arrays ball store with a batched integrate / wall-bounce pass
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// Positions, velocities and previous positions live in separate arrays so the per-tick
+// integrate pass is one tight loop with no images or per-ball branches beyond the active
+// flag. Images are chosen at draw time from the murder flag. Header-only and templated on
+// the scalar type (float or fx::Fixed) so host tools can benchmark the same code.
+namespace balls {
+
+enum : uint8_t { kActive = 1, kMurder = 2 };
+
+template <typename T>
+struct Store {
+    std::vector<T> x, y, vx, vy, px, py;
+    std::vector<uint8_t> flags;
+
+    int size() const { return (int)flags.size(); }
+    bool empty() const { return flags.empty(); }
+    bool active(int i) const { return (flags[i] & kActive) != 0; }
+    bool murder(int i) const { return (flags[i] & kMurder) != 0; }
+
+    void reserve(int n) {
+        x.reserve(n); y.reserve(n); vx.reserve(n); vy.reserve(n); px.reserve(n); py.reserve(n); flags.reserve(n);
+    }
+    void clear() {
+        x.clear(); y.clear(); vx.clear(); vy.clear(); px.clear(); py.clear(); flags.clear();
+    }
+    void deactivate_all() { for (auto &f : flags) f &= (uint8_t)~kActive; }
+
+    // Put a ball in the first inactive slot, or append one; returns its index
+    int add(T x0, T y0, T vx0, T vy0, bool isMurder) {
+        uint8_t f = (uint8_t)(kActive | (isMurder ? kMurder : 0));
+        int n = size();
+        for (int i = 0; i < n; ++i) {
+            if (flags[i] & kActive) continue;
+            x[i] = x0; y[i] = y0; vx[i] = vx0; vy[i] = vy0; px[i] = x0; py[i] = y0; flags[i] = f;
+            return i;
+        }
+        x.push_back(x0); y.push_back(y0); vx.push_back(vx0); vy.push_back(vy0);
+        px.push_back(x0); py.push_back(y0); flags.push_back(f);
+        return n;
+    }
+};
+
+struct Counts {
+    int active = 0;   // all active balls
+    int regular = 0;  // active non-murder balls
+};
+
+template <typename T>
+Counts count(const Store<T> &s)
+{
+    Counts c;
+    const int n = s.size();
+    for (int i = 0; i < n; ++i) {
+        uint8_t f = s.flags[i];
+        c.active += f & kActive;
+        c.regular += (f & (kActive | kMurder)) == kActive;
+    }
+    return c;
+}
+
+// Save previous positions, advance one tick and reflect off the side and top walls for
+// every active ball from index `first` on. right is the right wall minus the ball width.
+// Returns the number of wall bounces (callers play one sound for the batch).
+template <typename T>
+int integrate(Store<T> &s, int first, T left, T right, T top)
+{
+    int bounces = 0;
+    const int n = s.size();
+    T *x = s.x.data(), *y = s.y.data(), *vx = s.vx.data(), *vy = s.vy.data();
+    T *px = s.px.data(), *py = s.py.data();
+    const uint8_t *flags = s.flags.data();
+    for (int i = first; i < n; ++i) {
+        if (!(flags[i] & kActive)) continue;
+        px[i] = x[i];
+        py[i] = y[i];
+        x[i] += vx[i];
+        y[i] += vy[i];
+        if (x[i] < left) { x[i] = left; vx[i] = -vx[i]; ++bounces; }
+        if (x[i] > right) { x[i] = right; vx[i] = -vx[i]; ++bounces; }
+        if (y[i] < top) { y[i] = top; vy[i] = -vy[i]; ++bounces; }
+    }
+    return bounces;
+}
+
+} // namespace balls
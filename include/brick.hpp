@@ -1,5 +1,6 @@
-// brick.hpp - Enumerated brick types matching legacy shorthand order
+// brick.hpp - Enumerated brick types matching legacy shorthand order, plus their traits table
 #pragma once
+#include <cstdint>
 
 enum class BrickType : int {
     NB=0, YB, GB, CB, TB, PB, RB, LB, SB, FB, F1, F2, B1, B2, B3, B4, B5,
@@ -7,9 +8,109 @@ enum class BrickType : int {
     COUNT
 };
 
-inline bool brick_is_breakable(BrickType t) {
-    switch(t) {
-        case BrickType::NB: case BrickType::ID: case BrickType::OF: case BrickType::ON: return false;
-        default: return true;
-    }
+// Behaviour flags (BrickTraits::flags)
+enum : uint8_t {
+    kBrickBreakable     = 1 << 0, // counts as breakable (levels_remaining_breakable)
+    kBrickRequired      = 1 << 1, // must be cleared to finish a level
+    kBrickMoving        = 1 << 2, // side-moving; drawn and collided dynamically by game.cpp
+    kBrickPassThrough   = 1 << 3, // the ball keeps going instead of bouncing
+    kBrickMultiHit      = 1 << 4, // takes several hits (hp > 1), sprite follows hp
+    kBrickBomb          = 1 << 5,
+    kBrickIndestructible= 1 << 6, // never removed by hits or blasts
+    kBrickBatHazard     = 1 << 7, // destroying it drops a falling kill brick (F1/F2)
+};
+
+// Hit sound (index into the caller's sound name table)
+enum class BrickSfx : uint8_t { Normal, Hard };
+
+// What a hit on the brick does besides scoring
+enum class BrickEffect : uint8_t {
+    None,
+    Pickup,      // falling effect pickup; param = BrickPickup
+    ExtraBall,   // split off a regular ball
+    MurderBall,  // split off a murder ball
+    SlowBall,    // slow the hitting ball
+    FastBall,    // speed up the hitting ball
+    Laser,       // falling laser pickup
+    BatSize,     // falling bat pickup; param 0 = small, 1 = big
+    BonusLetter, // falling B-O-N-U-S letter; param = letter index
+};
+
+// Effect pickups in the same order as game.cpp's PK_* codes (PK_LIFE + kind - 1)
+enum class BrickPickup : uint8_t { None, Life, Slow, Fast, Rewind, Reverse, Forward, Bonus1000, LightsOff, LightsOn };
+
+struct BrickTraits {
+    char code[3];       // legacy 2-character shorthand used in .DAT files
+    uint8_t flags;
+    uint8_t hp;         // hit points when a level is loaded (0 = not hittable)
+    uint16_t score;     // added on every hit
+    BrickSfx sfx;
+    BrickEffect effect;
+    uint8_t param;      // effect argument (see BrickEffect)
+};
+
+namespace brick_detail {
+static constexpr uint8_t B = kBrickBreakable, R = kBrickRequired;
+static constexpr BrickEffect NONE = BrickEffect::None, PICK = BrickEffect::Pickup;
+static constexpr BrickSfx N = BrickSfx::Normal, H = BrickSfx::Hard;
+}
+
+// One row per BrickType, in enum order. Atlas indices stay in levels.cpp (brickMap) because
+// IMAGE.h is generated by the 3DS build and this header is shared with the host tools.
+static constexpr BrickTraits kBrickTraits[] = {
+#define P(k) (uint8_t)BrickPickup::k
+    //  code  flags                                  hp score sfx              effect                    param
+    { "NB", 0,                                        0,   0, brick_detail::N, brick_detail::NONE,          0 },
+    { "YB", brick_detail::B | brick_detail::R,        1,  10, brick_detail::N, brick_detail::NONE,          0 },
+    { "GB", brick_detail::B | brick_detail::R,        1,  20, brick_detail::N, brick_detail::NONE,          0 },
+    { "CB", brick_detail::B | brick_detail::R,        1,  30, brick_detail::N, brick_detail::NONE,          0 },
+    { "TB", brick_detail::B | brick_detail::R,        1,  40, brick_detail::N, brick_detail::NONE,          0 },
+    { "PB", brick_detail::B | brick_detail::R,        1,  50, brick_detail::N, brick_detail::NONE,          0 },
+    { "RB", brick_detail::B | brick_detail::R,        1, 100, brick_detail::N, brick_detail::NONE,          0 },
+    { "LB", brick_detail::B,                          1,   0, brick_detail::N, brick_detail::PICK,          P(Life) },
+    { "SB", brick_detail::B,                          1,   0, brick_detail::N, brick_detail::PICK,          P(Slow) },
+    { "FB", brick_detail::B,                          1,   0, brick_detail::N, brick_detail::PICK,          P(Fast) },
+    { "F1", brick_detail::B | kBrickBatHazard,        1,   0, brick_detail::N, brick_detail::NONE,          0 },
+    { "F2", brick_detail::B | kBrickBatHazard,        1,   0, brick_detail::N, brick_detail::NONE,          0 },
+    { "B1", brick_detail::B,                          1,   0, brick_detail::N, BrickEffect::BonusLetter,    0 },
+    { "B2", brick_detail::B,                          1,   0, brick_detail::N, BrickEffect::BonusLetter,    1 },
+    { "B3", brick_detail::B,                          1,   0, brick_detail::N, BrickEffect::BonusLetter,    2 },
+    { "B4", brick_detail::B,                          1,   0, brick_detail::N, BrickEffect::BonusLetter,    3 },
+    { "B5", brick_detail::B,                          1,   0, brick_detail::N, BrickEffect::BonusLetter,    4 },
+    { "BS", brick_detail::B,                          1,   0, brick_detail::N, BrickEffect::BatSize,        0 },
+    { "BB", brick_detail::B,                          1,   0, brick_detail::N, BrickEffect::BatSize,        1 },
+    { "ID", kBrickIndestructible,                     0,   0, brick_detail::H, brick_detail::NONE,          0 },
+    { "RW", brick_detail::B,                          1,   0, brick_detail::N, brick_detail::PICK,          P(Rewind) },
+    { "RE", brick_detail::B,                          1,   0, brick_detail::N, brick_detail::PICK,          P(Reverse) },
+    { "IS", brick_detail::B | kBrickPassThrough,      1,   0, brick_detail::N, BrickEffect::SlowBall,       0 },
+    { "IF", brick_detail::B | kBrickPassThrough,      1,   0, brick_detail::N, BrickEffect::FastBall,       0 },
+    { "AB", brick_detail::B | kBrickPassThrough,      1,   0, brick_detail::N, BrickEffect::ExtraBall,      0 },
+    { "FO", brick_detail::B,                          1,   0, brick_detail::N, brick_detail::PICK,          P(Forward) },
+    { "LA", brick_detail::B,                          1,   0, brick_detail::N, BrickEffect::Laser,          0 },
+    { "MB", brick_detail::B | kBrickPassThrough,      1,   0, brick_detail::N, BrickEffect::MurderBall,     0 },
+    { "BA", brick_detail::B,                          1,   0, brick_detail::N, brick_detail::PICK,          P(Bonus1000) },
+    { "T5", brick_detail::B | kBrickMultiHit,         5,  60, brick_detail::H, brick_detail::NONE,          0 },
+    { "BO", brick_detail::B | kBrickBomb,             1, 120, brick_detail::N, brick_detail::NONE,          0 },
+    { "OF", 0,                                        1,   0, brick_detail::N, brick_detail::PICK,          P(LightsOff) },
+    { "ON", 0,                                        1,   0, brick_detail::N, brick_detail::PICK,          P(LightsOn) },
+    { "SS", brick_detail::B | brick_detail::R | kBrickMoving, 1, 0, brick_detail::N, brick_detail::NONE,   0 },
+    { "SF", brick_detail::B | kBrickMoving,           1,   0, brick_detail::H, brick_detail::NONE,          0 },
+#undef P
+};
+static_assert(sizeof(kBrickTraits) / sizeof(kBrickTraits[0]) == (size_t)BrickType::COUNT,
+              "kBrickTraits needs exactly one row per BrickType");
+static_assert(kBrickTraits[(int)BrickType::SF].code[1] == 'F' && kBrickTraits[(int)BrickType::T5].hp == 5,
+              "kBrickTraits rows are out of enum order");
+
+// Traits of a raw grid value; anything out of range reads as NB
+inline const BrickTraits& brick_traits(int raw) {
+    return kBrickTraits[(unsigned)raw < (unsigned)BrickType::COUNT ? raw : 0];
 }
+inline const BrickTraits& brick_traits(BrickType t) { return brick_traits((int)t); }
+
+inline bool brick_is_breakable(BrickType t) { return (brick_traits(t).flags & kBrickBreakable) != 0; }
+// Bricks that must be cleared to finish a level
+inline bool brick_is_required(BrickType t) { return (brick_traits(t).flags & kBrickRequired) != 0; }
+// Side-moving bricks (slow/hard); drawn and collided dynamically by game.cpp
+inline bool brick_is_moving(BrickType t) { return (brick_traits(t).flags & kBrickMoving) != 0; }
+inline bool brick_is_bomb(BrickType t) { return (brick_traits(t).flags & kBrickBomb) != 0; }
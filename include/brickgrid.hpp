@@ -0,0 +1,224 @@
+// brickgrid.hpp - bitboard occupancy masks and an inline read-only view of the brick grid
+#pragma once
+#include <cstdint>
+#include "brick.hpp"
+
+namespace brickgrid {
+
+static constexpr int kCols = 13;
+static constexpr int kRows = 13;
+static constexpr int kCells = kCols * kRows;       // 169
+static constexpr int kWords = (kCells + 63) / 64;  // 3 x 64-bit words
+static constexpr uint32_t kRowBits = (1u << kCols) - 1u;
+static constexpr uint64_t kLastWordBits = (~(uint64_t)0) >> (kWords * 64 - kCells); // valid bits of w[kWords-1]
+
+// 169-bit set over the grid, bit index = row * kCols + col
+struct Mask {
+    uint64_t w[kWords];
+
+    void clear() { for (int i = 0; i < kWords; ++i) w[i] = 0; }
+    bool test(int i) const { return (w[i >> 6] >> (i & 63)) & 1u; }
+    void set(int i) { w[i >> 6] |= (uint64_t)1 << (i & 63); }
+    void reset(int i) { w[i >> 6] &= ~((uint64_t)1 << (i & 63)); }
+    bool any() const { return (w[0] | w[1] | w[2]) != 0; }
+    int count() const {
+        return __builtin_popcountll(w[0]) + __builtin_popcountll(w[1]) + __builtin_popcountll(w[2]);
+    }
+    // Next set bit at or after index i, or -1 (for iterating: for(i=m.next(0); i>=0; i=m.next(i+1)))
+    int next(int i) const {
+        while (i < kCells) {
+            int wi = i >> 6;
+            uint64_t bits = w[wi] >> (i & 63);
+            if (bits) return i + __builtin_ctzll(bits);
+            i = (wi + 1) << 6;
+        }
+        return -1;
+    }
+    // The kCols bits of one row (bit c == column c); a row may straddle two words
+    uint32_t row(int r) const {
+        int i = r * kCols, wi = i >> 6, sh = i & 63;
+        uint64_t bits = w[wi] >> sh;
+        if (sh + kCols > 64 && wi + 1 < kWords) bits |= w[wi + 1] << (64 - sh);
+        return (uint32_t)bits & kRowBits;
+    }
+    // Any bit set in the inclusive cell rectangle (callers pass in-range coordinates)
+    bool any_in_rect(int c0, int r0, int c1, int r1) const {
+        uint32_t cols = (kRowBits >> (kCols - 1 - c1)) & ~((1u << c0) - 1u);
+        for (int r = r0; r <= r1; ++r) if (row(r) & cols) return true;
+        return false;
+    }
+};
+
+inline Mask operator|(const Mask& a, const Mask& b) { Mask m; for (int i = 0; i < kWords; ++i) m.w[i] = a.w[i] | b.w[i]; return m; }
+inline Mask operator&(const Mask& a, const Mask& b) { Mask m; for (int i = 0; i < kWords; ++i) m.w[i] = a.w[i] & b.w[i]; return m; }
+// a without the bits of b
+inline Mask minus(const Mask& a, const Mask& b) { Mask m; for (int i = 0; i < kWords; ++i) m.w[i] = a.w[i] & ~b.w[i]; return m; }
+
+// Bit i moved to i + k (k may be negative); bits leaving the grid are dropped
+inline Mask shifted(const Mask& m, int k) {
+    Mask out;
+    const int n = k < 0 ? -k : k, ws = n >> 6, bs = n & 63;
+    for (int i = 0; i < kWords; ++i) {
+        int src = k < 0 ? i + ws : i - ws;
+        uint64_t v = 0;
+        if (src >= 0 && src < kWords) {
+            if (k < 0) {
+                v = m.w[src] >> bs;
+                if (bs && src + 1 < kWords) v |= m.w[src + 1] << (64 - bs);
+            } else {
+                v = m.w[src] << bs;
+                if (bs && src > 0) v |= m.w[src - 1] >> (64 - bs);
+            }
+        }
+        out.w[i] = v;
+    }
+    out.w[kWords - 1] &= kLastWordBits;
+    return out;
+}
+inline Mask column_mask(int c) { Mask m; m.clear(); for (int r = 0; r < kRows; ++r) m.set(r * kCols + c); return m; }
+
+// m plus every cell 8-adjacent to a cell of m (row wrap-around masked off)
+inline Mask dilate8(const Mask& m) {
+    static const Mask firstCol = column_mask(0), lastCol = column_mask(kCols - 1);
+    Mask h = m | minus(shifted(m, 1), firstCol) | minus(shifted(m, -1), lastCol);
+    return h | shifted(h, kCols) | shifted(h, -kCols);
+}
+
+// Connected bomb clusters (8-neighbour rule) as a union-find forest over the grid cells.
+// Adding a bomb unions it with its bomb neighbours. Removing one cannot be undone in a
+// union-find, so its cluster is only marked stale and is re-split from its member ring the
+// next time it is queried; a stale cluster may still list removed cells until then.
+struct BombClusters {
+    int16_t parent[kCells];  // -1 = not in any cluster
+    int16_t ring[kCells];    // circular list of each cluster's members (spliced by unite)
+    Mask stale;              // roots of clusters that lost a bomb since they were built
+
+    void clear() {
+        for (int i = 0; i < kCells; ++i) { parent[i] = -1; ring[i] = (int16_t)i; }
+        stale.clear();
+    }
+    int find(int i) {
+        while (parent[i] != i) { parent[i] = parent[parent[i]]; i = parent[i]; } // path halving
+        return i;
+    }
+    // Bomb placed at i (bomb already includes it)
+    void add(int i, const Mask& bomb) {
+        if (parent[i] >= 0) resplit(find(i), bomb); // removed earlier and cluster not re-split yet: rejoins it
+        else { parent[i] = (int16_t)i; ring[i] = (int16_t)i; }
+        Mask around = minus(dilate8(single(i)) & bomb, single(i));
+        for (int j = around.next(0); j >= 0; j = around.next(j + 1)) unite(i, j);
+    }
+    // Bomb at i removed (bomb no longer includes it)
+    void remove(int i) { if (parent[i] >= 0) stale.set(find(i)); }
+    // Bomb cells of the cluster holding bomb cell i
+    Mask members(int i, const Mask& bomb) {
+        Mask m; m.clear();
+        if (parent[i] < 0) return m;
+        int root = find(i);
+        if (stale.test(root)) {
+            resplit(root, bomb);
+            if (parent[i] < 0) return m;
+            root = find(i);
+        }
+        int j = root;
+        do { m.set(j); j = ring[j]; } while (j != root);
+        return m;
+    }
+
+private:
+    static Mask single(int i) { Mask m; m.clear(); m.set(i); return m; }
+    void unite(int a, int b) {
+        int ra = find(a), rb = find(b);
+        if (ra == rb) return;
+        parent[rb] = (int16_t)ra;
+        int16_t t = ring[ra]; ring[ra] = ring[rb]; ring[rb] = t; // splice the two rings
+        if (stale.test(rb)) { stale.reset(rb); stale.set(ra); }
+    }
+    // Rebuild the clusters of one stale cluster's surviving bombs
+    void resplit(int root, const Mask& bomb) {
+        stale.reset(root);
+        Mask old; old.clear();
+        int j = root;
+        do { old.set(j); j = ring[j]; } while (j != root);
+        for (int k = old.next(0); k >= 0; k = old.next(k + 1)) { parent[k] = bomb.test(k) ? (int16_t)k : -1; ring[k] = (int16_t)k; }
+        Mask live = old & bomb;
+        for (int k = live.next(0); k >= 0; k = live.next(k + 1)) {
+            Mask around = minus(dilate8(single(k)) & live, single(k));
+            for (int n = around.next(0); n >= 0; n = around.next(n + 1)) unite(k, n);
+        }
+    }
+};
+
+// Per-level occupancy: every non-empty cell plus the categories gameplay queries most.
+// Versions come from this grid's own counter, so they only mean something for the same
+// Occupancy: caches key on its address as well as a version.
+struct Occupancy {
+    Mask any, breakable, required, moving, bomb;
+    Mask solid;                      // static cells a ball bounces off (not moving or pass-through)
+    BombClusters bombClusters;       // connectivity of the bomb mask, kept in sync by set()
+    int requiredCount = 0; // bits set in required, maintained incrementally
+    uint32_t rowVersion[kRows] = {}; // restamped on any change in a row (lets callers cache per-row data)
+    uint16_t column[kCols] = {};     // bit r set when cell (c, r) is occupied (height map)
+    uint32_t colVersion[kCols] = {}; // restamped on any change in a column
+    uint32_t version = 0;            // restamped on any change at all
+    uint32_t stamp = 0;              // last stamp handed out (kept across clear/rebuild)
+
+    uint32_t next_stamp() { return ++stamp; }
+
+    void clear() {
+        any.clear(); breakable.clear(); required.clear(); moving.clear(); bomb.clear(); solid.clear(); requiredCount = 0;
+        bombClusters.clear();
+        version = next_stamp();
+        for (int r = 0; r < kRows; ++r) rowVersion[r] = next_stamp();
+        for (int c = 0; c < kCols; ++c) { column[c] = 0; colVersion[c] = next_stamp(); }
+    }
+    // Lowest occupied row of column c (largest r), or -1 if the column is empty
+    int lowest_in_column(int c) const { return column[c] ? 31 - __builtin_clz(column[c]) : -1; }
+    // Nearest occupied row at or above row r in column c (r itself counts), or -1
+    int next_at_or_above(int c, int r) const {
+        if (r < 0) return -1;
+        uint32_t bits = r >= kRows - 1 ? column[c] : column[c] & ((2u << r) - 1u);
+        return bits ? 31 - __builtin_clz(bits) : -1;
+    }
+    // Record that cell i now holds raw type (0 = empty)
+    void set(int i, int type) {
+        const int c = i % kCols, r = i / kCols;
+        rowVersion[r] = next_stamp();
+        colVersion[c] = next_stamp();
+        version = next_stamp();
+        column[c] &= (uint16_t)~(1u << r);
+        if (required.test(i)) --requiredCount;
+        if (bomb.test(i)) { bomb.reset(i); bombClusters.remove(i); }
+        any.reset(i); breakable.reset(i); required.reset(i); moving.reset(i); solid.reset(i);
+        if (type <= 0) return;
+        const uint8_t f = brick_traits(type).flags;
+        any.set(i);
+        column[c] |= (uint16_t)(1u << r);
+        if (f & kBrickBreakable) breakable.set(i);
+        if (f & kBrickRequired) { required.set(i); ++requiredCount; }
+        if (f & kBrickMoving) moving.set(i);
+        if (f & kBrickBomb) { bomb.set(i); bombClusters.add(i, bomb); }
+        if (!(f & (kBrickMoving | kBrickPassThrough))) solid.set(i);
+    }
+    void rebuild(const uint8_t* bricks, int n) {
+        clear();
+        for (int i = 0; i < n && i < kCells; ++i) if (bricks[i]) set(i, bricks[i]);
+    }
+};
+
+// Read-only view of the current level owned by levels.cpp. Lookups are inline;
+// at() keeps the levels_brick_at() contract (-1 when out of range or no level).
+struct GridView {
+    const uint8_t* bricks = nullptr;
+    const uint8_t* hp = nullptr;
+    const Occupancy* occ = nullptr;
+
+    bool valid() const { return bricks != nullptr; }
+    static bool in_range(int c, int r) { return c >= 0 && c < kCols && r >= 0 && r < kRows; }
+    int at(int c, int r) const { return (bricks && in_range(c, r)) ? (int)bricks[r * kCols + c] : -1; }
+    int hp_at(int c, int r) const { return (hp && in_range(c, r)) ? (int)hp[r * kCols + c] : 0; }
+    bool occupied(int c, int r) const { return occ && in_range(c, r) && occ->any.test(r * kCols + c); }
+    bool empty() const { return !occ || !occ->any.any(); }
+};
+
+} // namespace brickgrid
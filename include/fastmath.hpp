@@ -0,0 +1,148 @@
+// fastmath.hpp - table sin/cos, fast atan2 and reciprocal sqrt for simulation hot paths
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include "fixed.hpp"
+
+// The 3DS's ARM11 has no fast transcendental support, so libm sin/cos/atan2 are long calls.
+// Here angles index a quarter-wave sine table (kSteps per turn, Q16.16 entries) with linear
+// interpolation between steps: error < 2e-5 in float and < 4e-5 in Q16.16, over any range.
+// The table is integer, so float and fixed builds read the same values. atan2 is an
+// octant-reduced polynomial (error < 0.002 rad) and rsqrt a bit-level guess refined by two Newton steps (relative error
+// < 1e-5). tools/bench_fastmath.cpp checks all of them against libm. Header-only and
+// overloaded for float and fx::Fixed like the fx:: scalar helpers.
+namespace fastmath {
+
+static const int kTurnBits = 10;
+static const int kSteps = 1 << kTurnBits;  // table steps per turn
+static const int kQuarter = kSteps / 4;
+
+// sin(k * 2pi / kSteps) for k = 0..kQuarter in Q16.16
+static const int32_t kQuarterSin[kQuarter + 1] = {
+    0, 402, 804, 1206, 1608, 2010, 2412, 2814, 3216, 3617, 4019, 4420,
+    4821, 5222, 5623, 6023, 6424, 6824, 7224, 7623, 8022, 8421, 8820, 9218,
+    9616, 10014, 10411, 10808, 11204, 11600, 11996, 12391, 12785, 13180, 13573, 13966,
+    14359, 14751, 15143, 15534, 15924, 16314, 16703, 17091, 17479, 17867, 18253, 18639,
+    19024, 19409, 19792, 20175, 20557, 20939, 21320, 21699, 22078, 22457, 22834, 23210,
+    23586, 23961, 24335, 24708, 25080, 25451, 25821, 26190, 26558, 26925, 27291, 27656,
+    28020, 28383, 28745, 29106, 29466, 29824, 30182, 30538, 30893, 31248, 31600, 31952,
+    32303, 32652, 33000, 33347, 33692, 34037, 34380, 34721, 35062, 35401, 35738, 36075,
+    36410, 36744, 37076, 37407, 37736, 38064, 38391, 38716, 39040, 39362, 39683, 40002,
+    40320, 40636, 40951, 41264, 41576, 41886, 42194, 42501, 42806, 43110, 43412, 43713,
+    44011, 44308, 44604, 44898, 45190, 45480, 45769, 46056, 46341, 46624, 46906, 47186,
+    47464, 47741, 48015, 48288, 48559, 48828, 49095, 49361, 49624, 49886, 50146, 50404,
+    50660, 50914, 51166, 51417, 51665, 51911, 52156, 52398, 52639, 52878, 53114, 53349,
+    53581, 53812, 54040, 54267, 54491, 54714, 54934, 55152, 55368, 55582, 55794, 56004,
+    56212, 56418, 56621, 56823, 57022, 57219, 57414, 57607, 57798, 57986, 58172, 58356,
+    58538, 58718, 58896, 59071, 59244, 59415, 59583, 59750, 59914, 60075, 60235, 60392,
+    60547, 60700, 60851, 60999, 61145, 61288, 61429, 61568, 61705, 61839, 61971, 62101,
+    62228, 62353, 62476, 62596, 62714, 62830, 62943, 63054, 63162, 63268, 63372, 63473,
+    63572, 63668, 63763, 63854, 63944, 64031, 64115, 64197, 64277, 64354, 64429, 64501,
+    64571, 64639, 64704, 64766, 64827, 64884, 64940, 64993, 65043, 65091, 65137, 65180,
+    65220, 65259, 65294, 65328, 65358, 65387, 65413, 65436, 65457, 65476, 65492, 65505,
+    65516, 65525, 65531, 65535, 65536
+};
+
+// sin of table step k (any integer; wraps every kSteps), Q16.16
+inline int32_t step_sin(int32_t k) {
+    k &= kSteps - 1;
+    const int32_t off = k & (kQuarter - 1);
+    switch (k / kQuarter) {
+    case 0: return kQuarterSin[off];
+    case 1: return kQuarterSin[kQuarter - off];
+    case 2: return -kQuarterSin[off];
+    default: return -kQuarterSin[kQuarter - off];
+    }
+}
+// sin at step position t in Q16.16 steps (t >> 16 is the step), Q16.16
+inline int32_t steps_sin_raw(int64_t t) {
+    const int32_t k = (int32_t)(t >> 16);
+    const int32_t a = step_sin(k), b = step_sin(k + 1);
+    return a + (int32_t)(((int64_t)(b - a) * (t & 0xFFFF) + 0x8000) >> 16);
+}
+
+// ---- float ----
+static const float kStepsPerRadian = (float)kSteps / 6.28318531f;
+
+inline float steps_sin(float t) {
+    int32_t k = (int32_t)t;
+    if (t < (float)k) --k;  // floor for negative angles
+    const float a = (float)step_sin(k), b = (float)step_sin(k + 1);
+    return (a + (b - a) * (t - (float)k)) * (1.0f / 65536.0f);
+}
+inline float sin(float rad) { return steps_sin(rad * kStepsPerRadian); }
+inline float cos(float rad) { return steps_sin(rad * kStepsPerRadian + (float)kQuarter); }
+
+inline float atan2(float y, float x) {
+    if (x == 0.0f && y == 0.0f) return 0.0f;
+    const float ax = x < 0 ? -x : x, ay = y < 0 ? -y : y;
+    const bool swap = ay > ax;
+    const float z = swap ? ax / ay : ay / ax;  // 0..1
+    // atan(z) ~ pi/4*z - z*(z-1)*(0.2447 + 0.0663*z)
+    float a = 0.78539816f * z - z * (z - 1.0f) * (0.2447f + 0.0663f * z);
+    if (swap) a = 1.57079633f - a;
+    if (x < 0) a = 3.14159265f - a;
+    return y < 0 ? -a : a;
+}
+
+// 1/sqrt(v), 0 for v <= 0
+inline float rsqrt(float v) {
+    if (v <= 0.0f) return 0.0f;
+    uint32_t i;
+    std::memcpy(&i, &v, sizeof i);
+    i = 0x5f375a86u - (i >> 1);
+    float r;
+    std::memcpy(&r, &i, sizeof r);
+    r *= 1.5f - 0.5f * v * r * r;
+    r *= 1.5f - 0.5f * v * r * r;
+    return r;
+}
+
+// ---- fx::Fixed (integer only, deterministic) ----
+static const int64_t kStepsPerRadianQ16 = 10680707;  // kSteps / 2pi in Q16.16
+
+inline fx::Fixed sin(fx::Fixed rad) {
+    return fx::Fixed::from_raw(steps_sin_raw(((int64_t)rad.raw * kStepsPerRadianQ16) >> 16));
+}
+inline fx::Fixed cos(fx::Fixed rad) {
+    return fx::Fixed::from_raw(steps_sin_raw((((int64_t)rad.raw * kStepsPerRadianQ16) >> 16) + ((int64_t)kQuarter << 16)));
+}
+inline fx::Fixed atan2(fx::Fixed y, fx::Fixed x) { return fx::atan2(y, x); }
+inline fx::Fixed rsqrt(fx::Fixed v) {
+    fx::Fixed r = fx::sqrt(v);
+    return r.raw > 0 ? fx::Fixed(1) / r : fx::Fixed();
+}
+
+// ---- shared ----
+inline float from_q16(int32_t raw, float) { return (float)raw * (1.0f / 65536.0f); }
+inline fx::Fixed from_q16(int32_t raw, fx::Fixed) { return fx::Fixed::from_raw(raw); }
+
+// Unit vectors k/n of a turn apart (k = 0 points along +x). The table stride is divided out
+// once per ring, so each direction of a particle burst is a pair of table lookups.
+struct Ring {
+    int32_t stride;  // Q16.16 table steps between neighbouring directions
+    explicit Ring(int n) : stride((int32_t)(((int64_t)kSteps << 16) / (n > 0 ? n : 1))) {}
+    template <typename T>
+    void dir(int k, T &dx, T &dy) const {
+        const int64_t t = (int64_t)k * stride;
+        dy = from_q16(steps_sin_raw(t), T());
+        dx = from_q16(steps_sin_raw(t + ((int64_t)kQuarter << 16)), T());
+    }
+};
+template <typename T>
+inline void direction(int k, int n, T &dx, T &dy) { Ring(n).dir(k, dx, dy); }
+
+// |(x, y)|, and optionally the reciprocal that normalises it (both 0 for the zero vector)
+inline float length(float x, float y, float *inv = nullptr) {
+    const float d2 = x * x + y * y;
+    const float r = rsqrt(d2);
+    if (inv) *inv = r;
+    return d2 * r;
+}
+inline fx::Fixed length(fx::Fixed x, fx::Fixed y, fx::Fixed *inv = nullptr) {
+    const fx::Fixed len = fx::sqrt(x * x + y * y);
+    if (inv) *inv = len.raw > 0 ? fx::Fixed(1) / len : fx::Fixed();
+    return len;
+}
+
+} // namespace fastmath
@@ -0,0 +1,157 @@
+// fixed.hpp - Q16.16 fixed-point number for the deterministic simulation mode
+#pragma once
+#include <cstdint>
+#include <cmath>
+
+// All arithmetic is plain integer math (64-bit intermediates, arithmetic shifts), so the
+// same inputs give bit-identical results on the ARM11 and on a host build. Conversions
+// from float/double/int are implicit so constants and mixed expressions stay readable;
+// conversion back to float is explicit (to_float) so simulation values cannot silently
+// fall back into float math.
+namespace fx {
+
+struct Fixed {
+    int32_t raw;
+
+    static constexpr int kFracBits = 16;
+    static constexpr int32_t kOne = 1 << kFracBits;
+
+    Fixed() : raw(0) {}
+    Fixed(int v) : raw((int32_t)((uint32_t)v << kFracBits)) {}
+    Fixed(float v) : raw(from_float(v)) {}
+    Fixed(double v) : raw(from_float((float)v)) {}
+
+    static Fixed from_raw(int32_t r) { Fixed f; f.raw = r; return f; }
+    static Fixed max() { return from_raw(INT32_MAX); }
+    static Fixed min() { return from_raw(-INT32_MAX); }
+
+    float to_float() const { return (float)raw * (1.0f / (float)kOne); }
+    int to_int() const { return raw >> kFracBits; } // floor
+
+    // Round-half-away-from-zero, saturating. Multiplying by 2^16 is exact in IEEE float.
+    static int32_t from_float(float v) {
+        float s = v * (float)kOne;
+        if (s >= 2147483520.0f) return INT32_MAX;
+        if (s <= -2147483520.0f) return -INT32_MAX;
+        return (int32_t)(s >= 0.f ? s + 0.5f : s - 0.5f);
+    }
+    static int32_t saturate(int64_t v) {
+        if (v > INT32_MAX) return INT32_MAX;
+        if (v < -INT32_MAX) return -INT32_MAX;
+        return (int32_t)v;
+    }
+
+    Fixed operator-() const { return from_raw(-raw); }
+    Fixed& operator+=(Fixed o) { raw += o.raw; return *this; }
+    Fixed& operator-=(Fixed o) { raw -= o.raw; return *this; }
+    Fixed& operator*=(Fixed o) { raw = saturate(((int64_t)raw * o.raw) >> kFracBits); return *this; }
+    Fixed& operator/=(Fixed o) {
+        if (o.raw == 0) { raw = raw >= 0 ? INT32_MAX : -INT32_MAX; return *this; }
+        raw = saturate(((int64_t)raw * kOne) / o.raw);
+        return *this;
+    }
+};
+
+inline Fixed operator+(Fixed a, Fixed b) { return a += b; }
+inline Fixed operator-(Fixed a, Fixed b) { return a -= b; }
+inline Fixed operator*(Fixed a, Fixed b) { return a *= b; }
+inline Fixed operator/(Fixed a, Fixed b) { return a /= b; }
+inline bool operator==(Fixed a, Fixed b) { return a.raw == b.raw; }
+inline bool operator!=(Fixed a, Fixed b) { return a.raw != b.raw; }
+inline bool operator<(Fixed a, Fixed b) { return a.raw < b.raw; }
+inline bool operator>(Fixed a, Fixed b) { return a.raw > b.raw; }
+inline bool operator<=(Fixed a, Fixed b) { return a.raw <= b.raw; }
+inline bool operator>=(Fixed a, Fixed b) { return a.raw >= b.raw; }
+
+// Mixed forms: exact matches so `x + 0.5f` or `2 * v` never compete with built-in float math
+#define FX_MIXED_OPS(T) \
+    inline Fixed operator+(Fixed a, T b) { return a + Fixed(b); } \
+    inline Fixed operator+(T a, Fixed b) { return Fixed(a) + b; } \
+    inline Fixed operator-(Fixed a, T b) { return a - Fixed(b); } \
+    inline Fixed operator-(T a, Fixed b) { return Fixed(a) - b; } \
+    inline Fixed operator*(Fixed a, T b) { return a * Fixed(b); } \
+    inline Fixed operator*(T a, Fixed b) { return Fixed(a) * b; } \
+    inline Fixed operator/(Fixed a, T b) { return a / Fixed(b); } \
+    inline Fixed operator/(T a, Fixed b) { return Fixed(a) / b; } \
+    inline bool operator==(Fixed a, T b) { return a == Fixed(b); } \
+    inline bool operator!=(Fixed a, T b) { return a != Fixed(b); } \
+    inline bool operator<(Fixed a, T b) { return a < Fixed(b); } \
+    inline bool operator<(T a, Fixed b) { return Fixed(a) < b; } \
+    inline bool operator>(Fixed a, T b) { return a > Fixed(b); } \
+    inline bool operator>(T a, Fixed b) { return Fixed(a) > b; } \
+    inline bool operator<=(Fixed a, T b) { return a <= Fixed(b); } \
+    inline bool operator<=(T a, Fixed b) { return Fixed(a) <= b; } \
+    inline bool operator>=(Fixed a, T b) { return a >= Fixed(b); } \
+    inline bool operator>=(T a, Fixed b) { return Fixed(a) >= b; }
+FX_MIXED_OPS(int)
+FX_MIXED_OPS(float)
+FX_MIXED_OPS(double)
+#undef FX_MIXED_OPS
+
+// ---- Scalar helpers overloaded for float and Fixed (templates use these) ----
+inline float to_float(float v) { return v; }
+inline float to_float(Fixed v) { return v.to_float(); }
+inline int floor_int(float v) { return (int)std::floor(v); }
+inline int floor_int(Fixed v) { return v.to_int(); }
+inline int trunc_int(float v) { return (int)v; }
+inline int trunc_int(Fixed v) { return v.raw / Fixed::kOne; }
+inline float abs(float v) { return std::fabs(v); }
+inline float sin(float v) { return std::sin(v); }
+inline float cos(float v) { return std::cos(v); }
+inline Fixed abs(Fixed v) { return v.raw < 0 ? -v : v; }
+template <typename T> inline T huge();
+template <> inline float huge<float>() { return 1e30f; }
+template <> inline Fixed huge<Fixed>() { return Fixed::max(); }
+
+// ---- Deterministic math (integer only) ----
+inline Fixed sqrt(Fixed v) {
+    if (v.raw <= 0) return Fixed();
+    // isqrt of raw << 16 gives the Q16.16 root
+    uint64_t n = (uint64_t)v.raw << Fixed::kFracBits, r = 0, bit = (uint64_t)1 << 62;
+    while (bit > n) bit >>= 2;
+    while (bit) {
+        if (n >= r + bit) { n -= r + bit; r = (r >> 1) + bit; }
+        else r >>= 1;
+        bit >>= 2;
+    }
+    return Fixed::from_raw((int32_t)r);
+}
+
+static const int32_t kPi = 205887;      // pi in Q16.16
+static const int32_t kHalfPi = 102944;
+static const int32_t kTwoPi = 411775;
+
+// sin on [-pi, pi] via range reduction and an odd 7th-order polynomial (error < 3e-4)
+inline Fixed sin(Fixed a) {
+    int32_t x = a.raw % kTwoPi;
+    if (x > kPi) x -= kTwoPi;
+    else if (x < -kPi) x += kTwoPi;
+    if (x > kHalfPi) x = kPi - x;
+    else if (x < -kHalfPi) x = -kPi - x;
+    int64_t x2 = ((int64_t)x * x) >> 16;
+    // x - x^3/6 + x^5/120 - x^7/5040 in Horner form on x^2, coefficients in Q16.16
+    const int64_t c3 = 10923; // 1/6
+    const int64_t c5 = 546;   // 1/120
+    const int64_t c7 = 13;    // 1/5040
+    int64_t poly = 65536 - ((x2 * (c3 - ((x2 * (c5 - ((x2 * c7) >> 16))) >> 16))) >> 16);
+    return Fixed::from_raw((int32_t)((x * poly) >> 16));
+}
+inline Fixed cos(Fixed a) { return sin(Fixed::from_raw(a.raw + kHalfPi)); }
+
+// atan2 with octant reduction and a polynomial atan on [0,1] (error < 0.005 rad)
+inline Fixed atan2(Fixed y, Fixed x) {
+    if (x.raw == 0 && y.raw == 0) return Fixed();
+    int64_t ax = x.raw < 0 ? -(int64_t)x.raw : x.raw, ay = y.raw < 0 ? -(int64_t)y.raw : y.raw;
+    bool swap = ay > ax;
+    int64_t num = swap ? ax : ay, den = swap ? ay : ax;
+    int64_t z = (num << 16) / den; // 0..1
+    // atan(z) ~ pi/4*z - z*(z-1)*(0.2447 + 0.0663*z)
+    int64_t a = ((int64_t)51472 * z) >> 16;
+    a -= (((z * (z - 65536)) >> 16) * (16036 + ((4345 * z) >> 16))) >> 16;
+    if (swap) a = kHalfPi - a;
+    if (x.raw < 0) a = kPi - a;
+    if (y.raw < 0) a = -a;
+    return Fixed::from_raw((int32_t)a);
+}
+
+} // namespace fx
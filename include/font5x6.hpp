@@ -0,0 +1,133 @@
+// font5x6.hpp - the 5x6 bitmap font behind hw_draw_text*, laid out as solid rectangles
+#pragma once
+#include <cmath>
+#include <cstdint>
+
+// Uppercase, digits and some punctuation; lowercase maps to uppercase and anything else to a
+// space. Each glyph row uses the low 5 bits of a byte and the advance is 6 pixels. The layout
+// routines only compute rectangles and hand them to emit(x, y, w, h), so the platform
+// backends draw them and host tools can count or time them without a GPU.
+namespace font5x6 {
+
+struct Glyph { char c; uint8_t rows[6]; };
+static const Glyph kGlyphs[] = {
+    {'A',{0x0E,0x11,0x1F,0x11,0x11,0x00}},
+    {'B',{0x1E,0x11,0x1E,0x11,0x1E,0x00}},
+    {'C',{0x0E,0x11,0x10,0x11,0x0E,0x00}},
+    {'D',{0x1E,0x11,0x11,0x11,0x1E,0x00}},
+    {'E',{0x1F,0x10,0x1E,0x10,0x1F,0x00}},
+    {'F',{0x1F,0x10,0x1E,0x10,0x10,0x00}},
+    {'G',{0x0F,0x10,0x13,0x11,0x0F,0x00}},
+    {'H',{0x11,0x11,0x1F,0x11,0x11,0x00}},
+    {'I',{0x1F,0x04,0x04,0x04,0x1F,0x00}},
+    {'J',{0x01,0x01,0x01,0x11,0x0E,0x00}},
+    {'K',{0x11,0x12,0x1C,0x12,0x11,0x00}},
+    {'L',{0x10,0x10,0x10,0x10,0x1F,0x00}},
+    {'M',{0x11,0x1B,0x15,0x11,0x11,0x00}},
+    {'N',{0x11,0x19,0x15,0x13,0x11,0x00}},
+    {'O',{0x0E,0x11,0x11,0x11,0x0E,0x00}},
+    {'P',{0x1E,0x11,0x1E,0x10,0x10,0x00}},
+    {'Q',{0x0E,0x11,0x11,0x15,0x0E,0x01}},
+    {'R',{0x1E,0x11,0x1E,0x12,0x11,0x00}},
+    {'S',{0x0F,0x10,0x0E,0x01,0x1E,0x00}},
+    {'T',{0x1F,0x04,0x04,0x04,0x04,0x00}},
+    {'U',{0x11,0x11,0x11,0x11,0x0E,0x00}},
+    {'V',{0x11,0x11,0x11,0x0A,0x04,0x00}},
+    {'W',{0x11,0x11,0x15,0x1B,0x11,0x00}},
+    {'X',{0x11,0x0A,0x04,0x0A,0x11,0x00}},
+    {'Y',{0x11,0x0A,0x04,0x04,0x04,0x00}},
+    {'Z',{0x1F,0x02,0x04,0x08,0x1F,0x00}},
+    {'0',{0x0E,0x13,0x15,0x19,0x0E,0x00}},
+    {'1',{0x04,0x0C,0x04,0x04,0x0E,0x00}},
+    {'2',{0x0E,0x11,0x02,0x04,0x1F,0x00}},
+    {'3',{0x1F,0x02,0x04,0x02,0x1F,0x00}},
+    {'4',{0x02,0x06,0x0A,0x1F,0x02,0x00}},
+    {'5',{0x1F,0x10,0x1E,0x01,0x1E,0x00}},
+    {'6',{0x06,0x08,0x1E,0x11,0x0E,0x00}},
+    {'7',{0x1F,0x01,0x02,0x04,0x08,0x00}},
+    {'8',{0x0E,0x11,0x0E,0x11,0x0E,0x00}},
+    {'9',{0x0E,0x11,0x0F,0x01,0x06,0x00}},
+    {':',{0x00,0x04,0x00,0x04,0x00,0x00}},
+    {'.',{0x00,0x00,0x00,0x00,0x04,0x00}},
+    {'-',{0x00,0x00,0x0E,0x00,0x00,0x00}},
+    {'_',{0x00,0x00,0x00,0x00,0x1F,0x00}},
+    {'/',{0x01,0x02,0x04,0x08,0x10,0x00}},
+    {' ',{0x00,0x00,0x00,0x00,0x00,0x00}},
+    {'(',{0x06,0x08,0x08,0x08,0x06,0x00}},
+    {')',{0x0C,0x02,0x02,0x02,0x0C,0x00}},
+    {'+',{0x00,0x04,0x0E,0x04,0x00,0x00}},
+    {'=',{0x00,0x0E,0x00,0x0E,0x00,0x00}},
+    {'%',{0x19,0x19,0x02,0x04,0x13,0x13}},
+    {',',{0x00,0x00,0x00,0x06,0x02,0x04}},
+    {'>',{0x10,0x08,0x04,0x08,0x10,0x00}},
+    {'<',{0x01,0x02,0x04,0x02,0x01,0x00}},
+    {']',{0x1C,0x04,0x04,0x04,0x1C,0x00}},
+    {'[',{0x07,0x04,0x04,0x04,0x07,0x00}},
+};
+
+constexpr int kAdvance = 6;
+
+inline const Glyph* find_glyph(char c) {
+    if(c>='a' && c<='z') c = (char)(c - 'a' + 'A');
+    for(const auto &g : kGlyphs) if(g.c==c) return &g;
+    return &kGlyphs[sizeof(kGlyphs)/sizeof(kGlyphs[0]) - 1]; // space fallback
+}
+
+// Unscaled, one 1x1 rect per set pixel, single line; stops once the pen passes maxX-6
+template <typename Emit>
+void layout(int x, int y, const char* s, int maxX, Emit emit) {
+    for(const char* p=s; *p; ++p) {
+        const Glyph* gptr = find_glyph(*p);
+        for(int ry=0; ry<6; ++ry) {
+            uint8_t row = gptr->rows[ry];
+            for(int rx=0; rx<5; ++rx) if(row & (1 << (4-rx)))
+                emit((float)(x+rx), (float)(y+ry), 1.0f, 1.0f);
+        }
+        x += kAdvance;
+        if(x > maxX-kAdvance) break;
+    }
+}
+
+// Scaled, one scale x scale rect per set pixel; '\n' starts a new line below x
+template <typename Emit>
+void layout_scaled(int x, int y, const char* s, float scale, Emit emit) {
+    float cursorX = (float)x;
+    for(const char* p=s; *p; ++p) {
+        char c = *p;
+        if(c=='\n') { y += (int)std::ceil(6*scale + scale); cursorX = (float)x; continue; }
+        const Glyph* glyph = find_glyph(c);
+        for(int ry=0; ry<6; ++ry) {
+            uint8_t row = glyph->rows[ry];
+            for(int rx=0; rx<5; ++rx) if(row & (1<<(4-rx)))
+                emit(cursorX + rx*scale, (float)y + ry*scale, scale, scale);
+        }
+        cursorX += kAdvance*scale;
+        if(cursorX > 400 - kAdvance*scale) break;
+    }
+}
+
+// Scaled, with each row's consecutive set pixels merged into one rect (fewer quads)
+template <typename Emit>
+void layout_scaled_runs(int x, int y, const char* s, float scale, Emit emit) {
+    float cursorX = (float)x;
+    int baseY = y;
+    for(const char* p=s; *p; ++p) {
+        char c=*p; if(c=='\n'){ baseY += (int)std::ceil(6*scale + scale); cursorX=(float)x; continue; }
+        const Glyph* glyph = find_glyph(c);
+        for(int ry=0; ry<6; ++ry) {
+            uint8_t row = glyph->rows[ry];
+            int rx=0;
+            while(rx<5) {
+                while(rx<5 && !(row & (1<<(4-rx)))) ++rx; // skip unset
+                if(rx>=5) break;
+                int start=rx;
+                while(rx<5 && (row & (1<<(4-rx)))) ++rx; // advance run
+                emit(cursorX + start*scale, (float)baseY + ry*scale, (rx-start)*scale, scale);
+            }
+        }
+        cursorX += kAdvance*scale;
+        if(cursorX > 400 - kAdvance*scale) break;
+    }
+}
+
+} // namespace font5x6
@@ -1,6 +1,3 @@
-namespace game {
-	void spawn_dust_effect(float x, float y);
-}
 // game.hpp - forward declarations for game lifecycle
 #pragma once
 #include "hardware.hpp"
@@ -11,8 +8,15 @@ namespace game {
 void game_init();
 void game_update(const InputState&);
 void game_render();
+// Fraction (0..1) of a fixed simulation tick elapsed since the last game_update; ball
+// rendering interpolates between the previous and current tick by this amount.
+void game_set_render_alpha(float alpha);
 // Renders title screen interactive buttons (bottom screen). Pass current input for hover highlight.
 void game_render_title_buttons(const InputState&);
+// Draws one whole frame on both screens as the 3DS build presents it (call between
+// hw_begin_frame and hw_end_frame): game_render() plus the backdrops, title menu, stylus
+// crosshair and optional log overlays around it. `in` is the frame's input, for button hover.
+void game_render_frame(const InputState& in, bool topLogs, bool bottomLogs);
 
 enum class GameMode { Title, Playing, Editor, Options };
 GameMode game_mode();
@@ -22,5 +26,56 @@ void levels_load();
 void levels_render();
 bool exit_requested();
 
+// Seed for the simulation's pseudo-random choices (tilt jitter); 0 by default. Replays record
+// it so playback makes the same choices.
+void game_set_seed(uint32_t seed);
+uint32_t game_seed();
+// Hash of the simulation state after the latest game_update(); replays store one per tick
+uint32_t game_state_hash();
+
+// Read-only view of play for automated players (the host autoplayer); they still act only
+// through the InputState passed to game_update(). Positions are world pixels.
+struct GameObservation {
+    bool playing = false;
+    float batX = 0.f, batY = 0.f, batWidth = 0.f; // bat sprite rect (left, top, width)
+    float batCollWidth = 0.f;     // centred width the bounce angle is taken across
+    float batMinX = 0.f, batMaxX = 0.f; // range of batX between the playfield walls
+    int lives = 0;
+    int level = 0;                // levels_current()
+    uint32_t levelsCompleted = 0; // levels cleared since game_init
+    int bricksLeft = 0;           // levels_remaining_required()
+    uint32_t brickHits = 0;       // ball-brick contacts since game_start_level
+    bool ballLocked = false, deathActive = false, gameOver = false;
+    bool tiltAvailable = false;
+    bool reverseControls = false; // stylus drag moves the bat the other way
+    int balls = 0;                // active balls, murder balls included
+    int particles = 0;
+    // Earliest regular ball predicted to reach the bat line: its centre x there and ticks to go
+    bool landing = false; float landingX = 0.f; int landingTicks = 0;
+    // Same for murder balls, which cost a life when they touch the bat
+    bool murderLanding = false; float murderX = 0.f; int murderTicks = 0;
+    float trackX = 0.f;           // centre x of the lowest regular ball (bat centre if none)
+};
+void game_observe(GameObservation& out);
+// Fresh game (3 lives, score 0) straight onto level `index` of the loaded pack
+void game_start_level(int index);
+
+// Worlds: each GameWorld is a whole game (play state plus its own copy of the level grids), so
+// tools can run many side by side, one per thread. The calls above act on the default world,
+// which is the one the 3DS build plays. A world from game_world_create() starts on the title
+// screen with the default world's pack and is headless: it plays no sound and never touches the
+// high-score table. A world must only be used by one thread at a time.
+struct GameWorld;
+GameWorld* game_world_create();
+void game_world_destroy(GameWorld* world);
+GameWorld& game_default_world();
+void game_update(GameWorld& world, const InputState&);
+void game_render(const GameWorld& world);
+GameMode game_mode(const GameWorld& world);
+void game_set_seed(GameWorld& world, uint32_t seed);
+uint32_t game_state_hash(const GameWorld& world);
+void game_observe(const GameWorld& world, GameObservation& out);
+void game_start_level(GameWorld& world, int index);
+
 // Public game version for UI
 namespace game { constexpr float kGameVersion = 1.0f; }
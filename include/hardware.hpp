@@ -200,6 +200,10 @@ void hw_poll_input(InputState& out);
 void hw_begin_frame();
 void hw_end_frame();
 
+// Monotonic high-resolution clock for frame pacing (system ticks on 3DS)
+uint64_t hw_ticks();
+uint64_t hw_ticks_per_second();
+
 // Drawing helpers
 void hw_draw_sprite(C2D_Image img, float x, float y, float z=0.0f, float sx=1.0f, float sy=1.0f);
 
@@ -230,6 +234,90 @@ void hw_draw_logs(int x,int y,int maxPixelsY=240);
 void hw_set_top();
 void hw_set_bottom();
 
+// Objects (rects and sprites) citro2d is initialised for: one frame's draws on both screens
+// share this buffer. Twice the default because the 5x6 font draws a rect per lit pixel run.
+constexpr int kHwMaxObjects = C2D_DEFAULT_MAX_OBJECTS * 2;
+
+// Names the subsystem drawing while it is in scope ("hud", "editor", ...); the innermost
+// scope wins and rename() relabels the current one. Only the host draw recorder reads the
+// name, so on the console this compiles to nothing.
+#ifdef PLATFORM_HOST
+const char* hw_host_draw_scope(const char* name); // sets the current name, returns the last
+struct HwDrawScope {
+	explicit HwDrawScope(const char* name) : prev_(hw_host_draw_scope(name)) {}
+	~HwDrawScope() { hw_host_draw_scope(prev_); }
+	void rename(const char* name) { hw_host_draw_scope(name); }
+	HwDrawScope(const HwDrawScope&) = delete;
+	HwDrawScope& operator=(const HwDrawScope&) = delete;
+private:
+	const char* prev_;
+};
+#else
+struct HwDrawScope {
+	explicit HwDrawScope(const char*) {}
+	void rename(const char*) {}
+};
+#endif
+
+#ifdef PLATFORM_HOST
+// Headless host backend (source/platform/host). The host build also defines PLATFORM_3DS,
+// so the shared code takes its 3DS paths against stand-in libctru/citro2d headers.
+// Input returned by hw_poll_input() until changed (the host has no devices)
+void hw_host_set_input(const InputState& in);
+// Local directories standing in for sdmc:/ and romfs:/ (call before hw_init); audioDir, if
+// given, stands in for romfs:/audio on its own (e.g. the unconverted sounds/ directory)
+void hw_host_set_dirs(const char* sdmcDir, const char* romfsDir, const char* audioDir = nullptr);
+// Echo hw_log() output to stderr (off by default so runs stay fast and quiet)
+void hw_host_set_log(bool toStderr);
+// Draw calls seen since start-up (rects, sprites and text strings are counted, not drawn)
+struct HwHostStats { uint64_t frames = 0, rects = 0, sprites = 0, texts = 0; };
+const HwHostStats& hw_host_stats();
+// Draw recording: every rect, sprite and font rect with its screen and HwDrawScope name, and
+// per-screen totals for each frame from hw_begin_frame() to hw_end_frame()
+enum class HwDrawKind : uint8_t { Rect, Sprite, Glyph }; // Glyph: a rect drawn by the 5x6 font
+struct HwDrawCall {
+	HwDrawKind kind;
+	int screen;          // 0 top, 1 bottom
+	const char* scope;
+	const char* sheet;   // sprites: sheet name and image index (nullptr / -1 for rects)
+	int image;
+	float x, y, w, h;    // sprite size includes its scale
+};
+struct HwFrameDraws {
+	uint64_t frame = 0;  // hw_host_stats().frames when the frame began
+	uint32_t rects[2] = { 0, 0 }, sprites[2] = { 0, 0 }, glyphs[2] = { 0, 0 };
+	uint32_t texts[2] = { 0, 0 }; // text strings (their glyphs are counted above)
+	uint32_t objects(int screen) const { return rects[screen] + sprites[screen] + glyphs[screen]; }
+	uint32_t objects() const { return objects(0) + objects(1); }
+};
+// Either sink may be null (both are by default); onFrame runs from hw_end_frame()
+typedef void (*HwDrawSink)(const HwDrawCall& call, void* user);
+typedef void (*HwFrameSink)(const HwFrameDraws& frame, void* user);
+void hw_host_set_draw_sinks(HwDrawSink onDraw, HwFrameSink onFrame, void* user);
+// Software NDSP (ndsp_host.cpp). Off by default, so ndspInit() fails and sound.cpp stays
+// disabled. Once enabled (before sound::init) the channels are mixed whenever the DSP clock is
+// moved on by hw_host_audio_advance(), optionally into a stereo WAV file, and osGetTime()
+// follows that clock instead of the wall clock so sound timing replays exactly.
+bool hw_host_audio_enable(const char* wavPath = nullptr); // false if wavPath cannot be written
+bool hw_host_audio_enabled();
+void hw_host_audio_advance(double seconds);
+uint64_t hw_host_audio_ms(); // audio mixed so far
+struct HwAudioChannelStats {
+	uint64_t queued = 0;      // wave buffers added
+	uint64_t done = 0;        // wave buffers played to the end
+	uint64_t cutOff = 0;      // cleared or reset before the end (a sound replaced or stopped)
+	uint64_t underruns = 0;   // buffers added after the channel had run dry, with no reset/clear
+	uint64_t drySamples = 0;  // output samples the channel was dry before those buffers
+};
+struct HwAudioStats {
+	uint64_t samples = 0;     // stereo output samples mixed
+	uint64_t clipped = 0;     // output values clamped to 16 bits
+	uint32_t hash = 2166136261u; // FNV-1a of the 16-bit output, for regression checks
+	HwAudioChannelStats channel[24];
+};
+const HwAudioStats& hw_host_audio_stats();
+#endif
+
 #endif // PLATFORM_3DS
 
 // Bridge declarations (legacy logic still in main.cpp). These will be refactored.
@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <vector>
 #include <string>
+#include "brickgrid.hpp"
 
 void levels_load();
 void levels_render();
@@ -11,6 +12,12 @@ int  levels_count();                 // number of loaded levels
 int  levels_current();               // current level index
 bool levels_set_current(int idx);    // set current, returns success
 int  levels_remaining_breakable();
+// Required bricks (YB GB CB TB PB RB SS) left in the current level; O(1), kept by every mutation
+int  levels_remaining_required();
+// Level-complete notification: true once after a gameplay removal (remove/damage/bomb) leaves
+// the current level with no required bricks. Reading it clears it; changing/resetting the level
+// also clears it.
+bool levels_take_level_complete();
 // Lookup atlas index for a raw brick type (returns -1 if invalid)
 int levels_atlas_index(int rawType);
 
@@ -32,6 +39,9 @@ int levels_edit_top();
 int levels_brick_at(int col, int row);
 // Remove (set NB) brick at grid coordinate
 void levels_remove_brick(int col, int row);
+// Inline read-only view of the current level (raw bricks, hp and occupancy bitboards).
+// Pointers stay valid until the level list is reloaded or the current level changes.
+brickgrid::GridView levels_grid_view();
 
 // Damage a brick at coordinate (for multi-hit like T5). Returns true if brick destroyed this call.
 // For non multi-hit bricks behaves like remove & returns true. Returns false if brick still alive.
@@ -40,8 +50,10 @@ bool levels_damage_brick(int col,int row);
 // Trigger a bomb explosion centered at (col,row). Removes the bomb (if present) and any
 // immediate 8-neighbour bricks (including chaining other bombs). Effects are applied by caller.
 // Returns number of bricks destroyed (including original) and optionally records destroyed brick
-// types into the provided vector if not null.
-struct DestroyedBrick { int col; int row; int type; };
+// types into the provided vector if not null, ordered by chain depth (0 = the bomb at col,row;
+// a brick's depth is one more than the nearest bomb that reached it). The bomb's cluster is a
+// precomputed lookup, so the cost does not depend on how many bombs chain.
+struct DestroyedBrick { int col; int row; int type; int depth; };
 int levels_explode_bomb(int col,int row, std::vector<DestroyedBrick>* outDestroyed = nullptr);
 
 // Get remaining HP for a brick (1 for normal breakables, 0 if empty/non-breakable, 1..5 for T5)
@@ -77,6 +89,18 @@ void levels_set_name(int levelIndex, const char* name); // truncates to 32 chars
 // Save all current in-memory levels back to active .DAT file (overwrite)
 bool levels_save_active();
 
+// -------- Worlds --------
+// The parsed levels and their live play state (current level, bricks, hp, completion latch,
+// render offsets) belong to a world. Every levels_* call acts on the world bound to the
+// calling thread: the default world unless levels_world_bind() picked another. The level
+// files and the active-file choice are shared by all worlds.
+struct LevelsWorld;
+// New world holding a copy of the bound world's levels and play state
+LevelsWorld* levels_world_create();
+void levels_world_destroy(LevelsWorld* world);
+// Bind world (nullptr: the default world) to this thread; returns the previous binding
+LevelsWorld* levels_world_bind(LevelsWorld* world);
+
 // Runtime horizontal render offset (gameplay only) – editor keeps base positions.
 void levels_set_draw_offset(int offsetPixels);
 int  levels_get_draw_offset();
@@ -0,0 +1,80 @@
+// particles.hpp - fixed-capacity structure-of-arrays particle pool
+#pragma once
+#include <cstdint>
+#include "fixed.hpp"
+#include "fastmath.hpp"
+
+// Live particles are kept dense in [0, count): dead ones are swap-removed as they expire, so
+// update and draw loops never visit them and nothing is allocated after construction. When
+// the pool is full a spawn recycles the oldest live particle, found in O(1) through a list of
+// the live slots in spawn order. Header-only and templated on the scalar type (float or
+// fx::Fixed) like balls.hpp.
+namespace particles {
+
+template <typename T, int N>
+struct Pool {
+    T x[N], y[N], vx[N], vy[N];
+    int16_t life[N];
+    uint32_t color[N];
+    int16_t older[N], newer[N]; // spawn-order neighbours of each live slot (-1 at the ends)
+    int count = 0;
+    int16_t oldest = -1, newest = -1;
+
+    static constexpr int capacity() { return N; }
+    int size() const { return count; }
+    bool empty() const { return count == 0; }
+    void clear() { count = 0; oldest = newest = -1; }
+
+    void spawn(T px, T py, T pvx, T pvy, int plife, uint32_t pcolor) {
+        int i;
+        if (count < N) i = count++;
+        else unlink(i = oldest);
+        x[i] = px; y[i] = py; vx[i] = pvx; vy[i] = pvy;
+        life[i] = (int16_t)plife; color[i] = pcolor;
+        older[i] = newest; newer[i] = -1;
+        if (newest >= 0) newer[newest] = (int16_t)i; else oldest = (int16_t)i;
+        newest = (int16_t)i;
+    }
+    // Ring of n particles at even angles k/n*2pi; speed is speed0 + speedStep * (k % stepCycle).
+    // Directions come from the fastmath sine table, so a burst makes no trig calls.
+    void burst(T px, T py, int n, T speed0, T speedStep, int stepCycle, int plife, uint32_t pcolor) {
+        const fastmath::Ring ring(n);
+        for (int k = 0; k < n; ++k) {
+            T dx, dy;
+            ring.dir(k, dx, dy);
+            T sp = speed0 + speedStep * T(k % stepCycle);
+            spawn(px, py, dx * sp, dy * sp, plife, pcolor);
+        }
+    }
+    // Advance every live particle one tick with the given gravity; expired ones are removed
+    void integrate(T gravity) {
+        int i = 0;
+        while (i < count) {
+            x[i] += vx[i];
+            y[i] += vy[i];
+            vy[i] += gravity;
+            if (--life[i] <= 0) { remove_at(i); continue; } // slot i now holds an unvisited particle
+            ++i;
+        }
+    }
+    void remove_at(int i) {
+        unlink(i);
+        int last = --count;
+        if (i == last) return;
+        x[i] = x[last]; y[i] = y[last]; vx[i] = vx[last]; vy[i] = vy[last];
+        life[i] = life[last]; color[i] = color[last];
+        // The particle from `last` keeps its place in spawn order under its new index
+        older[i] = older[last]; newer[i] = newer[last];
+        if (older[i] >= 0) newer[older[i]] = (int16_t)i; else oldest = (int16_t)i;
+        if (newer[i] >= 0) older[newer[i]] = (int16_t)i; else newest = (int16_t)i;
+    }
+
+private:
+    static_assert(N > 0 && N < 32767, "Pool capacity must fit 16-bit links");
+    void unlink(int i) {
+        if (older[i] >= 0) newer[older[i]] = newer[i]; else oldest = newer[i];
+        if (newer[i] >= 0) older[newer[i]] = older[i]; else newest = older[i];
+    }
+};
+
+} // namespace particles
@@ -0,0 +1,101 @@
+// pool.hpp - fixed-capacity entity pool with stable handles and dense iteration
+#pragma once
+#include <cstdint>
+
+// Items live contiguously in [0, size()) so update and draw loops touch only live entities.
+// Spawn and despawn are O(1): despawn swap-removes from the dense array and returns the slot
+// to a free list. A Handle (slot + generation) keeps referring to the same entity while it
+// moves inside the dense array and goes stale once that entity is despawned. All storage is
+// inline, so a pool never allocates; spawning into a full pool fails (returns nullptr).
+//
+// Removing while iterating: call remove_at(i) and do not advance i (slot i now holds the
+// former last item, which has not been visited yet).
+template <typename T, int N>
+class Pool {
+    static_assert(N > 0 && N < 65535, "Pool capacity must fit 16-bit slots");
+public:
+    struct Handle {
+        uint16_t slot = 0;
+        uint16_t gen = 0;  // 0 is never issued, so a default Handle is always invalid
+    };
+
+    Pool() { clear(); }
+
+    static constexpr int capacity() { return N; }
+    int size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    bool full() const { return count_ == N; }
+
+    T &operator[](int i) { return items_[i]; }
+    const T &operator[](int i) const { return items_[i]; }
+    T *begin() { return items_; }
+    T *end() { return items_ + count_; }
+    const T *begin() const { return items_; }
+    const T *end() const { return items_ + count_; }
+
+    // Despawn everything; handles to the cleared items go stale
+    void clear() {
+        for (int i = 0; i < count_; ++i) bump(denseToSlot_[i]);
+        count_ = 0;
+        for (int i = 0; i < N; ++i) {
+            freeSlots_[i] = (uint16_t)(N - 1 - i); // pop order 0,1,2...
+            if (gen_[i] == 0) gen_[i] = 1;
+        }
+        freeCount_ = N;
+    }
+
+    // Append a copy of v; returns the stored item, or nullptr if the pool is full
+    T *spawn(const T &v, Handle *out = nullptr) {
+        if (count_ == N) return nullptr;
+        uint16_t slot = freeSlots_[--freeCount_];
+        int i = count_++;
+        items_[i] = v;
+        denseToSlot_[i] = slot;
+        slotToDense_[slot] = (uint16_t)i;
+        if (out) { out->slot = slot; out->gen = gen_[slot]; }
+        return &items_[i];
+    }
+
+    // Live item for a handle, or nullptr once it has been despawned
+    T *get(Handle h) {
+        if (h.gen == 0 || h.slot >= N || gen_[h.slot] != h.gen) return nullptr;
+        return &items_[slotToDense_[h.slot]];
+    }
+    bool despawn(Handle h) {
+        if (!get(h)) return false;
+        remove_at(slotToDense_[h.slot]);
+        return true;
+    }
+
+    void remove_at(int i) {
+        uint16_t slot = denseToSlot_[i];
+        bump(slot);
+        freeSlots_[freeCount_++] = slot;
+        int last = --count_;
+        if (i != last) {
+            items_[i] = items_[last];
+            denseToSlot_[i] = denseToSlot_[last];
+            slotToDense_[denseToSlot_[i]] = (uint16_t)i;
+        }
+    }
+
+    // Remove every item matching pred (dense order is not preserved)
+    template <typename Pred>
+    void remove_if(Pred pred) {
+        for (int i = 0; i < count_;) {
+            if (pred(items_[i])) remove_at(i);
+            else ++i;
+        }
+    }
+
+private:
+    void bump(uint16_t slot) { if (++gen_[slot] == 0) gen_[slot] = 1; } // invalidate outstanding handles
+
+    T items_[N];
+    uint16_t denseToSlot_[N];
+    uint16_t slotToDense_[N];
+    uint16_t gen_[N] = {};
+    uint16_t freeSlots_[N];
+    int freeCount_ = 0;
+    int count_ = 0;
+};
@@ -0,0 +1,255 @@
+// replay.hpp - compact per-tick input recording with a state hash for deterministic playback
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// A replay is everything needed to re-run a session tick for tick: the level pack, start
+// level, options and seed the game was started with, the input every game_update() saw, and
+// a hash of the game state after each tick so playback can report the first divergent tick.
+//
+// Input is delta-encoded: each record is a varint count of ticks that repeat the previous
+// input, then a tag byte saying which of the packed buttons / stylus position changed,
+// followed by the new buttons (2 bytes) and zigzag varint stylus deltas. Held inputs cost
+// nothing per tick, so the hash (16 bits per tick) dominates the file size.
+//
+// File layout (little endian): magic, version, Header fields, input stream length + bytes,
+// hash count + hashes. Header-only and free of the platform headers so host tools can check
+// the encoding; source/replay_session.cpp maps InputState and the game setup onto it.
+namespace replay {
+
+constexpr uint32_t kMagic = 0x4C505242u; // "BRPL"
+constexpr uint16_t kVersion = 1;
+
+enum : uint8_t { kFlagMusic = 1, kFlagAimGuide = 2, kFlagFixedSim = 4 };
+
+struct Header {
+    char levelFile[32] = {0}; // active level pack (.DAT basename)
+    int16_t startLevel = 0;   // levels_current() when recording began
+    uint8_t device = 0;       // options::DeviceType (sets the hinge gap)
+    uint8_t flags = 0;        // kFlag*
+    uint32_t seed = 0;        // game_set_seed()
+    uint32_t ticks = 0;       // filled in by Writer
+};
+
+// One tick of input: 15 button bits plus the stylus position
+struct Frame {
+    uint16_t buttons = 0;
+    int16_t x = -1, y = -1;
+    bool operator==(const Frame &o) const { return buttons == o.buttons && x == o.x && y == o.y; }
+    bool operator!=(const Frame &o) const { return !(*this == o); }
+};
+
+// The hash stored per tick: both halves of the 32-bit state hash folded together
+inline uint16_t fold_hash(uint32_t h) { return (uint16_t)(h ^ (h >> 16)); }
+
+namespace detail {
+    enum : uint8_t { kTagButtons = 1, kTagStylus = 2, kTagEnd = 0x80 };
+
+    inline void put_u8(std::vector<uint8_t> &b, uint8_t v) { b.push_back(v); }
+    inline void put_u16(std::vector<uint8_t> &b, uint16_t v) { b.push_back((uint8_t)v); b.push_back((uint8_t)(v >> 8)); }
+    inline void put_u32(std::vector<uint8_t> &b, uint32_t v) { put_u16(b, (uint16_t)v); put_u16(b, (uint16_t)(v >> 16)); }
+    inline void put_varint(std::vector<uint8_t> &b, uint32_t v) {
+        while (v >= 0x80) { b.push_back((uint8_t)(v | 0x80)); v >>= 7; }
+        b.push_back((uint8_t)v);
+    }
+    inline uint32_t zigzag(int32_t v) { return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31); }
+    inline int32_t unzigzag(uint32_t v) { return (int32_t)(v >> 1) ^ -(int32_t)(v & 1); }
+
+    // Bounds-checked little-endian reader; ok goes false on any overrun
+    struct Cursor {
+        const uint8_t *p, *end;
+        bool ok;
+        uint8_t u8() { if (p >= end) { ok = false; return 0; } return *p++; }
+        uint16_t u16() { uint16_t lo = u8(); return (uint16_t)(lo | (u8() << 8)); }
+        uint32_t u32() { uint32_t lo = u16(); return lo | ((uint32_t)u16() << 16); }
+        uint32_t varint() {
+            uint32_t v = 0;
+            for (int shift = 0; shift < 35; shift += 7) {
+                uint8_t c = u8();
+                v |= (uint32_t)(c & 0x7F) << shift;
+                if (!(c & 0x80)) return v;
+            }
+            ok = false;
+            return 0;
+        }
+    };
+} // namespace detail
+
+// Records ticks in memory; serialize() / save() produce the file at any point
+class Writer {
+public:
+    void begin(const Header &h) {
+        header_ = h; header_.ticks = 0;
+        stream_.clear(); hashes_.clear();
+        prev_ = Frame(); run_ = 0;
+    }
+    void tick(const Frame &f, uint32_t stateHash) {
+        using namespace detail;
+        if (f == prev_) {
+            ++run_;
+        } else {
+            uint8_t tag = 0;
+            if (f.buttons != prev_.buttons) tag |= kTagButtons;
+            if (f.x != prev_.x || f.y != prev_.y) tag |= kTagStylus;
+            put_varint(stream_, run_);
+            put_u8(stream_, tag);
+            if (tag & kTagButtons) put_u16(stream_, f.buttons);
+            if (tag & kTagStylus) {
+                put_varint(stream_, zigzag(f.x - prev_.x));
+                put_varint(stream_, zigzag(f.y - prev_.y));
+            }
+            prev_ = f; run_ = 0;
+        }
+        hashes_.push_back(fold_hash(stateHash));
+        ++header_.ticks;
+    }
+    uint32_t ticks() const { return header_.ticks; }
+    const Header &header() const { return header_; }
+
+    std::vector<uint8_t> serialize() const {
+        using namespace detail;
+        std::vector<uint8_t> out;
+        out.reserve(64 + stream_.size() + hashes_.size() * 2);
+        put_u32(out, kMagic);
+        put_u16(out, kVersion);
+        for (char c : header_.levelFile) put_u8(out, (uint8_t)c);
+        put_u16(out, (uint16_t)header_.startLevel);
+        put_u8(out, header_.device);
+        put_u8(out, header_.flags);
+        put_u32(out, header_.seed);
+        put_u32(out, header_.ticks);
+        // Close the stream with the trailing run of repeated ticks
+        std::vector<uint8_t> tail;
+        put_varint(tail, run_);
+        put_u8(tail, kTagEnd);
+        put_u32(out, (uint32_t)(stream_.size() + tail.size()));
+        out.insert(out.end(), stream_.begin(), stream_.end());
+        out.insert(out.end(), tail.begin(), tail.end());
+        put_u32(out, (uint32_t)hashes_.size());
+        for (uint16_t h : hashes_) put_u16(out, h);
+        return out;
+    }
+    bool save(const char *path) const {
+        std::vector<uint8_t> bytes = serialize();
+        FILE *f = fopen(path, "wb");
+        if (!f) return false;
+        bool ok = fwrite(bytes.data(), 1, bytes.size(), f) == bytes.size();
+        return fclose(f) == 0 && ok;
+    }
+
+private:
+    Header header_;
+    std::vector<uint8_t> stream_;
+    std::vector<uint16_t> hashes_;
+    Frame prev_;
+    uint32_t run_ = 0;
+};
+
+// Plays a recording back: next() yields each tick's input, check() compares the state hash
+// after that tick against the recorded one and remembers the first mismatch
+class Reader {
+public:
+    bool parse(const uint8_t *data, size_t size) {
+        using namespace detail;
+        *this = Reader();
+        Cursor c{data, data + size, true};
+        if (c.u32() != kMagic || c.u16() != kVersion) return false;
+        for (char &ch : header_.levelFile) ch = (char)c.u8();
+        header_.levelFile[sizeof header_.levelFile - 1] = '\0';
+        header_.startLevel = (int16_t)c.u16();
+        header_.device = c.u8();
+        header_.flags = c.u8();
+        header_.seed = c.u32();
+        header_.ticks = c.u32();
+        uint32_t streamLen = c.u32();
+        if (!c.ok || streamLen > (uint32_t)(c.end - c.p)) return false;
+        stream_.assign(c.p, c.p + streamLen);
+        c.p += streamLen;
+        uint32_t hashCount = c.u32();
+        if (!c.ok || hashCount != header_.ticks || hashCount > (uint32_t)(c.end - c.p) / 2) return false;
+        hashes_.resize(hashCount);
+        for (uint16_t &h : hashes_) h = c.u16();
+        cursor_ = 0;
+        run_ = next_run();
+        return ok_;
+    }
+    bool load(const char *path) {
+        FILE *f = fopen(path, "rb");
+        if (!f) return false;
+        std::vector<uint8_t> bytes;
+        uint8_t buf[4096];
+        size_t r;
+        while ((r = fread(buf, 1, sizeof buf, f)) > 0) bytes.insert(bytes.end(), buf, buf + r);
+        fclose(f);
+        return parse(bytes.data(), bytes.size());
+    }
+
+    const Header &header() const { return header_; }
+    bool done() const { return tick_ >= header_.ticks; }
+    uint32_t tick() const { return tick_; }             // ticks consumed so far
+    int first_mismatch() const { return firstMismatch_; } // -1 while every check matched
+    bool valid() const { return ok_; }                  // false if the stream was malformed
+
+    // Input for the next tick; false once the recording is exhausted
+    bool next(Frame &out) {
+        if (done() || !ok_) return false;
+        if (run_ > 0) {
+            --run_;
+        } else {
+            apply_change();
+            run_ = next_run();
+        }
+        out = cur_;
+        ++tick_;
+        return ok_;
+    }
+    // State hash after the tick next() just returned
+    bool check(uint32_t stateHash) {
+        if (tick_ == 0 || tick_ > hashes_.size()) return false;
+        bool match = hashes_[tick_ - 1] == fold_hash(stateHash);
+        if (!match && firstMismatch_ < 0) firstMismatch_ = (int)tick_ - 1;
+        return match;
+    }
+
+private:
+    uint32_t next_run() {
+        detail::Cursor c = cursor();
+        uint32_t run = c.varint();
+        commit(c);
+        return run;
+    }
+    void apply_change() {
+        using namespace detail;
+        Cursor c = cursor();
+        uint8_t tag = c.u8();
+        if (tag & kTagEnd) { ok_ = false; return; } // more ticks in the header than in the stream
+        if (tag & kTagButtons) cur_.buttons = c.u16();
+        if (tag & kTagStylus) {
+            cur_.x = (int16_t)(cur_.x + unzigzag(c.varint()));
+            cur_.y = (int16_t)(cur_.y + unzigzag(c.varint()));
+        }
+        commit(c);
+    }
+    detail::Cursor cursor() const {
+        const uint8_t *base = stream_.data();
+        return detail::Cursor{base + cursor_, base + stream_.size(), true};
+    }
+    void commit(const detail::Cursor &c) {
+        if (!c.ok) ok_ = false;
+        cursor_ = (size_t)(c.p - stream_.data());
+    }
+
+    Header header_;
+    std::vector<uint8_t> stream_;
+    std::vector<uint16_t> hashes_;
+    size_t cursor_ = 0;
+    uint32_t run_ = 0;
+    uint32_t tick_ = 0;
+    Frame cur_;
+    int firstMismatch_ = -1;
+    bool ok_ = true;
+};
+
+} // namespace replay
@@ -0,0 +1,35 @@
+// sim.hpp - numeric type used by the gameplay simulation (float or deterministic fixed point)
+#pragma once
+#include <cmath>
+#include "fixed.hpp"
+#include "fastmath.hpp"
+
+// Build with -DBALLISTICA_FIXED_SIM (make FIXED_SIM=1) to run balls, bat, pickups, lasers,
+// moving bricks and particles in Q16.16 so state is bit-identical across 3DS and host builds.
+// Default builds keep plain float. Simulation code uses sim::real and the sim:: math below;
+// only rendering converts back with sim::to_float(). sin/cos/atan2 are the table and polynomial
+// versions from fastmath.hpp in both builds.
+namespace sim {
+
+#ifdef BALLISTICA_FIXED_SIM
+typedef fx::Fixed real;
+inline real sqrt(real v) { return fx::sqrt(v); }
+#else
+typedef float real;
+inline real sqrt(real v) { return std::sqrt(v); }
+#endif
+inline real sin(real v) { return fastmath::sin(v); }
+inline real cos(real v) { return fastmath::cos(v); }
+inline real atan2(real y, real x) { return fastmath::atan2(y, x); }
+inline real rsqrt(real v) { return fastmath::rsqrt(v); }
+// Length of (x, y); *inv (if given) receives 1/length for normalising, 0 for the zero vector
+inline real length(real x, real y, real *inv = nullptr) { return fastmath::length(x, y, inv); }
+
+inline float to_float(real v) { return fx::to_float(v); }
+inline real fabs(real v) { return fx::abs(v); }
+inline int floor_int(real v) { return fx::floor_int(v); }
+inline int trunc_int(real v) { return fx::trunc_int(v); } // same as an (int) cast
+inline real min(real a, real b) { return b < a ? b : a; }
+inline real max(real a, real b) { return a < b ? b : a; }
+
+} // namespace sim
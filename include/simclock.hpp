@@ -0,0 +1,48 @@
+// simclock.hpp - fixed-timestep accumulator for the simulation loop
+#pragma once
+#include <cstdint>
+
+// Wall time from the platform clock is accumulated and spent in fixed ticks, so game speed
+// (and the per-level SPEED multiplier) no longer depends on how often a frame is presented.
+// After a slow frame several ticks run back to back, up to kMaxCatchUp; anything beyond
+// that is dropped so one long stall (e.g. the HOME menu) cannot cause a spiral of catch-up.
+// alpha() is how far wall time has moved into the next tick, for render interpolation.
+// Header-only and platform independent (callers pass the raw tick counter and its rate).
+namespace simclock {
+
+static constexpr int kSimHz = 60;      // tick rate; all gameplay constants are tuned per 1/60 s
+static constexpr int kMaxCatchUp = 4;  // most ticks run for one presented frame
+
+struct Clock {
+    uint64_t tickLen = 0;  // clock units per tick
+    uint64_t acc = 0;      // unspent clock units (< tickLen after advance)
+    uint64_t last = 0;
+    bool started = false;
+
+    void init(uint64_t unitsPerSecond) {
+        tickLen = unitsPerSecond / kSimHz;
+        if (tickLen == 0) tickLen = 1;
+        acc = 0; started = false;
+    }
+    // Forget elapsed time (after loading or while suspended) without running ticks for it
+    void reset() { started = false; acc = 0; }
+
+    // Feed the current clock reading; returns the number of ticks to run now.
+    int advance(uint64_t now) {
+        if (!started) { started = true; last = now; return 1; }
+        uint64_t dt = now - last;
+        last = now;
+        // A frame within 1/16 tick of the tick length counts as exactly one tick. Vsync jitter
+        // would otherwise alternate 0 and 2 ticks on a display running at the tick rate.
+        uint64_t slack = tickLen / 16;
+        if (dt + slack >= tickLen && dt <= tickLen + slack) dt = tickLen;
+        acc += dt;
+        int steps = (int)(acc / tickLen);
+        acc -= (uint64_t)steps * tickLen;
+        if (steps > kMaxCatchUp) steps = kMaxCatchUp;
+        return steps;
+    }
+    float alpha() const { return tickLen ? (float)acc / (float)tickLen : 0.f; }
+};
+
+} // namespace simclock
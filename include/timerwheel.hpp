@@ -0,0 +1,155 @@
+// timerwheel.hpp - frame-indexed timing wheel for delayed gameplay work
+#pragma once
+#include <cstdint>
+
+// Each event is bucketed by its due tick modulo Slots. A bucket is an intrusive doubly
+// linked list over a fixed node array, so schedule and cancel are O(1) and advance() only
+// walks the bucket of the new tick. Delays of Slots ticks or more share their bucket with
+// earlier turns of the wheel and are skipped until their due tick comes round, so pick
+// Slots above the common delays. Storage is inline: nothing allocates, and scheduling into a
+// full wheel fails. Header-only and platform independent.
+namespace timerwheel {
+
+template <typename Event, int Slots, int Capacity>
+class Wheel {
+    static_assert(Slots > 0 && (Slots & (Slots - 1)) == 0, "Slots must be a power of two");
+    static_assert(Capacity > 0 && Capacity < 32767, "Capacity must fit 16-bit node links");
+public:
+    struct Handle {
+        int16_t node = -1;
+        uint16_t gen = 0;  // 0 is never issued, so a default Handle is never pending
+    };
+
+    Wheel() { clear(); }
+
+    uint32_t now() const { return now_; }
+    int pending() const { return pending_; }
+
+    // Drop every pending event; outstanding handles go stale. Safe to call from a callback
+    // running inside advance() (the rest of that tick's events are dropped too).
+    void clear() {
+        for (int s = 0; s < Slots; ++s) head_[s] = tail_[s] = -1;
+        for (int i = 0; i < Capacity; ++i) {
+            Node &n = nodes_[i];
+            if (n.where != kFree) bump(n);
+            n.where = kFree;
+            n.next = (int16_t)(i + 1 < Capacity ? i + 1 : -1);
+        }
+        free_ = 0;
+        pending_ = 0;
+        ++epoch_;
+    }
+
+    // Fire ev `delay` ticks from now (1 = on the next advance(); smaller delays are clamped)
+    bool schedule(int delay, const Event &ev, Handle *out = nullptr) {
+        if (free_ < 0) return false;
+        if (delay < 1) delay = 1;
+        int16_t i = free_;
+        Node &n = nodes_[i];
+        free_ = n.next;
+        n.ev = ev;
+        n.due = now_ + (uint32_t)delay;
+        link(i, (int)(n.due & (Slots - 1)));
+        ++pending_;
+        if (out) { out->node = i; out->gen = n.gen; }
+        return true;
+    }
+
+    bool cancel(Handle h) {
+        Node *n = live(h);
+        if (!n) return false;
+        if (n->where == kFiring) { n->where = kCancelled; bump(*n); } // released by advance()
+        else { unlink(h.node); release(h.node); }
+        --pending_;
+        return true;
+    }
+    bool scheduled(Handle h) const { return live(h) != nullptr; }
+    // Ticks until h fires (1 = next advance), or 0 if it is not pending
+    int remaining(Handle h) const {
+        const Node *n = live(h);
+        return (n && n->where >= 0) ? (int)(n->due - now_) : 0;
+    }
+
+    // Move to the next tick and call fire(ev) for each event due on it, in scheduling order.
+    // Callbacks may schedule, cancel or clear. Returns the number of events fired.
+    template <typename Fire>
+    int advance(Fire fire) {
+        const int s = (int)(++now_ & (Slots - 1));
+        int16_t first = -1, last = -1;
+        for (int16_t i = head_[s]; i >= 0;) {
+            int16_t next = nodes_[i].next;
+            if (nodes_[i].due == now_) {
+                unlink(i);
+                nodes_[i].where = kFiring;
+                nodes_[i].next = -1;
+                if (last >= 0) nodes_[last].next = i; else first = i;
+                last = i;
+            }
+            i = next;
+        }
+        int fired = 0;
+        const uint32_t epoch = epoch_;
+        while (first >= 0) {
+            int16_t i = first;
+            first = nodes_[i].next;
+            if (nodes_[i].where == kCancelled) { release(i); continue; }
+            Event ev = nodes_[i].ev;
+            release(i);
+            --pending_;
+            ++fired;
+            fire(ev);
+            if (epoch_ != epoch) break; // cleared by the callback
+        }
+        return fired;
+    }
+
+private:
+    enum : int16_t { kFree = -1, kFiring = -2, kCancelled = -3 };
+    struct Node {
+        Event ev;
+        uint32_t due = 0;
+        int16_t prev = -1, next = -1;
+        int16_t where = kFree;  // bucket index, or one of the states above
+        uint16_t gen = 1;
+    };
+
+    static void bump(Node &n) { if (++n.gen == 0) n.gen = 1; }
+    const Node *live(Handle h) const {
+        if (h.node < 0 || h.node >= Capacity) return nullptr;
+        const Node &n = nodes_[h.node];
+        return (n.gen == h.gen && (n.where >= 0 || n.where == kFiring)) ? &n : nullptr;
+    }
+    Node *live(Handle h) { return const_cast<Node *>(static_cast<const Wheel *>(this)->live(h)); }
+
+    void link(int16_t i, int s) {
+        Node &n = nodes_[i];
+        n.where = (int16_t)s;
+        n.prev = tail_[s];
+        n.next = -1;
+        if (tail_[s] >= 0) nodes_[tail_[s]].next = i; else head_[s] = i;
+        tail_[s] = i;
+    }
+    void unlink(int16_t i) {
+        Node &n = nodes_[i];
+        const int s = n.where;
+        if (n.prev >= 0) nodes_[n.prev].next = n.next; else head_[s] = n.next;
+        if (n.next >= 0) nodes_[n.next].prev = n.prev; else tail_[s] = n.prev;
+    }
+    void release(int16_t i) {
+        Node &n = nodes_[i];
+        if (n.where != kCancelled) bump(n);
+        n.where = kFree;
+        n.next = free_;
+        free_ = i;
+    }
+
+    Node nodes_[Capacity];
+    int16_t head_[Slots];
+    int16_t tail_[Slots];
+    int16_t free_ = -1;
+    int pending_ = 0;
+    uint32_t now_ = 0;
+    uint32_t epoch_ = 0;
+};
+
+} // namespace timerwheel
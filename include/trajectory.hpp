@@ -0,0 +1,140 @@
+// trajectory.hpp - ball path prediction through walls and the brick grid, with a per-ball cache
+#pragma once
+#include <cstdint>
+#include "collision.hpp"
+
+// The ball centre is followed as a ray: each leg runs to the nearest side wall, the ceiling
+// or the bat line, and is swept through the grid with collision::sweep_grid (same expanded
+// cell model as the game), so the first brick face on the leg ends it. Walls and brick faces
+// reflect one velocity component; bricks are assumed to stay put. The path stops at the bat
+// line, after maxBounces reflections, or when the ball starts inside a brick. Header-only,
+// platform independent and templated on the scalar type like collision.hpp.
+namespace trajectory {
+
+template <typename T>
+struct Bounds {
+    T minX, maxX;  // ball centre x at the left / right wall contact
+    T minY;        // ball centre y at the ceiling contact
+    T batY;        // ball centre y where the ball meets the bat line
+};
+
+template <typename T>
+struct Path {
+    static constexpr int kMaxPoints = 16;
+    T x[kMaxPoints], y[kMaxPoints];  // start point, then each bounce point (ball centre)
+    int points = 0;
+    bool reachesBat = false;         // the last point lies on the bat line
+    T batX = T(0);                   // ball centre x at the bat line (when reachesBat)
+    int bricks = 0;                  // bounces off bricks (the rest are walls)
+};
+
+// Trace from centre (x, y) with per-tick velocity (vx, vy). isSolid(col, row) is the same
+// predicate sweep_grid takes; leave out bricks the ball passes through.
+template <typename T, typename SolidFn>
+void predict(const collision::GridGeom<T> &g, const Bounds<T> &b, T x, T y, T vx, T vy,
+             int maxBounces, SolidFn isSolid, Path<T> &out)
+{
+    const T zero = T(0);
+    const T kEps = T(1) / T(16);
+    out.points = 0;
+    out.reachesBat = false;
+    out.bricks = 0;
+    out.x[0] = x; out.y[0] = y; out.points = 1;
+    if (vx == zero && vy == zero) return;
+    if (maxBounces > Path<T>::kMaxPoints - 2) maxBounces = Path<T>::kMaxPoints - 2;
+    const T kInf = fx::huge<T>();
+    for (int bounce = 0; bounce <= maxBounces; ++bounce) {
+        // Ticks until each boundary along the current direction; the earliest ends the leg
+        T tx = kInf, ty = kInf;
+        if (vx > zero) tx = (b.maxX - x) / vx;
+        else if (vx < zero) tx = (b.minX - x) / vx;
+        if (vy > zero) ty = (b.batY - y) / vy;
+        else if (vy < zero) ty = (b.minY - y) / vy;
+        if (tx < zero) tx = zero;
+        if (ty < zero) ty = zero;
+        const bool wallX = tx < ty;
+        const T t = wallX ? tx : ty;
+        const T ex = x + vx * t, ey = y + vy * t;
+        collision::SweepHit<T> hit = collision::sweep_grid(g, x, y, ex, ey, isSolid);
+        if (hit.hit) {
+            if (hit.face == collision::Face::None) return;  // started inside a brick
+            // Contact point pushed clear of the face (as resolve_hit does) so the next leg
+            // does not start on the boundary of this brick or its neighbours
+            x = hit.x; y = hit.y;
+            switch (hit.face) {
+            case collision::Face::Left:   x = x - kEps; vx = -vx; break;
+            case collision::Face::Right:  x = x + kEps; vx = -vx; break;
+            case collision::Face::Top:    y = y - kEps; vy = -vy; break;
+            default:                      y = y + kEps; vy = -vy; break;
+            }
+            ++out.bricks;
+        } else {
+            x = ex; y = ey;
+            if (!wallX && vy > zero) {
+                out.x[out.points] = x; out.y[out.points] = y; ++out.points;
+                out.reachesBat = true;
+                out.batX = x;
+                return;
+            }
+            if (wallX) vx = -vx; else vy = -vy;
+        }
+        out.x[out.points] = x; out.y[out.points] = y; ++out.points;
+    }
+}
+
+// Last path per ball id, reused while the ball's velocity and the grid are unchanged and
+// the ball is still on the first leg. Direct mapped: ids share an entry modulo Slots.
+template <typename T, int Slots>
+class Cache {
+public:
+    struct Stats { long hits = 0, misses = 0; };
+
+    // grid identifies the brick grid isSolid reads and gridVersion must change whenever
+    // isSolid would answer differently for it (versions of different grids may coincide)
+    template <typename SolidFn>
+    const Path<T> &get(int id, const void *grid, uint32_t gridVersion, const collision::GridGeom<T> &g,
+                       const Bounds<T> &b, T x, T y, T vx, T vy, int maxBounces, SolidFn isSolid) {
+        Entry &e = entries_[(unsigned)id % Slots];
+        if (e.id == id && e.grid == grid && e.gridVersion == gridVersion && e.vx == vx && e.vy == vy &&
+            e.maxBounces == maxBounces && on_first_leg(e.path, x, y, vx, vy)) {
+            ++stats_.hits;
+            return e.path;
+        }
+        ++stats_.misses;
+        predict(g, b, x, y, vx, vy, maxBounces, isSolid, e.path);
+        e.id = id; e.grid = grid; e.gridVersion = gridVersion; e.vx = vx; e.vy = vy; e.maxBounces = maxBounces;
+        return e.path;
+    }
+    // Cached path for id without recomputing (nullptr if none)
+    const Path<T> *peek(int id) const {
+        const Entry &e = entries_[(unsigned)id % Slots];
+        return e.id == id ? &e.path : nullptr;
+    }
+    void invalidate(int id) { Entry &e = entries_[(unsigned)id % Slots]; if (e.id == id) e.id = -1; }
+    void clear() { for (int i = 0; i < Slots; ++i) entries_[i].id = -1; }
+    const Stats &stats() const { return stats_; }
+
+private:
+    struct Entry {
+        int id = -1;
+        const void *grid = nullptr;
+        uint32_t gridVersion = 0;
+        T vx = T(0), vy = T(0);
+        int maxBounces = 0;
+        Path<T> path;
+    };
+    // (x, y) lies on the segment from the first point to the second, within a pixel sideways
+    static bool on_first_leg(const Path<T> &p, T x, T y, T vx, T vy) {
+        if (p.points < 2) return p.points == 1 && x == p.x[0] && y == p.y[0];
+        const T dx = x - p.x[0], dy = y - p.y[0];
+        const T along = dx * vx + dy * vy;
+        const T legEnd = (p.x[1] - p.x[0]) * vx + (p.y[1] - p.y[0]) * vy;
+        if (along < T(0) || along > legEnd) return false;
+        const T side = fx::abs(dx * vy - dy * vx);  // |cross| = sideways distance * |v|
+        return side <= fx::abs(vx) + fx::abs(vy);   // L1 >= |v|, so at most ~1px off the line
+    }
+    Entry entries_[Slots];
+    Stats stats_;
+};
+
+} // namespace trajectory
@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+"""
+Generate the sprite sheet headers the host (PLATFORM=host) build needs in place of tex3ds/bin2o.
+
+For every gfx/<NAME>.t3s this writes, into the output directory:
+- <NAME>.h      index defines in tex3ds naming (<NAME>_<image>_idx; single-image sheets also
+                get <NAME>_idx), so the shared sources compile unchanged
+- <NAME>_t3x.h  the bin2o declarations (nothing on the host references the data)
+and one host_sheets.h with the pixel size of every image, read from the PNG headers, which
+source/platform/host/hardware_host.cpp hands out as subtextures.
+
+Usage: scripts/gen_host_headers.py [gfx-dir] [out-dir]   (default: gfx build-host/gen)
+"""
+import re
+import struct
+import sys
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parents[1]
+
+
+def sheet_images(t3s: Path):
+    """Image paths listed in a .t3s file, in atlas index order (option lines skipped)."""
+    images = []
+    lines = t3s.read_text().split('\n')
+    skip_value = False
+    for raw in lines:
+        line = raw.strip()
+        if not line or line.startswith('#'):
+            continue
+        if skip_value:
+            skip_value = False
+            continue
+        if line.startswith('-'):
+            # Options with a separate value line (-f rgba8, -z auto, ...)
+            skip_value = line in ('-f', '-z', '-m', '-q', '-b', '--format', '--compress', '--mipmap', '--quality', '--border')
+            continue
+        images.append(line)
+    return images
+
+
+def png_size(path: Path):
+    with path.open('rb') as f:
+        head = f.read(24)
+    if len(head) < 24 or head[:8] != b'\x89PNG\r\n\x1a\n' or head[12:16] != b'IHDR':
+        raise ValueError(f'{path}: not a PNG')
+    return struct.unpack('>II', head[16:24])
+
+
+def ident(name: str) -> str:
+    return re.sub(r'[^A-Za-z0-9_]', '_', name)
+
+
+def main():
+    gfx = Path(sys.argv[1]) if len(sys.argv) > 1 else ROOT / 'gfx'
+    out = Path(sys.argv[2]) if len(sys.argv) > 2 else ROOT / 'build-host' / 'gen'
+    out.mkdir(parents=True, exist_ok=True)
+    sheets = []
+    for t3s in sorted(gfx.glob('*.t3s')):
+        name = t3s.stem
+        images = sheet_images(t3s)
+        sizes = [png_size(t3s.parent / img) for img in images]
+        defines = [f'#define {name}_{ident(Path(img).stem)}_idx {i}' for i, img in enumerate(images)]
+        if len(images) == 1:
+            defines.append(f'#define {name}_idx 0')
+        (out / f'{name}.h').write_text('// Generated by scripts/gen_host_headers.py - do not edit\n#pragma once\n'
+                                       + '\n'.join(defines) + '\n')
+        (out / f'{name}_t3x.h').write_text('// Generated by scripts/gen_host_headers.py - do not edit\n#pragma once\n'
+                                           '#include <3ds.h>\n'
+                                           f'extern const u8 {name}_t3x[];\nextern const u32 {name}_t3x_size;\n')
+        sheets.append((name, sizes))
+
+    lines = ['// Generated by scripts/gen_host_headers.py - do not edit',
+             '// Pixel size of every image in every sprite sheet, in atlas index order.',
+             '#pragma once',
+             '#include <cstdint>',
+             '',
+             'struct HostSheetImage { uint16_t w, h; };',
+             'struct HostSheet { const char* name; const HostSheetImage* images; int count; };',
+             '']
+    for name, sizes in sheets:
+        body = ', '.join(f'{{{w}, {h}}}' for w, h in sizes)
+        lines.append(f'static const HostSheetImage kHostSheet_{name}[] = {{ {body} }};')
+    lines.append('')
+    lines.append('static const HostSheet kHostSheets[] = {')
+    for name, sizes in sheets:
+        lines.append(f'    {{ "{name}", kHostSheet_{name}, {len(sizes)} }},')
+    lines.append('};')
+    (out / 'host_sheets.h').write_text('\n'.join(lines) + '\n')
+    print(f'gen_host_headers: {len(sheets)} sheets -> {out}')
+
+
+if __name__ == '__main__':
+    main()
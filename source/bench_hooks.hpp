@@ -0,0 +1,51 @@
+// bench_hooks.hpp - entry points into game.cpp / levels.cpp internals for the host microbenchmarks
+#pragma once
+
+// Only compiled into the benchmark build (make PLATFORM=host bench defines BALLISTICA_BENCH);
+// in every other build BENCH_COUNT() is empty and none of this exists.
+#ifdef BALLISTICA_BENCH
+#include <cstdint>
+#include <cstdio>
+
+namespace bench_hooks {
+
+// Call counters bumped inside the measured functions, so a play session yields calls per tick
+enum Counter { Ticks, BallBricks, MovingBricks, BombDetonations, ExplodeBomb, kCounters };
+extern uint64_t g_calls[kCounters];
+
+// ---- game.cpp ----
+// Playing on level `index` of the loaded pack with one ball parked on the bat, as after START
+void start_level(int index);
+// Replace the balls with a free-flying ball whose last tick went from (x-vx, y-vy) to (x, y)
+void clear_balls();
+void add_ball(float x, float y, float vx, float vy);
+void add_murder_ball(float x, float y, float vx, float vy);
+// Top-left and downward speed that carry a ball onto the middle of the bat within one tick
+void bat_landing(float& x, float& y, float& vy);
+// Ball y past which a ball is lost at the bottom
+float bottom_y();
+int lives();
+int active_balls();
+// Copy the ball store aside / put the copy back (untimed setup between measured batches)
+void save_balls();
+void restore_balls();
+// handle_ball_bricks() for every active ball; returns how many ran
+int ball_bricks();
+// update_moving_bricks()
+void moving_bricks();
+// Queue the bomb at (c, r) to detonate next tick, as a neighbouring explosion would
+bool trigger_bomb(int c, int r);
+// run_scheduled_events() + drain_frame_events(): one tick of bomb chain work; returns whether
+// detonations are still queued
+bool bomb_tick();
+
+// ---- levels.cpp ----
+// levels::parseAll() on an open pack file; returns the number of levels parsed
+int parse(FILE* f);
+
+} // namespace bench_hooks
+
+#define BENCH_COUNT(c) (++bench_hooks::g_calls[bench_hooks::c])
+#else
+#define BENCH_COUNT(c) ((void)0)
+#endif
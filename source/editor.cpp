@@ -622,6 +622,7 @@ EditorAction update(const InputState &in) {
 
 // Rendering -------------------------------------------------------------------
 void render() {
+    HwDrawScope scope("editor");
     init_if_needed();
     // Sync Paste button enabled state every frame (in case copy file added/removed externally)
     if (g_pasteIndex != (size_t)-1 && g_pasteIndex < g_buttons.size()) g_buttons[g_pasteIndex].enabled = editor_copy_exists();
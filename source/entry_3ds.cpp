@@ -7,7 +7,30 @@
 #include "game.hpp"
 #include "sound.hpp"
 #include "options.hpp"
-#include "INSTRUCT.h"
+#include "simclock.hpp"
+#include "replay_session.hpp"
+
+// Edge-triggered inputs must reach exactly one simulation tick: they are held over while a
+// frame runs no tick, and cleared for the extra ticks of a catch-up frame.
+static void carry_edges(InputState& dst, const InputState& src) {
+    dst.touchPressed |= src.touchPressed;
+    dst.dpadUpPressed |= src.dpadUpPressed;
+    dst.dpadDownPressed |= src.dpadDownPressed;
+    dst.startPressed |= src.startPressed;
+    dst.selectPressed |= src.selectPressed;
+    dst.aPressed |= src.aPressed;
+    dst.bPressed |= src.bPressed;
+    dst.xPressed |= src.xPressed;
+    dst.levelPrevPressed |= src.levelPrevPressed;
+    dst.levelNextPressed |= src.levelNextPressed;
+}
+static void clear_edges(InputState& in) {
+    InputState none;
+    none.touching = in.touching; none.stylusX = in.stylusX; none.stylusY = in.stylusY;
+    none.fireHeld = in.fireHeld; none.dpadDownHeld = in.dpadDownHeld;
+    none.lHeld = in.lHeld; none.rHeld = in.rHeld;
+    in = none;
+}
 
 int main(int argc, char** argv) {
     if(!hw_init()) return -1;
@@ -25,15 +48,39 @@ int main(int argc, char** argv) {
         sound::play_music("music", /*loop=*/true, /*volume=*/0.8f, /*relativePath=*/true);
     }
     game_init();
+    // Per-session seed for the tilt jitter; a recording carries it so playback matches
+    game_set_seed((uint32_t)hw_ticks());
+    // Optional session recording (options.cfg record_replay=1): every tick's input and state
+    // hash, saved to sdmc:/ballistica/replays/last.rpl when play returns to the title and on exit
+    const bool recording = options::is_replay_recording_enabled();
+    replay::Writer recorder;
+    if (recording) recorder.begin(replay::capture_header());
+    GameMode lastMode = game_mode();
     u32 frame=0;
     bool showTopLogs=false;
     bool showBottomLogs=false;
+    simclock::Clock clock;
+    clock.init(hw_ticks_per_second());
+    InputState carried; // edges seen by no tick yet
 
     while (aptMainLoop()) {
         InputState in; hw_poll_input(in);
         // Exit if game layer requested (X on title or touch EXIT) or START+SELECT chord anywhere as hard quit
         if(exit_requested() || (in.startPressed && in.selectPressed)) break;
-    game_update(in);
+        // Fixed-rate simulation: zero or more ticks per presented frame
+        InputState tickIn = in;
+        carry_edges(tickIn, carried);
+        int steps = clock.advance(hw_ticks());
+        for (int s = 0; s < steps; ++s) {
+            game_update(tickIn);
+            if (recording) recorder.tick(replay::pack(tickIn), game_state_hash());
+            clear_edges(tickIn);
+        }
+        if (recording && lastMode == GameMode::Playing && game_mode() == GameMode::Title) replay::save(recorder);
+        lastMode = game_mode();
+        if (steps == 0) carry_edges(carried, in);
+        else clear_edges(carried);
+        game_set_render_alpha(clock.alpha());
     sound::update();
         // Toggle log overlays: exact combo L+R+Up or L+R+Down (edge on Up/Down).
         if(in.lHeld && in.rHeld) {
@@ -41,73 +88,11 @@ int main(int argc, char** argv) {
             if(in.dpadDownPressed) showBottomLogs = !showBottomLogs;
         }
         hw_begin_frame();
-        GameMode gm = game_mode();
-        // Dedicated handling: Editor and Options both own the bottom screen completely.
-        if(gm == GameMode::Options) {
-            // Top: simple dark backdrop (could show rotating title sequence later if desired)
-            hw_set_top();
-            C2D_DrawRectSolid(0,0,0,400,240,C2D_Color32(0,0,0,255));
-            hw_draw_text(8,8,"Options",0xFFFFFFFF);
-            if(showTopLogs) hw_draw_logs(4,40,200);
-            // Bottom: full options UI (game_render draws it for this mode)
-            hw_set_bottom();
-            C2D_DrawRectSolid(0,0,0,320,240,C2D_Color32(0,0,0,255));
-            game_render();
-            hw_end_frame();
-            ++frame;
-            continue;
-        }
-    if(gm == GameMode::Editor) {
-            // Editor lives on the bottom screen for touch drawing.
-            // Top: show INSTRUCT.png (same as main menu) while the editor is open.
-            hw_set_top();
-            C2D_DrawRectSolid(0,0,0,400,240,C2D_Color32(0,0,0,255));
-            if (hw_sheet_loaded(HwSheet::Instruct)) {
-                C2D_Image instruct = hw_image_from(HwSheet::Instruct, INSTRUCT_idx);
-                // Draw at its natural top-screen position (image is designed for top)
-                hw_draw_sprite(instruct, 0, 0, 0, 1.0f, 1.0f);
-            }
-            if(showTopLogs) hw_draw_logs(4,40,200);
-            // Bottom: editor UI
-            hw_set_bottom();
-            C2D_DrawRectSolid(0,0,0,320,240,C2D_Color32(0,0,0,255));
-            game_render();
-        } else {
-            // Normal: gameplay/title etc on top
-            hw_set_top();
-            game_render();
-            if(showTopLogs) hw_draw_logs(4,4,232);
-            // Bottom screen overlays (title menu only; gameplay bottom is drawn by game_render)
-            hw_set_bottom();
-            if(gm == GameMode::Title) {
-                // Bottom: simple title UI
-                // Screen already cleared at frame-begin; draw buttons + hint
-                // Underlay: MENUBOTTOM sheet (single image at index 0) behind the buttons if available
-                if (hw_sheet_loaded(HwSheet::MenuBottom)) {
-                    C2D_Image under = hw_image_from(HwSheet::MenuBottom, 0);
-                    hw_draw_sprite(under, 0, 0, 0, 1.0f, 1.0f);
-                }
-                hw_draw_text(10, 6, "START=Play  SELECT=Editor  X=Exit", 0xFFFFFFFF);
-                // Version label at bottom-left
-                char vbuf[32];
-                std::snprintf(vbuf, sizeof vbuf, "Version %.1f", game::kGameVersion);
-                hw_draw_text(10, 230, vbuf, 0xFFFF00FF); // yellow, scale 1.0 via hw_draw_text
-                game_render_title_buttons(in);
-                if(in.touching) {
-                    // small crosshair to visualize touch
-                    int tx=in.stylusX, ty=in.stylusY;
-                    C2D_DrawRectSolid(tx-2, ty, 0, 5,1,C2D_Color32(255,255,0,255));
-                    C2D_DrawRectSolid(tx, ty-2, 0, 1,5,C2D_Color32(255,255,0,255));
-                }
-                if(showBottomLogs) hw_draw_logs(4, 200, 36);
-            } else {
-                // Gameplay: bottom is rendered by game_render; only optional logs overlay here.
-                if(showBottomLogs) hw_draw_logs(2, 220, 18);
-            }
-        }
+        game_render_frame(in, showTopLogs, showBottomLogs);
         hw_end_frame();
     ++frame;
     }
+    if (recording) replay::save(recorder);
     sound::shutdown();
     hw_shutdown();
     return 0;
@@ -14,6 +14,7 @@
 #include <algorithm>
 #include <cstdint>
 #include <cmath>
+#include <cstring>
 #include "hardware.hpp"
 #include "IMAGE.h"
 #include "IMAGE_t3x.h"
@@ -29,10 +30,19 @@
 #include "sound.hpp"
 #include "levels.hpp"
 #include "brick.hpp"
+#include "collision.hpp"
+#include "brickgrid.hpp"
+#include "sim.hpp"
+#include "balls.hpp"
+#include "particles.hpp"
+#include "pool.hpp"
+#include "timerwheel.hpp"
+#include "trajectory.hpp"
 #include "SUPPORT.HPP" // legacy constants BATWIDTH, BATHEIGHT, BALLWIDTH, BALLHEIGHT
 #include "editor.hpp"
 #include "options.hpp"
 #include "ui_button.hpp"
+#include "bench_hooks.hpp"
 #include <vector>
 #include <string>
 #include "OPTIONS.h"
@@ -80,41 +90,56 @@ namespace game
     static constexpr int kBrickH = 9;
     static constexpr int kBallW = 6;  // logical collision size
     static constexpr int kBallH = 6;
+    // Simulation scalar: float, or Q16.16 fixed point with -DBALLISTICA_FIXED_SIM (see sim.hpp)
+    typedef sim::real real;
+    typedef balls::Store<real> BallStore;
+    static constexpr int kStressBalls = 512;  // debug stress mode (L+R+A while playing)
+    static constexpr int kBallReserve = 640; // stress mode plus splits without regrowing
+    // One ball of the SoA store by reference, so per-ball logic keeps the b.x / b.vy syntax.
+    // Valid until the store grows: new balls are only added from spawnQueue after the ball loop.
     struct Ball
     {
-        float x, y;
-        float vx, vy;
-        float px, py;
-        bool active;
-    bool isMurder;
-        C2D_Image img;
+        real &x, &y;
+        real &vx, &vy;
+        real &px, &py;
+        uint8_t &flags;
+        Ball(BallStore &s, int i)
+            : x(s.x[i]), y(s.y[i]), vx(s.vx[i]), vy(s.vy[i]), px(s.px[i]), py(s.py[i]), flags(s.flags[i]) {}
+        bool active() const { return (flags & balls::kActive) != 0; }
+        bool isMurder() const { return (flags & balls::kMurder) != 0; }
+        void activate() { flags |= balls::kActive; }
+        void deactivate() { flags &= (uint8_t)~balls::kActive; }
     };
     struct Laser
     {
-        float x, y;
-        bool active;
+        real x, y;
+        int16_t col = -1;        // grid column the target was resolved in
+        int16_t targetRow = -1;  // first occupied row at/above the tip (-1 = clear to the top)
+        const brickgrid::Occupancy *grid = nullptr; // level the target was resolved in
+        uint32_t colVersion = 0; // Occupancy::colVersion[col] when the target was resolved
     };
+    // Falling entities reference their sprite by IMAGE atlas index; size is taken at spawn
     struct FallingLetter
     {
-        float x, y;   // top-left position
-        float vy;     // vertical velocity
+        real x, y;    // top-left position
+        real vy;      // vertical velocity
+        real w, h;    // sprite size (pickup collision box)
         int letter;   // 0=B,1=O,2=N,3=U,4=S
-        bool active;
-        C2D_Image img;
+        int16_t sprite;
     };
     // Falling hazard (Destroy Bat Bricks: F1/F2). If it hits the bat, lose a life immediately.
     struct FallingHazard
     {
-        float x, y;   // top-left
-        float vy;     // vertical velocity
+        real x, y;    // top-left
+        real vy;      // vertical velocity
+        real w, h;
         int type;     // 1 = F1 (slow), 2 = F2 (fast)
-        bool active;
-        C2D_Image img;
+        int16_t sprite;
     };
     struct Bat
     {
-        float x, y;
-        float width, height;
+        real x, y;
+        real width, height;
         C2D_Image img;
     };
     enum class Mode
@@ -136,125 +161,294 @@ namespace game
 
     // Title buttons
     struct TitleBtn { UIButton btn; Mode next; bool isExit=false; };
-    static TitleBtn kTitleButtons[4];
+    static TitleBtn make_title_btn(int y, const char *label, uint32_t color, Mode next, bool isExit)
+    {
+        TitleBtn tb;
+        tb.btn.x = 60; tb.btn.y = y; tb.btn.w = 200; tb.btn.h = 24;
+        tb.btn.label = label; tb.btn.color = color;
+        tb.next = next; tb.isExit = isExit;
+        return tb;
+    }
+    // Sized for the 320x240 bottom screen (w/h in pixels), with Exit at the bottom; shared by all worlds
+    static const TitleBtn kTitleButtons[4] = {
+        make_title_btn(60,  "PLAY",    C2D_Color32(50, 50, 70, 255), Mode::Playing, false),
+        make_title_btn(100, "EDITOR",  C2D_Color32(50, 50, 70, 255), Mode::Editor,  false),
+        make_title_btn(140, "OPTIONS", C2D_Color32(50, 50, 70, 255), Mode::Options, false),
+        make_title_btn(200, "EXIT",    C2D_Color32(60, 40, 40, 255), Mode::Title,   true),
+    };
 
     struct MovingBrickData
     {
-        float pos;
-        float dir;
-        float minX;
-        float maxX;
+        real pos;
+        real dir;
+        real minX;
+        real maxX;
+        real prevPos; // pos before this frame's advance (swept ball collision uses both)
     };
-    struct Particle
+    // Moving bricks of one grid row. minX/maxX in G.moving stay cached until the
+    // row's version in the level occupancy changes (a brick in that row was removed/set).
+    struct MovingRow
     {
-        float x, y, vx, vy;
-        int life;
-        uint32_t color;
+        const brickgrid::Occupancy *owner = nullptr; // level the cache was built from
+        uint32_t version = 0;
+        int count = 0;
+        uint8_t cols[kBrickCols];
     };
+    static constexpr int kMaxParticles = 512; // hard cap; spawns past it recycle the oldest
+    typedef particles::Pool<real, kMaxParticles> ParticlePool;
     struct BallSpawnRequest {
-        float x, y, vx, vy;
+        real x, y, vx, vy;
         bool isMurder;
     };
-    struct BombEvent
+    // Entity pool capacities (storage is inline in G; nothing grows during play)
+    static constexpr int kMaxLasers = 4;
+    static constexpr int kMaxLetters = 64;
+    static constexpr int kMaxHazards = 32;
+    // Delayed gameplay work: bomb chain detonations and the named frame timers below all run
+    // through one timing wheel (G.wheel), advanced once per simulation tick while playing.
+    enum class TimerId : uint8_t
     {
-        int c;
-        int r;
-        int frames;
-    }; // scheduled bomb trigger
+        Reverse,       // reversed stylus controls
+        LightsOff,     // darkened playfield
+        FireCooldown,  // laser re-fire debounce
+        TiltShake,     // screen shake after a tilt
+        BarrierGlow,   // barrier hit highlight
+        LevelIntro,    // level name overlay
+        DeathPhase,    // end of the current death sequence phase
+        GameOverPhase, // end of the current game-over phase
+        TiltCooldown,  // tilt debounce after use
+        TitleCycle,    // next sheet of the idle title sequence
+        Count
+    };
+    enum class EventKind : uint8_t { Bomb, Timer };
+    struct GameEvent
+    {
+        EventKind kind;
+        uint8_t timer;  // TimerId for Timer events
+        uint16_t cell;  // brickgrid cell (row * kCols + col) for Bomb events
+    };
+    // One pending detonation per cell at most (deduplicated by G.bombPending) plus one per timer
+    static constexpr int kMaxScheduled = brickgrid::kCells + (int)TimerId::Count;
+    typedef timerwheel::Wheel<GameEvent, 256, kMaxScheduled> EventWheel;
+    // Sounds raised by simulation code; kSfxDefs holds name and channels (BrickSfx order first)
+    enum class Sfx : uint8_t { BallBrick, HitHard, HardExplode, BallBat, BarrierHit, Explosion, Count };
+    // Side effects of collisions and explosions (scoring, pickups, splits, audio, particles,
+    // logging). Physics only records them in G.frameEvents; drain_frame_events() applies them
+    // in order once the ball loop is done, before queued balls are added.
+    enum class FrameEventKind : uint8_t
+    {
+        BrickEffect,   // score + hit effect of brick `id` (BrickType)
+        BatHazard,     // destroyed F1/F2 `id` drops a kill brick
+        Sound,         // play Sfx `id`
+        Explosion,     // bomb at `cell` went off: sound, particle burst (and a log line under DEBUG)
+        Dust,          // multi-hit brick crumbled at (x,y)
+        BombScheduled, // neighbour bomb at `cell` queued with `id` frames delay (DEBUG log only)
+    };
+    struct FrameEvent
+    {
+        FrameEventKind kind;
+        uint8_t id;     // see FrameEventKind
+        int16_t cell;   // brickgrid cell, -1 when not tied to one
+        real x, y;      // centre of the brick / effect
+        real vx, vy;    // BrickEffect: velocity of the ball that caused it (split direction)
+    };
+    // Gameplay events (effects, hazards, explosions) have kFrameEventReserve slots to themselves,
+    // the most a full board can raise in one tick: a cell yields at most five (every hit on a T5)
+    // since each hit removes the brick or a hit point. Sound, dust and the DEBUG bomb log fill the
+    // rest and are dropped (and counted) beyond it.
+    static constexpr int kFrameEventsPerCell = 5;
+    static constexpr int kFrameEventReserve = kFrameEventsPerCell * brickgrid::kCells;
+    static constexpr int kMaxFrameEvents = 2 * kFrameEventReserve;
+    static_assert(kBrickTraits[(int)BrickType::T5].hp <= kFrameEventsPerCell, "a T5 cell raises one effect per hit point");
+    static constexpr int kTrajectorySlots = 16;  // cached predicted paths (ball index modulo this)
+    static constexpr int kAimGuideBalls = 4;     // aim guide draws at most this many balls
+    static constexpr int kAimGuideBounces = 3;
+    static constexpr int kObserveBounces = 8;    // game_observe() follows paths this far to the bat
 
     struct State
     {
         Bat bat{};
-        std::vector<Ball> balls;
-        std::vector<Laser> lasers;
-    std::vector<FallingLetter> letters; // falling BONUS pickups
-    std::vector<FallingHazard> hazards; // falling kill bricks (F1/F2)
+        BallStore balls;
+        Pool<Laser, kMaxLasers> lasers;
+    Pool<FallingLetter, kMaxLetters> letters; // falling BONUS pickups
+    Pool<FallingHazard, kMaxHazards> hazards; // falling kill bricks (F1/F2)
         C2D_Image imgBall{};
     C2D_Image imgMurderBall{};
+    real ballSpriteW[2] = {(float)kBallW, (float)kBallW}; // rendered ball size [regular, murder]
+    real ballSpriteH[2] = {(float)kBallH, (float)kBallH};
     C2D_Image imgBatNormal{};
     C2D_Image imgBatSmall{};
     C2D_Image imgBatBig{};
     int batSizeMode = 1;       // 0=small,1=normal,2=big
-    float batCollWidth = (float)BATWIDTH; // logical collision width (changes with bat size)
+    real batCollWidth = (float)BATWIDTH; // logical collision width (changes with bat size)
         Mode mode = Mode::Title;
     int lives = 3; // changed default lives from 5 to 3
         unsigned long score = 0;
         uint8_t bonusBits = 0; // collected B1..B5 letters
         bool editorLaunched = false;
-        float prevBatX = 0.f; // for imparting momentum
+        real prevBatX = 0.f; // for imparting momentum
     bool ballLocked = false;      // true when awaiting manual launch
     bool prevTouching = false;    // previous frame stylus state to detect release
     // Drag control (relative) for bat movement
-    float dragAnchorStylusX = 0.f; // stylus X at start of current drag
-    float dragAnchorBatX = 0.f;    // bat X at drag start
+    real dragAnchorStylusX = 0.f; // stylus X at start of current drag
+    real dragAnchorBatX = 0.f;    // bat X at drag start
     bool dragging = false;         // currently dragging to move bat
-    // Level intro overlay
-    int levelIntroTimer = 0;       // frames remaining to show level name (generic, not only editor test)
-        // Timers/effects
-        int reverseTimer = 0;   // frames remaining reverse controls
-        int lightsOffTimer = 0; // frames until lights restore
+        // Timers/effects (frames remaining come from timer_left(); see TimerId)
+        EventWheel wheel;
+        EventWheel::Handle timers[(int)TimerId::Count];
+        brickgrid::Mask bombPending{}; // cells with a detonation already in the wheel
     int murderTimer = 0;    // deprecated: per-ball isMurder now controls behaviour
     // Life-loss death sequence (bat sinks then fade out/in)
     bool deathActive = false;
-    int  deathPhase = 0;       // 0=sink, 1=fadeOut, 2=fadeIn
-    int  deathTimer = 0;       // generic per-phase timer
-    float deathSinkVy = 0.0f;  // current vertical speed of bat sink
+    int  deathPhase = 0;       // 0=sink, 1=fadeOut, 2=fadeIn (1 and 2 end on TimerId::DeathPhase)
+    real deathSinkVy = 0.0f;  // current vertical speed of bat sink
     int  deathFadeAlpha = 0;   // overlay alpha while fading (0..200)
     // Laser system (re-implemented as pickup + indicator)
     bool laserEnabled = false; // collected laser ability
     bool laserReady = false;   // indicator visible and ready to fire
-    int fireCooldown = 0;      // small debounce (optional); not used for charges
         // Moving brick dynamic traversal across contiguous empty span
         std::vector<MovingBrickData> moving; // per-cell data (pos<0 => unused)
+        MovingRow movingRows[kBrickRows];   // per-row index of moving bricks + span cache stamp
         // Particles (bomb / generic)
-        std::vector<Particle> particles;
-        std::vector<BombEvent> bombEvents; // pending delayed explosions
-    std::vector<BallSpawnRequest> spawnQueue; // deferred ball spawns (processed post-update)
-    // Barrier hit glow (temporary highlight on top edge when a life is consumed by the barrier)
-    int barrierGlowTimer = 0;      // frames remaining for glow (0=off)
+        ParticlePool particles;
+    Pool<BallSpawnRequest, kBallReserve> spawnQueue; // deferred ball spawns (processed post-update)
+    Pool<FrameEvent, kMaxFrameEvents> frameEvents;   // this tick's side effects (see FrameEventKind)
+    uint32_t droppedFrameEvents = 0;                  // cosmetic events that found the queue full
+    mutable trajectory::Cache<real, kTrajectorySlots> trajectories; // predict_trajectory() results (a cache, so rendering may fill it)
     // Game Over sequence (fade to message on top screen)
     bool gameOverActive = false;
-    int  gameOverPhase = 0;   // 0=fadeIn, 1=hold, (future: 2=out)
-    int  gameOverTimer = 0;   // per-phase timer
+    int  gameOverPhase = 0;   // 0=fadeIn, 1=hold, (future: 2=out); phases end on TimerId::GameOverPhase
     int  gameOverAlpha = 0;   // overlay alpha (0..200)
     // Tilt feature
+    // Elapsed frames rather than a deadline (it also seeds the tilt jitter), so a plain counter
     int  framesSinceBarrierHit = 0; // frames since last barrier collision
     bool tiltAvailable = false;     // true when player can trigger tilt
-    int  tiltCooldownFrames = 0;    // small debounce after tilt use
-    int  tiltShakeTimer = 0;        // frames remaining of tilt shake effect
+    uint32_t seed = 0;              // mixed into the tilt jitter (game_set_seed; recorded in replays)
+    uint32_t levelsCompleted = 0;   // levels cleared since game_init (reported by game_observe)
+    uint32_t brickHits = 0;         // ball-brick contacts since start_level (reported by game_observe)
+    std::vector<DestroyedBrick> blastScratch; // laser bomb hits: reused list, keeps its capacity
+    // Title screen and input edge tracking
+    int  seqPos = 0;                // title sequence sheet (kSequence)
+    int  titlePressedBtn = -1;      // index into kTitleButtons while the stylus is held
+    bool sawTouchWhileLocked = false; // launch needs a touch then a release after the ball locks
+    int  prevGapPx = -100000;       // hinge gap seen last update (sentinel: first update)
+    bool exitRequested = false;
+    bool headless = false;          // game_world_create worlds: no sound, no high-score table
+    // Render interpolation: fraction of a simulation tick elapsed since the last update (0..1)
+    float renderAlpha = 1.0f;
     };
 
 
-    static State G;
-    static bool g_exitRequested = false;
+
+    static Ball ball_at(State &G, int i) { return Ball(G.balls, i); }
+    static real ball_sprite_w(const State &G, const Ball &b) { return G.ballSpriteW[b.isMurder() ? 1 : 0]; }
+    static real ball_sprite_h(const State &G, const Ball &b) { return G.ballSpriteH[b.isMurder() ? 1 : 0]; }
+    static real ball_sprite_w(const State &G, int i) { return G.ballSpriteW[G.balls.murder(i) ? 1 : 0]; }
+    static real ball_sprite_h(const State &G, int i) { return G.ballSpriteH[G.balls.murder(i) ? 1 : 0]; }
+    static const C2D_Image &ball_image(const State &G, int i) { return G.balls.murder(i) ? G.imgMurderBall : G.imgBall; }
+
+    // Ball draw position between the previous tick (px/py) and the current one
+    static float ball_draw_x(const State &G, int i) { return sim::to_float(G.balls.px[i] + (G.balls.x[i] - G.balls.px[i]) * G.renderAlpha); }
+    static float ball_draw_y(const State &G, int i) { return sim::to_float(G.balls.py[i] + (G.balls.y[i] - G.balls.py[i]) * G.renderAlpha); }
+
+    // Predicted path of ball i through the walls and static bricks up to the bat line, in
+    // ball-centre world coordinates (see trajectory.hpp). Cached per ball until its velocity
+    // or the brick grid changes, so the aim guide and test players can ask every frame.
+    static const trajectory::Path<real> &predict_trajectory(const State &G, int i, int maxBounces)
+    {
+        real spriteW = ball_sprite_w(G, i), spriteH = ball_sprite_h(G, i);
+        // Same limits as balls::integrate (top-left) and the bat test (logical top surface)
+        trajectory::Bounds<real> bounds;
+        bounds.minX = (real)kPlayfieldLeftWallX + spriteW * 0.5f;
+        bounds.maxX = (real)kPlayfieldRightWallX - (real)kBallW + spriteW * 0.5f;
+        bounds.minY = (real)kPlayfieldTopWallY + spriteH * 0.5f;
+        real effBatH = (G.bat.img.subtex ? G.bat.img.subtex->height : G.bat.height);
+        real batPadY = (G.bat.height - effBatH) * 0.5f;
+        if (batPadY < 0) batPadY = 0;
+        bounds.batY = G.bat.y + batPadY - (real)kBallH * 0.5f;
+        // Grid geometry as sweep_bricks; moving and pass-through bricks are left out (Occupancy::solid)
+        collision::GridGeom<real> geom;
+        geom.left = (real)levels_left(); geom.top = (real)levels_top();
+        geom.cellW = (real)levels_brick_width(); geom.cellH = (real)levels_brick_height();
+        geom.cols = kBrickCols; geom.rows = kBrickRows;
+        geom.halfW = (real)kBallW * 0.5f; geom.halfH = (real)kBallH * 0.5f;
+        brickgrid::GridView grid = levels_grid_view();
+        const brickgrid::Occupancy *occ = grid.empty() ? nullptr : grid.occ;
+        return G.trajectories.get(i, occ, occ ? occ->version : 0u, geom, bounds,
+                                  G.balls.x[i] + spriteW * 0.5f, G.balls.y[i] + spriteH * 0.5f, G.balls.vx[i], G.balls.vy[i], maxBounces,
+                                  [occ](int c, int r) { return occ && occ->solid.test(r * brickgrid::kCols + c); });
+    }
+
+    // Named frame timers on the event wheel; starting a running timer restarts it
+    static void start_timer(State &G, TimerId id, int frames)
+    {
+        EventWheel::Handle &h = G.timers[(int)id];
+        G.wheel.cancel(h);
+        GameEvent ev{EventKind::Timer, (uint8_t)id, 0};
+        G.wheel.schedule(frames, ev, &h);
+    }
+    static void stop_timer(State &G, TimerId id) { G.wheel.cancel(G.timers[(int)id]); }
+    static bool timer_active(const State &G, TimerId id) { return G.wheel.scheduled(G.timers[(int)id]); }
+    // Frames until the timer lapses (0 when not running)
+    static int timer_left(const State &G, TimerId id) { return G.wheel.remaining(G.timers[(int)id]); }
+    // Pickup effects and the laser debounce, cancelled on level/game resets
+    static void stop_effect_timers(State &G)
+    {
+        stop_timer(G, TimerId::Reverse);
+        stop_timer(G, TimerId::LightsOff);
+        stop_timer(G, TimerId::FireCooldown);
+    }
+
+    // Record a side effect for drain_frame_events(); cosmetic events give way to gameplay ones,
+    // which are never lost: past the reserve (not expected, see kFrameEventsPerCell) they apply now
+    static void apply_frame_event(State &G, const FrameEvent &e); // fwd
+    static void emit_event(State &G, FrameEventKind kind, uint8_t id, int cell, real x, real y, real vx = 0.f, real vy = 0.f)
+    {
+        const FrameEvent e{kind, id, (int16_t)cell, x, y, vx, vy};
+        const bool cosmetic = kind == FrameEventKind::Sound || kind == FrameEventKind::Dust ||
+                              kind == FrameEventKind::BombScheduled;
+        if (cosmetic && G.frameEvents.size() >= kMaxFrameEvents - kFrameEventReserve)
+        {
+            ++G.droppedFrameEvents;
+            return;
+        }
+        if (!G.frameEvents.spawn(e))
+            apply_frame_event(G, e);
+    }
+    static void emit_sound(State &G, Sfx id) { emit_event(G, FrameEventKind::Sound, (uint8_t)id, -1, 0.f, 0.f); }
 
     // Forward declarations for Game Over sequence helpers
-    static void update_game_over();
-    static void finalize_game_over();
-    void begin_game_over();
+    static void update_game_over(State &G);
+    static void finalize_game_over(State &G);
+    void begin_game_over(State &G);
 
         // Simple dust effect: spawn a burst of particles at (x, y)
-        void spawn_dust_effect(float x, float y) {
-            for (int i = 0; i < 12; ++i) {
-                float angle = (float)i / 12.0f * 6.28318f;
-                float speed = 0.4f + 0.2f * (i % 3); // smaller spread, half brick size
-                uint32_t dustColor = C2D_Color32(245, 245, 245, 220); // nearly white, high opacity
-                float px = x;
-                float py = y;
-                Particle p{ px, py, std::cos(angle) * speed, std::sin(angle) * speed, 10, dustColor };
-                G.particles.push_back(p);
-            }
+        static void spawn_dust_effect(State &G, float x, float y) {
+            emit_event(G, FrameEventKind::Dust, 0, -1, (real)x, (real)y);
         }
-    bool exit_requested_internal() { return g_exitRequested; }
+    bool exit_requested_internal(State &G) { return G.exitRequested; }
+    // Sound goes to the one shared mixer, so headless worlds stay silent
+    static void play_named(State &G, const char *name, int channel)
+    {
+        if (!G.headless) sound::play_sfx(name, channel, 1.0f, true);
+    }
+    // Screen centre of a grid cell, for effects placed on a brick
+    static float brick_center_x(int c) { return (float)levels_left() + c * levels_brick_width() + levels_brick_width() * 0.5f; }
+    static float brick_center_y(int r) { return (float)levels_top() + r * levels_brick_height() + levels_brick_height() * 0.5f; }
 
     // Forward declare helpers defined later
-    static void set_bat_size(int mode);
-    static void reset_positions_for_new_level();
+    static void set_bat_size(State &G, int mode);
+    static void reset_positions_for_new_level(State &G);
 
-    void init_assets()
+    void init_assets(State &G)
     {
         G.imgBall = hw_image(IMAGE_ball_sprite_idx);
     G.imgMurderBall = hw_image(IMAGE_murderball_sprite_idx);
+    for (int m = 0; m < 2; ++m) {
+        const C2D_Image &img = m ? G.imgMurderBall : G.imgBall;
+        if (img.subtex) { G.ballSpriteW[m] = img.subtex->width; G.ballSpriteH[m] = img.subtex->height; }
+    }
+    G.balls.reserve(kBallReserve);
     G.imgBatNormal = hw_image(IMAGE_bat_normal_idx);
     G.imgBatSmall = hw_image(IMAGE_bat_small_idx);
     G.imgBatBig   = hw_image(IMAGE_bat_big_idx);
@@ -274,7 +468,7 @@ namespace game
     {
         int gapPx = options::hinge_gap_px();
         float ballStartX = kScreenWidth * 0.5f - kInitialBallHalf;
-        G.balls.push_back({ballStartX, kInitialBallY + gapPx, 0.0f, 0.f, ballStartX, kInitialBallY + gapPx, true, false, G.imgBall});
+        G.balls.add(ballStartX, kInitialBallY + gapPx, 0.0f, 0.f, false);
     }
     G.ballLocked = true;
         char buf[96];
@@ -282,8 +476,17 @@ namespace game
         hw_log(buf);
     }
 
+    // Fresh moving-brick state for the current layout; row caches rebuild on next update
+    static void reset_moving_bricks(State &G)
+    {
+        int total = levels_grid_width() * levels_grid_height();
+        G.moving.assign(total, {-1.f, 1.f, 0.f, 0.f, -1.f});
+        for (auto &row : G.movingRows)
+            row.owner = nullptr;
+    }
+
     // Reset bat and ball to the standard starting positions for a fresh level
-    static void reset_positions_for_new_level()
+    static void reset_positions_for_new_level(State &G)
     {
         // Center bat horizontally, reset vertical position
         float batCenterX = kScreenWidth * 0.5f;
@@ -294,12 +497,12 @@ namespace game
         G.balls.clear();
     float ballStartX = kScreenWidth * 0.5f + kPlayfieldOffsetX - kInitialBallHalf;
     int gapPx = options::hinge_gap_px();
-    G.balls.push_back({ballStartX, kInitialBallY + gapPx, 0.0f, 0.f, ballStartX, kInitialBallY + gapPx, true, false, G.imgBall});
+    G.balls.add(ballStartX, kInitialBallY + gapPx, 0.0f, 0.f, false);
         G.ballLocked = true;
     }
 
     // Begin the life-loss sequence (non-gameover): bat sinks, fade out/in, respawn with parked ball
-    static void begin_death_sequence()
+    static void begin_death_sequence(State &G)
     {
         // Decrement life and check for game over
         G.lives--;
@@ -311,28 +514,30 @@ namespace game
                 editor::on_return_from_test_full();
                 G.mode = Mode::Editor;
                 // Clear transient states
-                G.deathActive = false; G.deathFadeAlpha = 0; G.deathTimer = 0; G.deathPhase = 0; G.deathSinkVy = 0.f;
+                G.deathActive = false; G.deathFadeAlpha = 0; G.deathPhase = 0; G.deathSinkVy = 0.f;
+                stop_timer(G, TimerId::DeathPhase);
                 G.hazards.clear();
                 G.letters.clear();
                 return;
             }
             // Begin game-over sequence (fade and message with sound)
-            begin_game_over();
+            begin_game_over(G);
             return;
         }
         // Start non-gameover death sequence
         G.deathActive = true;
         G.deathPhase = 0;
-        G.deathTimer = 0;
+        stop_timer(G, TimerId::DeathPhase);
         G.deathSinkVy = 1.2f;
         // Freeze gameplay objects (deactivate balls so only bat is seen sinking)
-        for (auto &b : G.balls) b.active = false;
+        G.balls.deactivate_all();
         // Lose laser immediately on life loss
         G.laserEnabled = false;
         G.laserReady = false;
     }
 
-    static void update_death_sequence()
+    // Per-tick animation of the death sequence; phases 1 and 2 end on the DeathPhase timer
+    static void update_death_sequence(State &G)
     {
         if (!G.deathActive) return;
         switch (G.deathPhase)
@@ -343,94 +548,103 @@ namespace game
                     if (G.bat.y > 480.0f + (float)options::hinge_gap_px())
             {
                 G.deathPhase = 1;
-                G.deathTimer = 0;
                 G.deathFadeAlpha = 0;
+                start_timer(G, TimerId::DeathPhase, 21);
             }
             break;
         case 1: // fade out
             if (G.deathFadeAlpha < 200) G.deathFadeAlpha += 12; // 0.2s-ish
-            if (++G.deathTimer > 20)
-            {
-                // Respawn during black
-                // Reset bat position (keep current X clamped) and ball parked
-                if (G.bat.x < kPlayfieldLeftWallX) G.bat.x = kPlayfieldLeftWallX;
-                if (G.bat.x > kPlayfieldRightWallX - G.bat.width) G.bat.x = kPlayfieldRightWallX - G.bat.width;
-                G.bat.y = kInitialBatY + options::hinge_gap_px();
-                // Primary ball parked and relocked
-                if (G.balls.empty())
-                {
-                    float ballStartX = kScreenWidth * 0.5f + kPlayfieldOffsetX - kInitialBallHalf;
-                    G.balls.push_back({ballStartX, kInitialBallY, 0.0f, 0.f, ballStartX, kInitialBallY, true, false, G.imgBall});
-                }
-                Ball &b0 = G.balls[0];
-                b0.x = G.bat.x + G.bat.width * 0.5f - kBallW * 0.5f;
-                b0.y = G.bat.y - kBallH - 1;
-                b0.px = b0.x; b0.py = b0.y; b0.vx = 0.f; b0.vy = 0.f; b0.active = true;
-                // Clear any leftover hazards/pickups
-                G.hazards.clear();
-                G.letters.erase(std::remove_if(G.letters.begin(), G.letters.end(), [](const FallingLetter &f){ return !f.active; }), G.letters.end());
-                G.ballLocked = true;
-                G.deathPhase = 2;
-                G.deathTimer = 0;
-            }
             break;
         case 2: // fade in
             if (G.deathFadeAlpha > 0) G.deathFadeAlpha -= 10;
             if (G.deathFadeAlpha < 0) G.deathFadeAlpha = 0;
-            if (++G.deathTimer > 18 && G.deathFadeAlpha == 0)
+            break;
+        }
+    }
+
+    static void advance_death_phase(State &G)
+    {
+        if (!G.deathActive) return;
+        if (G.deathPhase == 1)
+        {
+            // Respawn during black
+            // Reset bat position (keep current X clamped) and ball parked
+            if (G.bat.x < kPlayfieldLeftWallX) G.bat.x = kPlayfieldLeftWallX;
+            if (G.bat.x > kPlayfieldRightWallX - G.bat.width) G.bat.x = kPlayfieldRightWallX - G.bat.width;
+            G.bat.y = kInitialBatY + options::hinge_gap_px();
+            // Primary ball parked and relocked
+            if (G.balls.empty())
             {
-                // Resume normal play
-                G.deathActive = false;
-                G.deathPhase = 0;
-                G.deathTimer = 0;
-                G.deathSinkVy = 0;
+                float ballStartX = kScreenWidth * 0.5f + kPlayfieldOffsetX - kInitialBallHalf;
+                G.balls.add(ballStartX, kInitialBallY, 0.0f, 0.f, false);
             }
-            break;
+            Ball b0 = ball_at(G, 0);
+            b0.x = G.bat.x + G.bat.width * 0.5f - kBallW * 0.5f;
+            b0.y = G.bat.y - kBallH - 1;
+            b0.px = b0.x; b0.py = b0.y; b0.vx = 0.f; b0.vy = 0.f; b0.activate();
+            // Clear any leftover hazards/pickups
+            G.hazards.clear();
+            G.ballLocked = true;
+            G.deathPhase = 2;
+            start_timer(G, TimerId::DeathPhase, 19);
+        }
+        else if (G.deathPhase == 2)
+        {
+            // Hold until the fade-in has finished
+            if (G.deathFadeAlpha > 0) { start_timer(G, TimerId::DeathPhase, (G.deathFadeAlpha + 9) / 10); return; }
+            // Resume normal play
+            G.deathActive = false;
+            G.deathPhase = 0;
+            G.deathSinkVy = 0;
         }
     }
 
     // Game Over sequence API
-    void begin_game_over()
+    void begin_game_over(State &G)
     {
         if (G.gameOverActive) return;
         hw_log("GAME OVER\n");
         G.gameOverActive = true;
         G.gameOverPhase = 0;
-        G.gameOverTimer = 0;
         G.gameOverAlpha = 0;
+        start_timer(G, TimerId::GameOverPhase, 61);
         // Stop gameplay interactions
-        for (auto &b : G.balls) b.active = false;
+        G.balls.deactivate_all();
         G.laserEnabled = false;
         G.laserReady = false;
         // Play the new game-over sound on a free channel (reserve 3)
-    sound::play_sfx("game-over", 3, 1.0f, true);
+    play_named(G, "game-over", 3);
     }
 
-    static void update_game_over()
+    static void update_game_over(State &G)
     {
         if (!G.gameOverActive) return;
         switch (G.gameOverPhase)
         {
         case 0: // fade in overlay to near-black and show message
             if (G.gameOverAlpha < 200) G.gameOverAlpha += 10; // ~0.33s
-            if (++G.gameOverTimer > 60) { // after fade-in, move to hold
-                G.gameOverPhase = 1;
-                G.gameOverTimer = 0;
-            }
             break;
         case 1: // hold
-            if (++G.gameOverTimer > 150) { // auto-finalize after ~2.5s
-                finalize_game_over();
-            }
             break;
         }
     }
 
-    static void finalize_game_over()
+    static void advance_game_over_phase(State &G)
+    {
+        if (!G.gameOverActive) return;
+        if (G.gameOverPhase == 0) { // after fade-in, move to hold
+            G.gameOverPhase = 1;
+            start_timer(G, TimerId::GameOverPhase, 151);
+        } else { // auto-finalize after ~2.5s
+            finalize_game_over(G);
+        }
+    }
+
+    static void finalize_game_over(State &G)
     {
         // Submit score and reset to title (similar to prior flow)
         int levelReached = levels_current() + 1;
-        int pos = highscores::submit(G.score, levelReached);
+        int pos = G.headless ? -1 : highscores::submit(G.score, levelReached);
         if (pos >= 0) {
 #ifdef PLATFORM_3DS
             {
@@ -453,52 +667,48 @@ namespace game
         {
             float ballStartX = kScreenWidth * 0.5f + kPlayfieldOffsetX - kInitialBallHalf;
             int gapPx = options::hinge_gap_px();
-            G.balls.push_back({ballStartX, kInitialBallY + gapPx, 0.0f, 0.f, ballStartX, kInitialBallY + gapPx, true, false, G.imgBall});
+            G.balls.add(ballStartX, kInitialBallY + gapPx, 0.0f, 0.f, false);
         }
         G.ballLocked = true;
         G.lives = 3; // reset lives after returning to title
-        set_bat_size(1); // reset bat to normal
+        set_bat_size(G, 1); // reset bat to normal
         G.score = 0;
         G.bonusBits = 0;
-        G.reverseTimer = G.lightsOffTimer = G.murderTimer = 0;
-        G.fireCooldown = 0;
+        G.murderTimer = 0;
+        stop_effect_timers(G);
+        G.frameEvents.clear();
+        G.trajectories.clear();
         G.letters.clear();
         G.hazards.clear();
         // Clear sequences
-        G.deathActive = false; G.deathFadeAlpha = 0; G.deathTimer = 0; G.deathPhase = 0; G.deathSinkVy = 0.f;
-        G.gameOverActive = false; G.gameOverAlpha = 0; G.gameOverPhase = 0; G.gameOverTimer = 0;
+        G.deathActive = false; G.deathFadeAlpha = 0; G.deathPhase = 0; G.deathSinkVy = 0.f;
+        stop_timer(G, TimerId::DeathPhase);
+        G.gameOverActive = false; G.gameOverAlpha = 0; G.gameOverPhase = 0;
+        stop_timer(G, TimerId::GameOverPhase);
         // Jump to High screen in title sequence if a new score was placed
         // Keep existing behavior: seqPos=1 is High
         // Note: begin_game_over() already logged; no extra log here
     }
 
     // Barrier helpers: single source of truth for when it draws and when it collides
-    static inline bool barrier_visible() {
+    static inline bool barrier_visible(const State &G) {
         // Visible for lives >= 1; hidden only at 0
         return G.lives > 0;
     }
-    static inline bool barrier_collides() {
+    static inline bool barrier_collides(State &G) {
         // Collides (consumes a life and rebounds) whenever lives > 0 and the ball is launched
         return G.lives > 0 && !G.ballLocked;
     }
     // (Removed color helpers; glow is always white now)
 
-    void init()
+    void init(State &G)
     {
         hw_log("game_init\n");
-        init_assets();
+        init_assets(G);
         levels_load();
-        // Initialize title buttons
-    // Title buttons sized for 320x240 bottom screen (w/h in pixels)
-    kTitleButtons[0].btn.x=60; kTitleButtons[0].btn.y=60;  kTitleButtons[0].btn.w=200; kTitleButtons[0].btn.h=24; kTitleButtons[0].btn.label="PLAY";    kTitleButtons[0].btn.color=C2D_Color32(50,50,70,255); kTitleButtons[0].next=Mode::Playing; kTitleButtons[0].isExit=false;
-    kTitleButtons[1].btn.x=60; kTitleButtons[1].btn.y=100; kTitleButtons[1].btn.w=200; kTitleButtons[1].btn.h=24; kTitleButtons[1].btn.label="EDITOR";  kTitleButtons[1].btn.color=C2D_Color32(50,50,70,255); kTitleButtons[1].next=Mode::Editor;  kTitleButtons[1].isExit=false;
-    kTitleButtons[2].btn.x=60; kTitleButtons[2].btn.y=140; kTitleButtons[2].btn.w=200; kTitleButtons[2].btn.h=24; kTitleButtons[2].btn.label="OPTIONS"; kTitleButtons[2].btn.color=C2D_Color32(50,50,70,255); kTitleButtons[2].next=Mode::Options; kTitleButtons[2].isExit=false;
-    // Exit button at the bottom
-    kTitleButtons[3].btn.x=60; kTitleButtons[3].btn.y=200; kTitleButtons[3].btn.w=200; kTitleButtons[3].btn.h=24; kTitleButtons[3].btn.label="EXIT";    kTitleButtons[3].btn.color=C2D_Color32(60,40,40,255); kTitleButtons[3].next=Mode::Title;   kTitleButtons[3].isExit=true;
         hw_log("assets loaded\n");
         // Initialize moving brick buffers
-        int total = levels_grid_width() * levels_grid_height();
-        G.moving.assign(total, {-1.f, 1.f, 0.f, 0.f});
+        reset_moving_bricks(G);
         highscores::init();
     }
 
@@ -514,68 +724,96 @@ namespace game
         {HwSheet::Title, TITLE_idx},
         {HwSheet::High, HIGH_idx},
         {HwSheet::Instruct, INSTRUCT_idx}};
-    static int seqPos = 0;
-    static int seqTimer = 0;                // frames
     static const int kSeqDelayFrames = 300; // ~5s at 60fps
 
-    static void spawn_extra_ball(float x, float y, float vx, float vy)
+    static void spawn_extra_ball(State &G, real x, real y, real vx, real vy)
     {
         // Nudge spawn position slightly perpendicular to velocity to avoid perfect overlap
-        float nx = x, ny = y;
-        float spd = std::sqrt(vx * vx + vy * vy);
+        real nx = x, ny = y;
+        real inv;
+        real spd = sim::length(vx, vy, &inv);
         if (spd > 1e-3f) {
-            float ox = -vy / spd; // perpendicular unit vector
-            float oy =  vx / spd;
+            real ox = -vy * inv; // perpendicular unit vector
+            real oy =  vx * inv;
             nx += ox; ny += oy; // 1px nudge
         } else {
             nx += 1.0f; // fallback nudge
         }
-        G.spawnQueue.push_back({nx, ny, vx, vy, false});
+        G.spawnQueue.spawn({nx, ny, vx, vy, false});
     }
 
-    static void spawn_murder_ball(float x, float y, float vx, float vy)
+    static void spawn_murder_ball(State &G, real x, real y, real vx, real vy)
     {
         // Same nudge so murder ball also separates visually on spawn
-        float nx = x, ny = y;
-        float spd = std::sqrt(vx * vx + vy * vy);
+        real nx = x, ny = y;
+        real inv;
+        real spd = sim::length(vx, vy, &inv);
         if (spd > 1e-3f) {
-            float ox = -vy / spd;
-            float oy =  vx / spd;
+            real ox = -vy * inv;
+            real oy =  vx * inv;
             nx += ox; ny += oy;
         } else {
             nx += 1.0f;
         }
-        G.spawnQueue.push_back({nx, ny, vx, vy, true});
+        G.spawnQueue.spawn({nx, ny, vx, vy, true});
     }
 
+#if defined(DEBUG) && DEBUG
+    // Debug stress test: queue kStressBalls regular balls fanned upward from the bat
+    static void spawn_ball_stress(State &G)
+    {
+        real cx = G.bat.x + G.bat.width * 0.5f - kBallW * 0.5f;
+        real cy = G.bat.y - kBallH - 8;
+        for (int i = 0; i < kStressBalls; ++i) {
+            real ang = -(0.35f + 2.44f * (real)i / (real)kStressBalls); // upper half-plane, no flat shots
+            G.spawnQueue.spawn({cx, cy, sim::cos(ang) * 2.0f, sim::sin(ang) * 2.0f, false});
+        }
+        char buf[64]; snprintf(buf, sizeof buf, "STRESS: +%d balls\n", kStressBalls); hw_log(buf);
+    }
+
+    // Device-side frame cost of the ball update, logged every 120 ticks while many balls are live
+    static void note_ball_cost(State &G, uint64_t ticks)
+    {
+        static uint64_t sum = 0;
+        static int frames = 0;
+        sum += ticks;
+        if (++frames < 120) return;
+        if (G.balls.size() >= 64) {
+            double us = (double)sum / frames * 1e6 / (double)hw_ticks_per_second();
+            char buf[80]; snprintf(buf, sizeof buf, "BALLS n=%d update=%.1fus\n", balls::count(G.balls).active, us); hw_log(buf);
+        }
+        sum = 0; frames = 0;
+    }
+#endif
+
     // Choose an alternate diagonal for a split ball. Guarantees both components non-zero.
-    static void choose_split_velocity(const Ball &src, float &outVx, float &outVy)
+    static void choose_split_velocity(real vx, real vy, real &outVx, real &outVy)
     {
         // Preserve overall speed magnitude
-        float spd = std::sqrt(src.vx * src.vx + src.vy * src.vy);
+        real spd = sim::length(vx, vy);
         if (spd < 0.01f) spd = 1.5f; // fallback
         // If already diagonal, flip the vertical component to choose a different diagonal
-        if (std::fabs(src.vx) > 0.01f && std::fabs(src.vy) > 0.01f)
+        if (sim::fabs(vx) > 0.01f && sim::fabs(vy) > 0.01f)
         {
-            outVx = src.vx;
-            outVy = -src.vy;
+            outVx = vx;
+            outVy = -vy;
             return;
         }
         // If moving purely horizontal or vertical, pick a diagonal based on current signs
-        int sx = (src.vx >= 0.0f) ? 1 : -1;
-        int sy = (src.vy >= 0.0f) ? 1 : -1;
-        if (std::fabs(src.vx) <= 0.01f && std::fabs(src.vy) > 0.01f)
+        int sx = (vx >= 0.0f) ? 1 : -1;
+        int sy = (vy >= 0.0f) ? 1 : -1;
+        if (sim::fabs(vx) <= 0.01f && sim::fabs(vy) > 0.01f)
         {
             // Vertical -> choose left or right keeping opposite vertical direction
-            float comp = spd * 0.7071f;
+            real comp = spd * 0.7071f;
             outVx = (sx == 0 ? 1 : sx) * comp; // default to right if 0
             outVy = -sy * comp;
             return;
         }
-        if (std::fabs(src.vy) <= 0.01f && std::fabs(src.vx) > 0.01f)
+        if (sim::fabs(vy) <= 0.01f && sim::fabs(vx) > 0.01f)
         {
             // Horizontal -> choose up or down keeping horizontal direction
-            float comp = spd * 0.7071f;
+            real comp = spd * 0.7071f;
             outVx = sx * comp;
             outVy = -1 * comp; // prefer upward split
             return;
@@ -585,7 +823,7 @@ namespace game
         outVy = -spd * 0.7071f;
     }
 
-    static void spawn_bonus_letter(int letter, float cx, float cy)
+    static void spawn_bonus_letter(State &G, int letter, real cx, real cy)
     {
         if (letter < 0 || letter > 4)
             return;
@@ -600,21 +838,21 @@ namespace game
         case 4: atlasIdx = IMAGE_s_brick_idx; break;
         }
         C2D_Image img = hw_image(atlasIdx);
-        float w = (img.subtex ? img.subtex->width : 10.0f);
-        float h = (img.subtex ? img.subtex->height : 11.0f);
-        FallingLetter fl{cx - w * 0.5f, cy - h * 0.5f, 0.6f, letter, true, img};
-        G.letters.push_back(fl);
+        real w = (img.subtex ? img.subtex->width : 10.0f);
+        real h = (img.subtex ? img.subtex->height : 11.0f);
+        FallingLetter fl{cx - w * 0.5f, cy - h * 0.5f, 0.6f, w, h, letter, (int16_t)atlasIdx};
+        G.letters.spawn(fl);
     }
 
-    static void spawn_laser_pickup(float cx, float cy)
+    static void spawn_laser_pickup(State &G, real cx, real cy)
     {
         // Use the laser brick visual for the falling pickup
         C2D_Image img = hw_image(IMAGE_laser_brick_idx);
-        float w = (img.subtex ? img.subtex->width : 16.0f);
-        float h = (img.subtex ? img.subtex->height : 9.0f);
+        real w = (img.subtex ? img.subtex->width : 16.0f);
+        real h = (img.subtex ? img.subtex->height : 9.0f);
         // Reuse FallingLetter with code 200 for laser pickup
-        FallingLetter fl{cx - w * 0.5f, cy - h * 0.5f, 0.6f, 200, true, img};
-        G.letters.push_back(fl);
+        FallingLetter fl{cx - w * 0.5f, cy - h * 0.5f, 0.6f, w, h, 200, (int16_t)IMAGE_laser_brick_idx};
+        G.letters.spawn(fl);
     }
 
     // Effect pickup codes (avoid clashes with 0..4, 100/101, 200 used elsewhere)
@@ -630,69 +868,69 @@ namespace game
         PK_LIGHTS_ON = 308,
     };
 
-    static void spawn_effect_pickup(int effectCode, int atlasIdx, float cx, float cy)
+    static void spawn_effect_pickup(State &G, int effectCode, int atlasIdx, real cx, real cy)
     {
         C2D_Image img = hw_image(atlasIdx);
-        float w = (img.subtex ? img.subtex->width : 16.0f);
-        float h = (img.subtex ? img.subtex->height : 9.0f);
-        FallingLetter fl{cx - w * 0.5f, cy - h * 0.5f, 0.6f, effectCode, true, img};
-        G.letters.push_back(fl);
+        real w = (img.subtex ? img.subtex->width : 16.0f);
+        real h = (img.subtex ? img.subtex->height : 9.0f);
+        FallingLetter fl{cx - w * 0.5f, cy - h * 0.5f, 0.6f, w, h, effectCode, (int16_t)atlasIdx};
+        G.letters.spawn(fl);
     }
 
-    static void spawn_destroy_bat_brick(BrickType bt, float cx, float cy)
+    static void spawn_destroy_bat_brick(State &G, BrickType bt, real cx, real cy)
     {
         // Use skull brick visual for both F1/F2 for now
         C2D_Image img = hw_image(IMAGE_skull_brick_idx);
-        float w = (img.subtex ? img.subtex->width : 16.0f);
-        float h = (img.subtex ? img.subtex->height : 9.0f);
+        real w = (img.subtex ? img.subtex->width : 16.0f);
+        real h = (img.subtex ? img.subtex->height : 9.0f);
         int t = (bt == BrickType::F2) ? 2 : 1; // 1=F1(slow) 2=F2(fast)
         // Ensure F2 starts at exactly 2x the initial speed of F1
-        const float baseInitVy = 0.6f; // F1
-        float initVy = baseInitVy * (t == 2 ? 2.0f : 1.0f);
-        G.hazards.push_back(FallingHazard{cx - w * 0.5f, cy - h * 0.5f, initVy, t, true, img});
+        const real baseInitVy = 0.6f; // F1
+        real initVy = baseInitVy * (t == 2 ? 2.0f : 1.0f);
+        G.hazards.spawn(FallingHazard{cx - w * 0.5f, cy - h * 0.5f, initVy, w, h, t, (int16_t)IMAGE_skull_brick_idx});
     }
 
-    static void spawn_bat_pickup(bool makeBig, float cx, float cy)
+    static void spawn_bat_pickup(State &G, bool makeBig, real cx, real cy)
     {
         // Spawn a falling pickup using the batsmall/batbig brick visuals
         int atlasIdx = makeBig ? IMAGE_batbig_brick_idx : IMAGE_batsmall_brick_idx;
         C2D_Image img = hw_image(atlasIdx);
-        float w = (img.subtex ? img.subtex->width : 16.0f);
-        float h = (img.subtex ? img.subtex->height : 9.0f);
+        real w = (img.subtex ? img.subtex->width : 16.0f);
+        real h = (img.subtex ? img.subtex->height : 9.0f);
         // Reuse FallingLetter with sentinel letter values: 100=small, 101=big
         int code = makeBig ? 101 : 100;
-        FallingLetter fl{cx - w * 0.5f, cy - h * 0.5f, 0.6f, code, true, img};
-        G.letters.push_back(fl);
+        FallingLetter fl{cx - w * 0.5f, cy - h * 0.5f, 0.6f, w, h, code, (int16_t)atlasIdx};
+        G.letters.spawn(fl);
     }
 
-    static void set_bat_size(int mode)
+    static void set_bat_size(State &G, int mode)
     {
     if (mode < 0) mode = 0;
     if (mode > 2) mode = 2;
         if (G.batSizeMode == mode) return;
         G.batSizeMode = mode;
         // Preserve center X while changing sprite and width
-        float centerX = G.bat.x + G.bat.width * 0.5f;
+        real centerX = G.bat.x + G.bat.width * 0.5f;
         if (mode == 0)
         {
             G.bat.img = G.imgBatSmall;
-            float newW = (G.bat.img.subtex ? G.bat.img.subtex->width : G.bat.width);
+            real newW = (G.bat.img.subtex ? G.bat.img.subtex->width : G.bat.width);
             G.bat.width = newW;
-                G.batCollWidth = std::max(8.0f, newW);
+                G.batCollWidth = sim::max(8.0f, newW);
         }
         else if (mode == 2)
         {
             G.bat.img = G.imgBatBig;
-            float newW = (G.bat.img.subtex ? G.bat.img.subtex->width : G.bat.width);
+            real newW = (G.bat.img.subtex ? G.bat.img.subtex->width : G.bat.width);
             G.bat.width = newW;
-                G.batCollWidth = std::max(8.0f, newW);
+                G.batCollWidth = sim::max(8.0f, newW);
         }
         else
         {
             G.bat.img = G.imgBatNormal;
-            float newW = (G.bat.img.subtex ? G.bat.img.subtex->width : G.bat.width);
+            real newW = (G.bat.img.subtex ? G.bat.img.subtex->width : G.bat.width);
             G.bat.width = newW;
-                G.batCollWidth = std::max(8.0f, newW);
+                G.batCollWidth = sim::max(8.0f, newW);
         }
         // Height from sprite
         G.bat.height = (G.bat.img.subtex ? G.bat.img.subtex->height : G.bat.height);
@@ -701,170 +939,218 @@ namespace game
         if (G.bat.x > kPlayfieldRightWallX - G.bat.width) G.bat.x = kPlayfieldRightWallX - G.bat.width;
     }
 
-    static void apply_brick_effect(BrickType bt, float cx, float cy, Ball &ball)
+    static_assert(PK_LIFE + (int)BrickPickup::LightsOn - 1 == PK_LIGHTS_ON, "BrickPickup order must follow PK_* codes");
+
+    // Score and hit effect of a brick, applied from the frame event queue. (vx,vy) is the
+    // hitting ball's velocity at the time of the hit; slow/fast were applied by emit_brick_effect.
+    static void apply_brick_effect(State &G, BrickType bt, real cx, real cy, real vx, real vy)
     {
-        switch (bt)
+        const BrickTraits &tr = brick_traits(bt);
+        G.score += tr.score; // per-hit score (bombs: base score before chain)
+        switch (tr.effect)
         {
-        case BrickType::YB:
-            G.score += 10;
-            break;
-        case BrickType::GB:
-            G.score += 20;
+        case BrickEffect::Pickup:
+            spawn_effect_pickup(G, PK_LIFE + tr.param - 1, levels_atlas_index((int)bt), cx, cy);
             break;
-        case BrickType::CB:
-            G.score += 30;
-            break;
-        case BrickType::TB:
-            G.score += 40;
+        case BrickEffect::ExtraBall:
+        {
+            real svx, svy; choose_split_velocity(vx, vy, svx, svy);
+            // Spawn a standard extra ball; original continues without additional reflection handling
+            spawn_extra_ball(G, cx, cy, svx, svy);
+        }
             break;
-        case BrickType::PB:
-            G.score += 50;
+        case BrickEffect::MurderBall:
+        {
+            real svx, svy; choose_split_velocity(vx, vy, svx, svy);
+            // Spawn a murder ball variant while original continues on its path
+            spawn_murder_ball(G, cx, cy, svx, svy);
+        }
             break;
-        case BrickType::RB:
-            G.score += 100;
+        case BrickEffect::Laser:
+            spawn_laser_pickup(G, cx, cy);
             break;
-        case BrickType::LB:
-            spawn_effect_pickup(PK_LIFE, IMAGE_life_brick_idx, cx, cy);
+        case BrickEffect::BatSize:
+            spawn_bat_pickup(G, tr.param != 0, cx, cy);
             break;
-        case BrickType::SB:
-            spawn_effect_pickup(PK_SLOW, IMAGE_slow_brick_idx, cx, cy);
+        case BrickEffect::BonusLetter:
+            spawn_bonus_letter(G, tr.param, cx, cy);
             break;
-        case BrickType::FB:
-            spawn_effect_pickup(PK_FAST, IMAGE_fast_brick_idx, cx, cy);
+        case BrickEffect::SlowBall:
+        case BrickEffect::FastBall:
+        case BrickEffect::None:
             break;
-        case BrickType::AB:
-        {
-            float svx, svy; choose_split_velocity(ball, svx, svy);
-            // Spawn a standard extra ball; original continues without additional reflection handling
-            spawn_extra_ball(cx, cy, svx, svy);
         }
-            break;
-        case BrickType::T5:
-            G.score += 60;
-            break; // per-hit score (placeholder)
-        case BrickType::BO:
-            G.score += 120;
-            break; // base bomb score before chain
-        case BrickType::RW:
-            spawn_effect_pickup(PK_REWIND, IMAGE_rewind_brick_idx, cx, cy);
-            break;
-        case BrickType::FO:
-            spawn_effect_pickup(PK_FORWARD, IMAGE_forward_brick_idx, cx, cy);
-            break;
-        case BrickType::RE:
-            spawn_effect_pickup(PK_REVERSE, IMAGE_reverse_brick_idx, cx, cy);
-            break; // ~10s pickup
-        case BrickType::IS:
+    // Bonus completion and scoring handled on collection, not at hit time
+    }
+
+    // Brick hit by `ball` (or a laser / blast, passed the primary ball): slow/fast bricks change
+    // the ball at once since the rest of this tick's motion depends on it; the rest is queued.
+    static void emit_brick_effect(State &G, BrickType bt, real cx, real cy, Ball ball)
+    {
+        const BrickTraits &tr = brick_traits(bt);
+        const BrickEffect effect = tr.effect;
+        if (effect == BrickEffect::SlowBall) {
             // Immediate slow; pass-through handled in collision code (no bounce)
             ball.vx *= (1.0f - layout::SPEED_MODIFIER);
             ball.vy *= (1.0f - layout::SPEED_MODIFIER);
-            break;
-        case BrickType::IF:
-            // Immediate fast; pass-through handled in collision code (no bounce)
+        } else if (effect == BrickEffect::FastBall) {
             ball.vx *= (1.0f + layout::SPEED_MODIFIER);
             ball.vy *= (1.0f + layout::SPEED_MODIFIER);
-            break;
-        case BrickType::LA:
-            spawn_laser_pickup(cx, cy);
-            break;
-        case BrickType::MB:
-        {
-            float svx, svy; choose_split_velocity(ball, svx, svy);
-            // Spawn a murder ball variant while original continues on its path
-            spawn_murder_ball(cx, cy, svx, svy);
         }
+        // Nothing left to apply later for bricks without score or a queued effect (ID, F1, ...)
+        if (tr.score == 0 && (effect == BrickEffect::None || effect == BrickEffect::SlowBall || effect == BrickEffect::FastBall))
+            return;
+        emit_event(G, FrameEventKind::BrickEffect, (uint8_t)bt, -1, cx, cy, ball.vx, ball.vy);
+    }
+    static void emit_bat_hazard(State &G, BrickType bt, real cx, real cy) { emit_event(G, FrameEventKind::BatHazard, (uint8_t)bt, -1, cx, cy); }
+    // Bomb at (c,r) exploded, centred on (cx,cy)
+    static void emit_explosion(State &G, int c, int r, real cx, real cy)
+    {
+        emit_event(G, FrameEventKind::Explosion, 0, r * brickgrid::kCols + c, cx, cy);
+    }
+
+    struct SfxDef
+    {
+        const char *name;
+        int8_t channel;
+        int8_t fallback;  // channel to retry on when `channel` is busy (-1 = none)
+        int8_t stopFirst; // channel to silence before playing (-1 = none)
+    };
+    static const SfxDef kSfxDefs[] = {
+        {"ball-brick", 1, -1, -1},
+        {"hit-hard", 1, -1, -1},
+        {"hard-explode", 6, -1, 1}, // final multi-hit: cut the pending hit sound
+        {"ball-bat", 0, -1, -1},
+        {"barrier-hit", 2, -1, -1}, // channel 2 reserved for barrier events
+        {"explosion", 6, 7, -1},
+    };
+    static_assert(sizeof(kSfxDefs) / sizeof(kSfxDefs[0]) == (size_t)Sfx::Count, "kSfxDefs needs one row per Sfx");
+    static_assert((int)Sfx::BallBrick == (int)BrickSfx::Normal && (int)Sfx::HitHard == (int)BrickSfx::Hard,
+                  "BrickSfx values index kSfxDefs directly");
+
+    static void play_sfx(State &G, Sfx id)
+    {
+        if (G.headless) return;
+        const SfxDef &d = kSfxDefs[(int)id];
+        if (d.stopFirst >= 0)
+            sound::stop_sfx_channel(d.stopFirst);
+        if (!sound::play_sfx(d.name, d.channel, 1.0f, true) && d.fallback >= 0) {
+            sound::stop_sfx_channel(d.channel);
+            sound::play_sfx(d.name, d.fallback, 1.0f, true);
+        }
+    }
+
+    // Apply one recorded side effect (see FrameEventKind)
+    static void apply_frame_event(State &G, const FrameEvent &e)
+    {
+        switch (e.kind)
+        {
+        case FrameEventKind::BrickEffect:
+            apply_brick_effect(G, (BrickType)e.id, e.x, e.y, e.vx, e.vy);
             break;
-        case BrickType::OF:
-            spawn_effect_pickup(PK_LIGHTS_OFF, IMAGE_offswitch_brick_idx, cx, cy);
+        case FrameEventKind::BatHazard:
+            spawn_destroy_bat_brick(G, (BrickType)e.id, e.x, e.y);
             break;
-        case BrickType::ON:
-            spawn_effect_pickup(PK_LIGHTS_ON, IMAGE_onswitch_brick_idx, cx, cy);
+        case FrameEventKind::Sound:
+            play_sfx(G, (Sfx)e.id);
             break;
-        case BrickType::BA:
-            spawn_effect_pickup(PK_BONUS1000, IMAGE_bonus_brick_idx, cx, cy);
+        case FrameEventKind::Explosion:
+        {
+#if defined(DEBUG) && DEBUG
+            char dbg[64]; snprintf(dbg, sizeof dbg, "EXPLODE (%d,%d)\n", e.cell % brickgrid::kCols, e.cell / brickgrid::kCols); hw_log(dbg);
+#endif
+            // Explosion SFX at the start of the particle effect (with fallback channel)
+            play_sfx(G, Sfx::Explosion);
+            G.particles.burst(e.x, e.y, 8, 0.6f, 0.4f, 4, 32, C2D_Color32(255, 200, 50, 255));
+        }
             break;
-        case BrickType::BS:
-            spawn_bat_pickup(false, cx, cy);
+        case FrameEventKind::Dust:
+            // 12 particles, speeds 0.4..0.8: smaller spread, half brick size; nearly white
+            G.particles.burst(e.x, e.y, 12, 0.4f, 0.2f, 3, 10, C2D_Color32(245, 245, 245, 220));
             break;
-        case BrickType::BB:
-            spawn_bat_pickup(true, cx, cy);
+        case FrameEventKind::BombScheduled:
+#if defined(DEBUG) && DEBUG
+        {
+            char dbg[64]; snprintf(dbg, sizeof dbg, "SCHED BOMB (%d,%d) delay=%d\n", e.cell % brickgrid::kCols, e.cell / brickgrid::kCols, e.id); hw_log(dbg);
+        }
+#endif
             break;
-    case BrickType::B1: spawn_bonus_letter(0, cx, cy); break;
-    case BrickType::B2: spawn_bonus_letter(1, cx, cy); break;
-    case BrickType::B3: spawn_bonus_letter(2, cx, cy); break;
-    case BrickType::B4: spawn_bonus_letter(3, cx, cy); break;
-    case BrickType::B5: spawn_bonus_letter(4, cx, cy); break;
-        default:
-            break; // others TBD
         }
-    // Bonus completion and scoring handled on collection, not at hit time
+    }
+    // Apply this tick's queued side effects in emission order. Handlers never emit, so the
+    // queue is not modified while it is walked.
+    static void drain_frame_events(State &G)
+    {
+        for (const FrameEvent &e : G.frameEvents)
+            apply_frame_event(G, e);
+        G.frameEvents.clear();
     }
 
-    static void update_bonus_letters()
+    static void update_bonus_letters(State &G)
     {
         if (G.letters.empty()) return;
     // Compute effective bat collision rectangle (centered logical size)
-    float effBatW = G.batCollWidth;
-        float effBatH = (G.bat.img.subtex ? G.bat.img.subtex->height : G.bat.height);
-        float atlasLeft = (G.bat.img.subtex ? G.bat.img.subtex->left : 0.0f);
-        float batPadX = (G.bat.width - effBatW) * 0.5f;
+    real effBatW = G.batCollWidth;
+        real effBatH = (G.bat.img.subtex ? G.bat.img.subtex->height : G.bat.height);
+        real atlasLeft = (G.bat.img.subtex ? G.bat.img.subtex->left : 0.0f);
+        real batPadX = (G.bat.width - effBatW) * 0.5f;
         if (batPadX < 0) batPadX = 0;
-        float batPadY = (G.bat.height - effBatH) * 0.5f;
+        real batPadY = (G.bat.height - effBatH) * 0.5f;
         if (batPadY < 0) batPadY = 0;
-        float batLeft = G.bat.x + batPadX - atlasLeft;
-        float batTop = G.bat.y + batPadY;
-        float batRight = batLeft + effBatW;
-        float batBottom = batTop + effBatH;
-        for (auto &L : G.letters)
+        real batLeft = G.bat.x + batPadX - atlasLeft;
+        real batTop = G.bat.y + batPadY;
+        real batRight = batLeft + effBatW;
+        real batBottom = batTop + effBatH;
+        for (int li = 0; li < G.letters.size();)
         {
-            if (!L.active) continue;
+            FallingLetter &L = G.letters[li];
             L.y += L.vy;
             L.vy += 0.05f; // gravity
-            if (L.y > 480.0f + (float)options::hinge_gap_px()) { L.active = false; continue; }
-            float lw = (L.img.subtex ? L.img.subtex->width : 10.0f);
-            float lh = (L.img.subtex ? L.img.subtex->height : 11.0f);
-            float lLeft = L.x, lTop = L.y, lRight = L.x + lw, lBottom = L.y + lh;
+            if (L.y > 480.0f + (float)options::hinge_gap_px()) { G.letters.remove_at(li); continue; }
+            real lw = L.w;
+            real lh = L.h;
+            real lLeft = L.x, lTop = L.y, lRight = L.x + lw, lBottom = L.y + lh;
             bool overlap = !(lRight <= batLeft || lLeft >= batRight || lBottom <= batTop || lTop >= batBottom);
             if (overlap)
             {
                 // Collect this letter
                 switch (L.letter)
                 {
-                case 0: G.score += 100; G.bonusBits |= 0x01; sound::play_sfx("bonus-step", 5, 1.0f, true); break; // B
-                case 1: G.score += 100; G.bonusBits |= 0x02; sound::play_sfx("bonus-step", 5, 1.0f, true); break; // O
-                case 2: G.score += 100; G.bonusBits |= 0x04; sound::play_sfx("bonus-step", 5, 1.0f, true); break; // N
-                case 3: G.score += 100; G.bonusBits |= 0x08; sound::play_sfx("bonus-step", 5, 1.0f, true); break; // U
-                case 4: G.score += 100; G.bonusBits |= 0x10; sound::play_sfx("bonus-step", 5, 1.0f, true); break; // S
+                case 0: G.score += 100; G.bonusBits |= 0x01; play_named(G, "bonus-step", 5); break; // B
+                case 1: G.score += 100; G.bonusBits |= 0x02; play_named(G, "bonus-step", 5); break; // O
+                case 2: G.score += 100; G.bonusBits |= 0x04; play_named(G, "bonus-step", 5); break; // N
+                case 3: G.score += 100; G.bonusBits |= 0x08; play_named(G, "bonus-step", 5); break; // U
+                case 4: G.score += 100; G.bonusBits |= 0x10; play_named(G, "bonus-step", 5); break; // S
                 case 100: // Bat smaller
-                    set_bat_size(G.batSizeMode - 1);
+                    set_bat_size(G, G.batSizeMode - 1);
                     // Bad pickup
-                    sound::play_sfx("bad", 5, 1.0f, true);
+                    play_named(G, "bad", 5);
                     break;
                 case 101: // Bat bigger
-                    set_bat_size(G.batSizeMode + 1);
+                    set_bat_size(G, G.batSizeMode + 1);
                     // Good pickup
-                    sound::play_sfx("good", 5, 1.0f, true);
+                    play_named(G, "good", 5);
                     break;
                 case 200: // Laser pickup
                     G.laserEnabled = true;
                     G.laserReady = true;
                     // Good pickup
-                    sound::play_sfx("good", 5, 1.0f, true);
+                    play_named(G, "good", 5);
                     break;
                 case PK_LIFE:
                     if (G.lives < 99) G.lives++;
                     // Good pickup
-                    sound::play_sfx("extra-life", 5, 1.0f, true);
+                    play_named(G, "extra-life", 5);
                     break;
                 case PK_SLOW:
-                    for (auto &b : G.balls) { b.vx *= (1.0f - layout::SPEED_MODIFIER); b.vy *= (1.0f - layout::SPEED_MODIFIER); }
+                    for (int i = 0; i < G.balls.size(); ++i) { G.balls.vx[i] *= (1.0f - layout::SPEED_MODIFIER); G.balls.vy[i] *= (1.0f - layout::SPEED_MODIFIER); }
                     // Good pickup
-                    sound::play_sfx("good", 5, 1.0f, true);
+                    play_named(G, "good", 5);
                     break;
                 case PK_FAST:
-                    for (auto &b : G.balls) { b.vx *= (1.0f + layout::SPEED_MODIFIER); b.vy *= (1.0f + layout::SPEED_MODIFIER); }
+                    for (int i = 0; i < G.balls.size(); ++i) { G.balls.vx[i] *= (1.0f + layout::SPEED_MODIFIER); G.balls.vy[i] *= (1.0f + layout::SPEED_MODIFIER); }
                     // Bad pickup
-                    sound::play_sfx("bad", 5, 1.0f, true);
+                    play_named(G, "bad", 5);
                     break;
                 case PK_REWIND:
                 {
@@ -878,38 +1164,38 @@ namespace game
                     if (levels_count() > 0) { cur = (cur + 1) % levels_count(); levels_set_current(cur); }
                 }
                     // Good pickup
-                    sound::play_sfx("good", 5, 1.0f, true);
+                    play_named(G, "good", 5);
                     break;
                 case PK_REVERSE:
-                    if (G.reverseTimer > 0) {
+                    if (timer_active(G, TimerId::Reverse)) {
                         // Reverse already active: picking another toggles back to normal (cancel effect)
-                        G.reverseTimer = 0; // stop effect and hide indicator
+                        stop_timer(G, TimerId::Reverse); // stop effect and hide indicator
                         // Good outcome (controls back to normal)
-                        sound::play_sfx("good", 5, 1.0f, true);
+                        play_named(G, "good", 5);
                     } else {
                         // Not active: start reverse effect
-                        G.reverseTimer = 600; // ~10s
+                        start_timer(G, TimerId::Reverse, 600); // ~10s
                         // Bad pickup (controls become reversed)
-                        sound::play_sfx("bad", 5, 1.0f, true);
+                        play_named(G, "bad", 5);
                     }
                     break;
                 case PK_BONUS1000:
                     G.score += 1000;
                     // Good pickup
-                    sound::play_sfx("good", 5, 1.0f, true);
+                    play_named(G, "good", 5);
                     break;
                 case PK_LIGHTS_OFF:
-                    G.lightsOffTimer = 600;
+                    start_timer(G, TimerId::LightsOff, 600);
                     // Bad pickup
-                    sound::play_sfx("bad", 5, 1.0f, true);
+                    play_named(G, "bad", 5);
                     break;
                 case PK_LIGHTS_ON:
-                    G.lightsOffTimer = 0;
+                    stop_timer(G, TimerId::LightsOff);
                     // Good pickup
-                    sound::play_sfx("good", 5, 1.0f, true);
+                    play_named(G, "good", 5);
                     break;
                 }
-                L.active = false;
+                G.letters.remove_at(li); // L now refers to the next unvisited letter
                 // If all five collected, award 250 * level number and reset
                 if (G.bonusBits == 0x1F)
                 {
@@ -917,332 +1203,225 @@ namespace game
                     int levelNumber = lvl + 1; // levels are 1-based for scoring
                     G.score += 250 * levelNumber;
                     G.bonusBits = 0;
-                    sound::play_sfx("all-bonus", 5, 1.0f, true);
+                    play_named(G, "all-bonus", 5);
                     hw_log("BONUS COMPLETE (award)\n");
                 }
+                continue;
             }
-        }
-        // Compact inactive periodically
-        if (G.letters.size() > 32)
-        {
-            G.letters.erase(std::remove_if(G.letters.begin(), G.letters.end(), [](const FallingLetter &f){ return !f.active; }), G.letters.end());
+            ++li;
         }
     }
 
-    static void update_falling_hazards()
+    static void update_falling_hazards(State &G)
     {
         if (G.hazards.empty()) return;
     // Compute effective bat collision rectangle (same logic as pickups)
-    float effBatW = G.batCollWidth;
-        float effBatH = (G.bat.img.subtex ? G.bat.img.subtex->height : G.bat.height);
-        float atlasLeft = (G.bat.img.subtex ? G.bat.img.subtex->left : 0.0f);
-        float batPadX = (G.bat.width - effBatW) * 0.5f; if (batPadX < 0) batPadX = 0;
-        float batPadY = (G.bat.height - effBatH) * 0.5f; if (batPadY < 0) batPadY = 0;
-        float batLeft = G.bat.x + batPadX - atlasLeft;
-        float batTop = G.bat.y + batPadY;
-        float batRight = batLeft + effBatW;
-        float batBottom = batTop + effBatH;
-        for (auto &H : G.hazards)
+    real effBatW = G.batCollWidth;
+        real effBatH = (G.bat.img.subtex ? G.bat.img.subtex->height : G.bat.height);
+        real atlasLeft = (G.bat.img.subtex ? G.bat.img.subtex->left : 0.0f);
+        real batPadX = (G.bat.width - effBatW) * 0.5f; if (batPadX < 0) batPadX = 0;
+        real batPadY = (G.bat.height - effBatH) * 0.5f; if (batPadY < 0) batPadY = 0;
+        real batLeft = G.bat.x + batPadX - atlasLeft;
+        real batTop = G.bat.y + batPadY;
+        real batRight = batLeft + effBatW;
+        real batBottom = batTop + effBatH;
+        for (int hi = 0; hi < G.hazards.size();)
         {
-            if (!H.active) continue;
+            FallingHazard &H = G.hazards[hi];
             H.y += H.vy;
             // Apply gravity; F2 accelerates at 2x so it maintains ~2x speed profile
-            const float baseGrav = 0.025f; // F1 gravity per frame
+            const real baseGrav = 0.025f; // F1 gravity per frame
             H.vy += baseGrav * (H.type == 2 ? 2.0f : 1.0f);
-            if (H.y > 480.0f + (float)options::hinge_gap_px()) { H.active = false; continue; }
-            float hw = (H.img.subtex ? H.img.subtex->width : 16.0f);
-            float hh = (H.img.subtex ? H.img.subtex->height : 9.0f);
-            float hLeft = H.x, hTop = H.y, hRight = H.x + hw, hBottom = H.y + hh;
+            if (H.y > 480.0f + (float)options::hinge_gap_px()) { G.hazards.remove_at(hi); continue; }
+            real hw = H.w;
+            real hh = H.h;
+            real hLeft = H.x, hTop = H.y, hRight = H.x + hw, hBottom = H.y + hh;
             bool overlap = !(hRight <= batLeft || hLeft >= batRight || hBottom <= batTop || hTop >= batBottom);
             if (overlap)
             {
                 // Play hazard pickup SFX; avoid double-playing if this will cause Game Over
                 if (G.lives > 1)
-                    sound::play_sfx("game-over", 3, 1.0f, true);
-                H.active = false;
-                begin_death_sequence();
+                    play_named(G, "game-over", 3);
+                G.hazards.remove_at(hi);
+                begin_death_sequence(G);
                 return; // bail; sequence takes control
             }
-        }
-        // Compact occasionally
-        if ((int)G.hazards.size() > 32)
-        {
-            G.hazards.erase(std::remove_if(G.hazards.begin(), G.hazards.end(), [](const FallingHazard &h){ return !h.active; }), G.hazards.end());
+            ++hi;
         }
     }
 
-    static bool is_moving_type(int raw) { return raw == (int)BrickType::SS || raw == (int)BrickType::SF; }
-
-    static bool bomb_event_scheduled(int c, int r)
+    // Queue the bombs 8-adjacent to (c,r) that are not already waiting in the wheel
+    static void schedule_neighbor_bombs(State &G, int c, int r, int delay)
     {
-        for (const auto &e : G.bombEvents)
+        brickgrid::GridView v = levels_grid_view();
+        if (!v.occ || !brickgrid::GridView::in_range(c, r))
+            return;
+        brickgrid::Mask self;
+        self.clear();
+        self.set(r * brickgrid::kCols + c);
+        brickgrid::Mask next = brickgrid::minus(brickgrid::dilate8(self) & v.occ->bomb, self | G.bombPending);
+        for (int cell = next.next(0); cell >= 0; cell = next.next(cell + 1))
         {
-            if (e.c == c && e.r == r)
-                return true;
+            GameEvent ev{EventKind::Bomb, 0, (uint16_t)cell};
+            if (G.wheel.schedule(delay, ev))
+                G.bombPending.set(cell);
+#if defined(DEBUG) && DEBUG
+            emit_event(G, FrameEventKind::BombScheduled, (uint8_t)delay, cell, 0.f, 0.f);
+#endif
         }
-        return false;
     }
-    static void schedule_neighbor_bombs(int c, int r, int delay)
+    // Chain-explosion neighbour: destroyed outright, effects applied as for a final hit
+    static void destroy_brick_immediate(State &G, int c, int r)
     {
-        for (int dy = -1; dy <= 1; ++dy)
-            for (int dx = -1; dx <= 1; ++dx)
-                if (dx || dy)
-                {
-                    int nc = c + dx, nr = r + dy;
-                    int raw = levels_brick_at(nc, nr);
-                    if (raw == (int)BrickType::BO)
-                    {
-                        if (!bomb_event_scheduled(nc, nr))
-                        {
-                            G.bombEvents.push_back({nc, nr, delay});
-                            char dbg[96]; snprintf(dbg,sizeof dbg,"SCHED BOMB (%d,%d) delay=%d\n", nc,nr,delay); hw_log(dbg);
-                        }
-                    }
-                }
+        const int ls = levels_left(), ts = levels_top(), cw = levels_brick_width(), ch = levels_brick_height();
+        int raw = levels_brick_at(c, r);
+        if (raw <= 0) return;                    // empty / OOB
+        const uint8_t flags = brick_traits(raw).flags;
+        if (flags & kBrickIndestructible) return;
+        if (flags & kBrickBomb) return;          // bombs handled separately
+        real cx = (real)(ls + c * cw + cw / 2);
+        real cy = (real)(ts + r * ch + ch / 2);
+        BrickType bt = (BrickType)raw;
+        // Multi‑hit brick: treat as fully destroyed (spawn dust like final hit)
+        if (flags & kBrickMultiHit) {
+            spawn_dust_effect(G, sim::to_float(cx), sim::to_float(cy));
+        }
+        // Remove first so the queued effect sees cleared grid state (consistent with resolve_hit)
+        levels_remove_brick(c, r);
+        emit_brick_effect(G, bt, cx, cy, ball_at(G, 0));
+        if (flags & kBrickBatHazard) {
+            emit_bat_hazard(G, bt, cx, cy);
+        }
     }
-    static void process_bomb_events()
+    // A scheduled bomb's delay ran out
+    static void detonate_bomb(State &G, int c, int r)
     {
-        if (G.bombEvents.empty())
+        const int ls = levels_left(), ts = levels_top(), cw = levels_brick_width(), ch = levels_brick_height();
+        int raw = levels_brick_at(c, r);
+        if (raw != (int)BrickType::BO)
             return;
-    const int ls = levels_left(), ts = levels_top(), cw = levels_brick_width(), ch = levels_brick_height();
-        auto destroy_brick_immediate = [&](int c, int r) {
-            int raw = levels_brick_at(c, r);
-            if (raw <= 0) return;                    // empty / OOB
-            if (raw == (int)BrickType::ID) return;    // indestructible
-            if (raw == (int)BrickType::BO) return;    // bombs handled separately
-            float cx = (float)(ls + c * cw + cw / 2);
-            float cy = (float)(ts + r * ch + ch / 2);
-            BrickType bt = (BrickType)raw;
-            // Multi‑hit brick: treat as fully destroyed (spawn dust like final hit)
-            if (bt == BrickType::T5) {
-                game::spawn_dust_effect(cx, cy);
-            }
-            // Remove first so apply_brick_effect sees cleared grid state (consistent with resolve_hit)
-            levels_remove_brick(c, r);
-            apply_brick_effect(bt, cx, cy, G.balls[0]);
-            if (bt == BrickType::F1 || bt == BrickType::F2) {
-                spawn_destroy_bat_brick(bt, cx, cy);
-            }
-        };
-        for (auto &e : G.bombEvents)
-            if (e.frames > 0)
-                --e.frames;
-        std::vector<size_t> toExplode;
-        toExplode.reserve(G.bombEvents.size());
-        for (size_t i = 0; i < G.bombEvents.size(); ++i)
-            if (G.bombEvents[i].frames <= 0)
-                toExplode.push_back(i);
-        for (size_t idx : toExplode)
+        BENCH_COUNT(BombDetonations);
+        levels_remove_brick(c, r);
+        emit_brick_effect(G, BrickType::BO, ls + c * cw + cw / 2, ts + r * ch + ch / 2, ball_at(G, 0));
+        emit_explosion(G, c, r, (real)(ls + c * cw + cw / 2), (real)(ts + r * ch + ch / 2));
+        // Destroy orthogonal neighbors (Up=0, Right=1, Down=2, Left=3 semantics from legacy getside)
+        destroy_brick_immediate(G, c,     r - 1); // up
+        destroy_brick_immediate(G, c + 1, r    ); // right
+        destroy_brick_immediate(G, c,     r + 1); // down
+        destroy_brick_immediate(G, c - 1, r    ); // left
+        schedule_neighbor_bombs(G, c, r, 15); // 15 frame delay
+    }
+
+    static void advance_death_phase(State &G); // fwd
+    static void advance_game_over_phase(State &G); // fwd
+    static void on_scheduled_event(State &G, const GameEvent &e)
+    {
+        if (e.kind == EventKind::Bomb)
         {
-            if (idx >= G.bombEvents.size())
-                continue;
-            auto ev = G.bombEvents[idx];
-            int raw = levels_brick_at(ev.c, ev.r);
-            if (raw != (int)BrickType::BO)
-                continue;
-            // Log neighbor states before explosion to diagnose missing destruction cases
-            int rawU = levels_brick_at(ev.c,     ev.r - 1);
-            int rawR = levels_brick_at(ev.c + 1, ev.r     );
-            int rawD = levels_brick_at(ev.c,     ev.r + 1);
-            int rawL = levels_brick_at(ev.c - 1, ev.r     );
-            char dbg[96];
-            snprintf(dbg, sizeof dbg, "BOMB (%d,%d) neigh U=%d R=%d D=%d L=%d\n", ev.c, ev.r, rawU, rawR, rawD, rawL);
-            hw_log(dbg);
-            levels_remove_brick(ev.c, ev.r);
-            apply_brick_effect(BrickType::BO, ls + ev.c * cw + cw / 2, ts + ev.r * ch + ch / 2, G.balls[0]);
-            // Play explosion SFX at the start of the particle effect (with fallback channel)
-            if (!sound::play_sfx("explosion", 6, 1.0f, true)) {
-                sound::stop_sfx_channel(6);
-                sound::play_sfx("explosion", 7, 1.0f, true);
-            }
-            for (int k = 0; k < 8; k++)
-            {
-                float angle = (float)k / 8.f * 6.28318f;
-                float sp = 0.6f + 0.4f * (k % 4);
-                Particle p{(float)(ls + ev.c * cw + cw / 2), (float)(ts + ev.r * ch + ch / 2), std::cos(angle) * sp, std::sin(angle) * sp, 32, C2D_Color32(255, 200, 50, 255)};
-                G.particles.push_back(p);
-            }
-            // Destroy orthogonal neighbors (Up=0, Right=1, Down=2, Left=3 semantics from legacy getside)
-            destroy_brick_immediate(ev.c,     ev.r - 1); // up
-            destroy_brick_immediate(ev.c + 1, ev.r    ); // right
-            destroy_brick_immediate(ev.c,     ev.r + 1); // down
-            destroy_brick_immediate(ev.c - 1, ev.r    ); // left
-            schedule_neighbor_bombs(ev.c, ev.r, 15); // 15 frame delay
-
-            // After this explosion (and any immediate adjacent destruction), check for required brick completion
-            auto is_required_brick_local = [](BrickType bt) {
-                switch(bt) {
-                    case BrickType::YB: case BrickType::GB: case BrickType::CB: case BrickType::TB: case BrickType::PB: case BrickType::RB: case BrickType::SS: return true;
-                    default: return false;
-                }
-            };
-            int remainingReq = 0;
-            for (int r = 0; r < kBrickRows && remainingReq == 0; ++r) {
-                for (int c = 0; c < kBrickCols; ++c) {
-                    int braw = levels_brick_at(c, r);
-                    if (braw <= 0) continue;
-                    if (is_required_brick_local((BrickType)braw)) { remainingReq = 1; break; }
-                }
-            }
-            if (remainingReq == 0 && levels_count() > 0 && !editor::test_return_active()) {
-                int next = (levels_current() + 1) % levels_count();
-                levels_set_current(next);
-                set_bat_size(1);
-                reset_positions_for_new_level();
-                G.laserEnabled = false;
-                G.laserReady = false;
-                hw_log("LEVEL COMPLETE\n");
-            }
+            G.bombPending.reset(e.cell);
+            // The wheel also runs on the title screen; a chain left over from play just lapses there
+            if (G.mode == Mode::Playing) detonate_bomb(G, e.cell % brickgrid::kCols, e.cell / brickgrid::kCols);
+            return;
+        }
+        switch ((TimerId)e.timer)
+        {
+        case TimerId::DeathPhase: advance_death_phase(G); break;
+        case TimerId::GameOverPhase: advance_game_over_phase(G); break;
+        case TimerId::TitleCycle:
+            if (G.mode == Mode::Title) G.seqPos = (G.seqPos + 1) % (int)(sizeof(kSequence) / sizeof(kSequence[0]));
+            break;
+        default: break; // effect timers just lapse (readers check timer_active)
         }
-        G.bombEvents.erase(std::remove_if(G.bombEvents.begin(), G.bombEvents.end(), [](const BombEvent &e)
-                                          { return e.frames <= 0; }),
-                           G.bombEvents.end());
     }
-
-    static void update_moving_bricks(); // fwd
-    static void update_bonus_letters(); // fwd
-    static void update_falling_hazards(); // fwd
-
-    static void handle_ball_bricks(Ball &ball)
+    // One simulation tick of scheduled work; cost is proportional to the events that fire
+    static void run_scheduled_events(State &G)
     {
-    // Stepped sweep using the ball center as a point against bricks expanded by half the ball size.
-    // This reduces seam ambiguity and tunneling while keeping math simple.
-
-        auto play_brick_sfx = [](BrickType bt, bool destroyed) {
-            if (bt == BrickType::T5 && destroyed) {
-                sound::stop_sfx_channel(1);
-                sound::play_sfx("hard-explode", 6, 1.0f, true);
-            } else {
-                const char* sfx = "ball-brick";
-                if (bt == BrickType::ID || bt == BrickType::SF) sfx = "hit-hard";
-                else if (bt == BrickType::T5) sfx = "hit-hard"; // non-final hits
-                sound::play_sfx(sfx, 1, 1.0f, true);
-            }
-        };
+        G.wheel.advance([&G](const GameEvent &e) { on_scheduled_event(G, e); });
+    }
 
-    auto is_required_brick = [](BrickType bt) {
-        switch(bt) {
-            case BrickType::YB:
-            case BrickType::GB:
-            case BrickType::CB:
-            case BrickType::TB:
-            case BrickType::PB:
-            case BrickType::RB:
-            case BrickType::SS:
-                return true;
-            default:
-                return false;
-        }
-    };
+    static void update_moving_bricks(State &G); // fwd
+    static void update_bonus_letters(State &G); // fwd
+    static void update_falling_hazards(State &G); // fwd
 
-    auto remaining_required_bricks = [&]() -> int {
-        int cnt=0;
-        int totalCols = kBrickCols;
-        int totalRows = kBrickRows;
-        for(int r=0;r<totalRows;++r){
-            for(int c=0;c<totalCols;++c){
-                int raw = levels_brick_at(c,r);
-                if(raw<=0) continue;
-                BrickType bt=(BrickType)raw;
-                if(is_required_brick(bt)) ++cnt;
-            }
-        }
-        return cnt;
-    };
+    static void handle_ball_bricks(State &G, Ball ball)
+    {
+        BENCH_COUNT(BallBricks);
+    // Swept test using the ball center as a point against bricks expanded by half the ball size.
+    // The first contact along this frame's path is found exactly (see collision.hpp).
 
-    auto resolve_hit = [&](int c, int r, float bx, float by, int cellW, int cellH, float stepDX, float stepDY) -> void {
+    auto resolve_hit = [&](int c, int r, real bx, real by, int cellW, int cellH, real stepDX, real stepDY) -> void {
+            ++G.brickHits;
             int raw = levels_brick_at(c, r);
             BrickType bt = (BrickType)raw;
+            const BrickTraits &tr = brick_traits(raw);
             bool destroyed = true;
-            if (bt == BrickType::T5) {
+            if (tr.flags & kBrickMultiHit) {
                 destroyed = levels_damage_brick(c, r);
-            } else if (bt == BrickType::BO) {
+                if (destroyed) spawn_dust_effect(G, brick_center_x(c), brick_center_y(r));
+            } else if (tr.flags & kBrickBomb) {
                 levels_remove_brick(c, r);
-                apply_brick_effect(BrickType::BO, bx + cellW * 0.5f, by + cellH * 0.5f, ball);
-                {
-                    char dbg[96]; snprintf(dbg,sizeof dbg,"HIT BOMB immediate (%d,%d) schedNow=%zu\n", c,r, G.bombEvents.size()); hw_log(dbg);
-                }
-                if (!sound::play_sfx("explosion", 6, 1.0f, true)) { sound::stop_sfx_channel(6); sound::play_sfx("explosion", 7, 1.0f, true); }
-                for (int k = 0; k < 8; k++) {
-                    float angle = (float)k / 8.f * 6.28318f;
-                    float sp = 0.6f + 0.4f * (k % 4);
-                    Particle p{bx + cellW * 0.5f, by + cellH * 0.5f, std::cos(angle) * sp, std::sin(angle) * sp, 32, C2D_Color32(255, 200, 50, 255)};
-                    G.particles.push_back(p);
-                }
+                emit_brick_effect(G, BrickType::BO, bx + cellW * 0.5f, by + cellH * 0.5f, ball);
+                emit_explosion(G, c, r, bx + cellW * 0.5f, by + cellH * 0.5f);
                 // Immediate orthogonal neighbor destruction (same rules as chain explosions)
                 auto destroy_neighbor = [&](int nc, int nr) {
                     int nraw = levels_brick_at(nc, nr);
                     if (nraw <= 0) return; // empty/OOB
-                    if (nraw == (int)BrickType::ID) return; // indestructible
-                    if (nraw == (int)BrickType::BO) return; // bombs handled via scheduling
+                    const uint8_t nflags = brick_traits(nraw).flags;
+                    if (nflags & kBrickIndestructible) return;
+                    if (nflags & kBrickBomb) return; // bombs handled via scheduling
                     int ls = levels_left(); int ts = levels_top(); int cw = levels_brick_width(); int ch = levels_brick_height();
-                    float cx = (float)(ls + nc * cw + cw * 0.5f);
-                    float cy = (float)(ts + nr * ch + ch * 0.5f);
+                    real cx = (float)(ls + nc * cw + cw * 0.5f);
+                    real cy = (float)(ts + nr * ch + ch * 0.5f);
                     BrickType nbt = (BrickType)nraw;
-                    if (nbt == BrickType::T5) { game::spawn_dust_effect(cx, cy); }
+                    if (nflags & kBrickMultiHit) { spawn_dust_effect(G, sim::to_float(cx), sim::to_float(cy)); }
                     levels_remove_brick(nc, nr);
-                    apply_brick_effect(nbt, cx, cy, ball);
-                    if (nbt == BrickType::F1 || nbt == BrickType::F2) { spawn_destroy_bat_brick(nbt, cx, cy); }
+                    emit_brick_effect(G, nbt, cx, cy, ball);
+                    if (nflags & kBrickBatHazard) { emit_bat_hazard(G, nbt, cx, cy); }
                 };
                 destroy_neighbor(c, r-1); // up
                 destroy_neighbor(c+1, r); // right
                 destroy_neighbor(c, r+1); // down
                 destroy_neighbor(c-1, r); // left
-                schedule_neighbor_bombs(c, r, 15);
-            } else if (bt == BrickType::ID) {
+                schedule_neighbor_bombs(G, c, r, 15);
+            } else if (tr.flags & kBrickIndestructible) {
                 destroyed = false;
-            } else if (bt == BrickType::F1 || bt == BrickType::F2) {
+            } else if (tr.flags & kBrickBatHazard) {
                 levels_remove_brick(c, r);
-                apply_brick_effect(bt, bx + cellW * 0.5f, by + cellH * 0.5f, ball);
-                spawn_destroy_bat_brick(bt, bx + cellW * 0.5f, by + cellH * 0.5f);
+                emit_brick_effect(G, bt, bx + cellW * 0.5f, by + cellH * 0.5f, ball);
+                emit_bat_hazard(G, bt, bx + cellW * 0.5f, by + cellH * 0.5f);
             } else {
                 levels_remove_brick(c, r);
             }
-            apply_brick_effect(bt, bx + cellW * 0.5f, by + cellH * 0.5f, ball);
-            play_brick_sfx(bt, destroyed);
-
-            // AB/MB: split but original continues without reflecting
-            if (bt == BrickType::AB || bt == BrickType::MB) {
-                if (destroyed && remaining_required_bricks() == 0 && levels_count() > 0) {
-                    if(!editor::test_return_active()) {
-                        int next = (levels_current() + 1) % levels_count();
-                        levels_set_current(next);
-                        set_bat_size(1);
-                        reset_positions_for_new_level();
-                        G.laserEnabled = false;
-                        G.laserReady = false;
-                        hw_log("LEVEL COMPLETE\n");
-                    }
-                }
-                return; // no reflection
-            }
+            emit_brick_effect(G, bt, bx + cellW * 0.5f, by + cellH * 0.5f, ball);
+            emit_sound(G, ((tr.flags & kBrickMultiHit) && destroyed) ? Sfx::HardExplode : (Sfx)tr.sfx);
 
             // Reflect using center-vs-expanded-rect distances with tie-breaker on travel axis.
-            // Murder balls reflect the same as regular balls; only IS/IF are pass-through.
-            if (bt != BrickType::IS && bt != BrickType::IF) {
-                const float eps = 0.05f;
-                float spriteW = (ball.img.subtex ? ball.img.subtex->width : (float)kBallW);
-                float spriteH = (ball.img.subtex ? ball.img.subtex->height : (float)kBallH);
-                float cx = ball.x + spriteW * 0.5f;
-                float cy = ball.y + spriteH * 0.5f;
-                float halfW = (float)kBallW * 0.5f;
-                float halfH = (float)kBallH * 0.5f;
-                float leftBound   = bx - halfW;
-                float rightBound  = bx + cellW + halfW;
-                float topBound    = by - halfH;
-                float bottomBound = by + cellH + halfH;
+            // Murder balls reflect the same as regular balls; pass-through bricks (IS/IF, and
+            // AB/MB whose original ball continues after the split) do not bounce.
+            if (!(tr.flags & kBrickPassThrough)) {
+                const real eps = 0.05f;
+                real spriteW = ball_sprite_w(G, ball);
+                real spriteH = ball_sprite_h(G, ball);
+                real cx = ball.x + spriteW * 0.5f;
+                real cy = ball.y + spriteH * 0.5f;
+                real halfW = (real)kBallW * 0.5f;
+                real halfH = (real)kBallH * 0.5f;
+                real leftBound   = bx - halfW;
+                real rightBound  = bx + cellW + halfW;
+                real topBound    = by - halfH;
+                real bottomBound = by + cellH + halfH;
                 // Distances to each side from inside the expanded rect
-                float distL = cx - leftBound;
-                float distR = rightBound - cx;
-                float distT = cy - topBound;
-                float distB = bottomBound - cy;
-                float penX = std::min(distL, distR);
-                float penY = std::min(distT, distB);
+                real distL = cx - leftBound;
+                real distR = rightBound - cx;
+                real distT = cy - topBound;
+                real distB = bottomBound - cy;
+                real penX = sim::min(distL, distR);
+                real penY = sim::min(distT, distB);
                 bool preferX = penX < penY;
                 // Tie-break near joins: use larger travel component this substep
-                if (std::fabs(penX - penY) < 0.25f) {
-                    if (std::fabs(stepDX) > std::fabs(stepDY)) preferX = true;
-                    else if (std::fabs(stepDY) > std::fabs(stepDX)) preferX = false;
+                if (sim::fabs(penX - penY) < 0.25f) {
+                    if (sim::fabs(stepDX) > sim::fabs(stepDY)) preferX = true;
+                    else if (sim::fabs(stepDY) > sim::fabs(stepDX)) preferX = false;
                     // if equal, leave as computed
                 }
                 if (preferX) {
@@ -1265,145 +1444,133 @@ namespace game
                 ball.y = cy - spriteH * 0.5f;
             }
 
-            if (destroyed && remaining_required_bricks() == 0 && levels_count() > 0) {
-                if(!editor::test_return_active()) {
-                    int next = (levels_current() + 1) % levels_count();
-                    levels_set_current(next);
-                    set_bat_size(1);
-                    reset_positions_for_new_level();
-                    G.laserEnabled = false;
-                    G.laserReady = false;
-                    hw_log("LEVEL COMPLETE\n");
-                }
-            }
         };
 
-        auto step_and_check_static = [&]() -> bool {
-            int ls = levels_left();
-            int ts = levels_top();
+        // Earliest impact along this frame's path. Static bricks use the grid DDA; sliding
+        // bricks are swept with the ball's motion relative to each brick, only in the rows
+        // the path crosses. Both compete on contact time and only the first is resolved.
+        auto sweep_bricks = [&]() -> bool {
+            brickgrid::GridView grid = levels_grid_view();
+            if (grid.empty()) return false;
+            const brickgrid::Occupancy &occ = *grid.occ;
             int cellW = levels_brick_width();
             int cellH = levels_brick_height();
-            float targetX = ball.x, targetY = ball.y;
-            float startX = ball.px, startY = ball.py;
-        float dx = targetX - startX, dy = targetY - startY;
-        // Substep at 0.5px increments to reduce tunneling at high speeds
-        const float stepSize = 0.5f;
-        int steps = (int)std::ceil(std::max(std::fabs(dx), std::fabs(dy)) / stepSize);
-            if (steps < 1) steps = 1;
-        float stepDX = dx / (float)steps;
-        float stepDY = dy / (float)steps;
-            for (int i = 1; i <= steps; ++i) {
-        ball.x = startX + stepDX * (float)i;
-        ball.y = startY + stepDY * (float)i;
-        // Check center-point against expanded bricks at this sub-position
-        float spriteW = (ball.img.subtex ? ball.img.subtex->width : (float)kBallW);
-        float spriteH = (ball.img.subtex ? ball.img.subtex->height : (float)kBallH);
-        float cx = ball.x + spriteW * 0.5f;
-        float cy = ball.y + spriteH * 0.5f;
-        float halfW = (float)kBallW * 0.5f;
-        float halfH = (float)kBallH * 0.5f;
-        int minCol = (int)(((cx - halfW) - ls) / cellW); if (minCol < 0) minCol = 0; if (minCol >= kBrickCols) continue;
-        int maxCol = (int)((((cx + halfW) - ls)) / cellW); if (maxCol < 0) continue; if (maxCol >= kBrickCols) maxCol = kBrickCols - 1;
-        int minRow = (int)(((cy - halfH) - ts) / cellH); if (minRow < 0) minRow = 0; if (minRow >= kBrickRows) continue;
-        int maxRow = (int)((((cy + halfH) - ts)) / cellH); if (maxRow < 0) continue; if (maxRow >= kBrickRows) maxRow = kBrickRows - 1;
-                for (int r = minRow; r <= maxRow; ++r) {
-                    for (int c = minCol; c <= maxCol; ++c) {
-                        int raw = levels_brick_at(c, r);
-                        if (raw <= 0 || is_moving_type(raw)) continue;
-            float bx = ls + c * cellW;
-            float by = ts + r * cellH;
-            // Expanded rect bounds
-            float leftBound   = bx - halfW;
-            float rightBound  = bx + cellW + halfW;
-            float topBound    = by - halfH;
-            float bottomBound = by + cellH + halfH;
-                        if (!(cx >= leftBound && cx <= rightBound && cy >= topBound && cy <= bottomBound)) continue;
-                        resolve_hit(c, r, bx, by, cellW, cellH, stepDX, stepDY);
-                        return true; // stop after first for both ball types
+            collision::GridGeom<real> geom;
+            geom.left = (real)levels_left(); geom.top = (real)levels_top();
+            geom.cellW = (real)cellW; geom.cellH = (real)cellH;
+            geom.cols = kBrickCols; geom.rows = kBrickRows;
+            geom.halfW = (real)kBallW * 0.5f; geom.halfH = (real)kBallH * 0.5f;
+            real spriteW = ball_sprite_w(G, ball);
+            real spriteH = ball_sprite_h(G, ball);
+            real startCX = ball.px + spriteW * 0.5f, startCY = ball.py + spriteH * 0.5f;
+            real endCX = ball.x + spriteW * 0.5f, endCY = ball.y + spriteH * 0.5f;
+            collision::SweepHit<real> hit = collision::sweep_grid(geom, startCX, startCY, endCX, endCY,
+                [&occ](int c, int r) { int i = r * brickgrid::kCols + c; return occ.any.test(i) && !occ.moving.test(i); });
+
+            real bestT = hit.hit ? hit.t : 2.0f;
+            int movC = -1, movR = -1;
+            if (occ.moving.any()) {
+                real yMin = sim::min(startCY, endCY) - geom.halfH, yMax = sim::max(startCY, endCY) + geom.halfH;
+                int r0 = sim::floor_int((yMin - geom.top) / geom.cellH);
+                int r1 = sim::floor_int((yMax - geom.top) / geom.cellH);
+                if (r0 < 0) r0 = 0;
+                if (r1 > kBrickRows - 1) r1 = kBrickRows - 1;
+                for (int r = r0; r <= r1; ++r) {
+                    for (uint32_t bits = occ.moving.row(r); bits; bits &= bits - 1) {
+                        int c = __builtin_ctz(bits);
+                        int idx = r * kBrickCols + c;
+                        if (idx >= (int)G.moving.size()) continue;
+                        const auto &mb = G.moving[idx];
+                        if (mb.pos < 0.f) continue;
+                        real t; collision::Face face;
+                        if (!collision::sweep_sliding_rect(startCX, startCY, endCX, endCY, mb.prevPos, mb.pos,
+                                                           geom.top + r * geom.cellH, geom.cellW, geom.cellH,
+                                                           geom.halfW, geom.halfH, t, face))
+                            continue;
+                        if (t < bestT) { bestT = t; movC = c; movR = r; }
                     }
                 }
             }
-            // No static hit; place ball at target
-            ball.x = targetX;
-            ball.y = targetY;
-            return false;
-        };
-
-    auto check_moving = [&]() -> bool {
-            int ts = levels_top();
-            int cellW = levels_brick_width();
-            int cellH = levels_brick_height();
-        // Ball center at final position
-        float spriteW = (ball.img.subtex ? ball.img.subtex->width : (float)kBallW);
-        float spriteH = (ball.img.subtex ? ball.img.subtex->height : (float)kBallH);
-        float cx = ball.x + spriteW * 0.5f;
-        float cy = ball.y + spriteH * 0.5f;
-        float halfW = (float)kBallW * 0.5f;
-        float halfH = (float)kBallH * 0.5f;
-            for (int r = 0; r < kBrickRows; ++r) {
-                for (int c = 0; c < kBrickCols; ++c) {
-                    int raw = levels_brick_at(c, r);
-                    if (!is_moving_type(raw)) continue;
-                    int idx = r * kBrickCols + c;
-                    if (idx < 0 || idx >= (int)G.moving.size()) continue;
-                    auto &mb = G.moving[idx];
-                    if (mb.pos < 0.f) continue;
-            float bx = mb.pos;
-            float by = ts + r * cellH;
-            float leftBound   = bx - halfW;
-            float rightBound  = bx + cellW + halfW;
-            float topBound    = by - halfH;
-            float bottomBound = by + cellH + halfH;
-            if (!(cx >= leftBound && cx <= rightBound && cy >= topBound && cy <= bottomBound)) continue;
-            // Use current velocity for tie-breaking
-            resolve_hit(c, r, bx, by, cellW, cellH, ball.vx, ball.vy);
-            return true;
-                }
+            if (bestT > 1.0f) return false; // ball stays at its integrated target
+
+            // Move to the contact point; resolve_hit reflects from there as before
+            real dx = endCX - startCX, dy = endCY - startCY;
+            ball.x = startCX + dx * bestT - spriteW * 0.5f;
+            ball.y = startCY + dy * bestT - spriteH * 0.5f;
+            if (movC >= 0) {
+                // Resolve against the brick's end-of-frame position so the ball is pushed clear of it
+                const auto &mb = G.moving[movR * kBrickCols + movC];
+                resolve_hit(movC, movR, mb.pos, geom.top + movR * cellH, cellW, cellH,
+                            dx - (mb.pos - mb.prevPos), dy);
+            } else {
+                resolve_hit(hit.col, hit.row, geom.left + hit.col * cellW, geom.top + hit.row * cellH,
+                            cellW, cellH, dx, dy);
             }
-        return false;
+            return true; // stop after first for both ball types
         };
 
-        if (step_and_check_static()) return;
-        (void)check_moving();
+        (void)sweep_bricks();
+    }
+
+    // Recompute one row's moving-brick list and free spans (only after that row changed)
+    static void refresh_moving_row(State &G, int r, const brickgrid::Occupancy &occ, int ls, int cw)
+    {
+        MovingRow &row = G.movingRows[r];
+        row.owner = &occ;
+        row.version = occ.rowVersion[r];
+        row.count = 0;
+        uint32_t occupied = occ.any.row(r);
+        uint32_t moving = occ.moving.row(r);
+        for (int c = 0; c < kBrickCols; ++c)
+        {
+            if (!(moving & (1u << c)))
+                continue;
+            row.cols[row.count++] = (uint8_t)c;
+            auto &mb = G.moving[r * kBrickCols + c];
+            int left = c;
+            while (left - 1 >= 0 && !(occupied & (1u << (left - 1))))
+                --left;
+            int right = c;
+            while (right + 1 < kBrickCols && !(occupied & (1u << (right + 1))))
+                ++right;
+            real newMin = ls + left * cw;
+            real newMax = ls + right * cw;
+            bool hadNoSpan = (mb.minX == mb.maxX);
+            mb.minX = newMin;
+            mb.maxX = newMax;
+            if (mb.pos < 0.f)
+                mb.pos = ls + c * cw;
+            // If we previously had no span (blocked) and now have space, kick movement on
+            if (hadNoSpan && newMin != newMax && mb.dir == 0.f)
+                mb.dir = 1.f;
+            // Clamp position into new bounds before advancing
+            if (mb.pos < mb.minX)
+                mb.pos = mb.minX;
+            if (mb.pos > mb.maxX)
+                mb.pos = mb.maxX;
+        }
     }
 
-    static void update_moving_bricks()
+    static void update_moving_bricks(State &G)
     {
-        int cols = levels_grid_width();
-        int rows = levels_grid_height();
+        BENCH_COUNT(MovingBricks);
     int ls = levels_left(); // now includes runtime offset
         int cw = levels_brick_width();
-        for (int r = 0; r < rows; ++r)
+        brickgrid::GridView grid = levels_grid_view();
+        if (!grid.valid() || (int)G.moving.size() != brickgrid::kCells)
+            return;
+        const brickgrid::Occupancy &occ = *grid.occ;
+        for (int r = 0; r < kBrickRows; ++r)
         {
-            for (int c = 0; c < cols; ++c)
+            MovingRow &row = G.movingRows[r];
+            if (row.owner != &occ || row.version != occ.rowVersion[r])
+                refresh_moving_row(G, r, occ, ls, cw);
+            for (int k = 0; k < row.count; ++k)
             {
-                int raw = levels_brick_at(c, r);
-                if (!is_moving_type(raw))
-                    continue;
-                int idx = r * cols + c;
+                int idx = r * kBrickCols + row.cols[k];
                 auto &mb = G.moving[idx];
-                int left = c;
-                while (left - 1 >= 0 && levels_brick_at(left - 1, r) == 0)
-                    --left;
-                int right = c;
-                while (right + 1 < cols && levels_brick_at(right + 1, r) == 0)
-                    ++right;
-                float newMin = ls + left * cw;
-                float newMax = ls + right * cw;
-                bool hadNoSpan = (mb.minX == mb.maxX);
-                mb.minX = newMin;
-                mb.maxX = newMax;
-                if (mb.pos < 0.f)
-                    mb.pos = ls + c * cw;
-                // If we previously had no span (blocked) and now have space, kick movement on
-                if (hadNoSpan && newMin != newMax && mb.dir == 0.f)
-                    mb.dir = 1.f;
-                // Clamp position into new bounds before advancing
-                if (mb.pos < mb.minX)
-                    mb.pos = mb.minX;
-                if (mb.pos > mb.maxX)
-                    mb.pos = mb.maxX;
-                float speed = (raw == (int)BrickType::SS) ? 0.5f : 1.0f;
+                mb.prevPos = mb.pos;
+                real speed = (grid.bricks[idx] == (int)BrickType::SS) ? 0.5f : 1.0f;
                 if (mb.dir != 0.f)
                 {
                     mb.pos += mb.dir * speed;
@@ -1427,122 +1594,205 @@ namespace game
         }
     }
 
-    static void fire_laser()
+    static void fire_laser(State &G)
     {
-        if (!G.laserEnabled || !G.laserReady || G.fireCooldown > 0)
+        if (!G.laserEnabled || !G.laserReady || timer_active(G, TimerId::FireCooldown))
             return;
         // Only one laser at a time
-        for (const auto &L : G.lasers)
-            if (L.active)
-                return;
-        G.fireCooldown = 6; // small debounce so a single press fires once
-        G.lasers.push_back({G.bat.x + G.bat.width / 2 - 1, G.bat.y - 6, true});
+        if (!G.lasers.empty())
+            return;
+        start_timer(G, TimerId::FireCooldown, 6); // small debounce so a single press fires once
+        Laser beam;
+        beam.x = G.bat.x + G.bat.width / 2 - 1;
+        beam.y = G.bat.y - 6;
+        G.lasers.spawn(beam);
         G.laserReady = false; // indicator hides while the beam is active
     }
 
-    static void update_lasers()
+    static void update_lasers(State &G)
     {
-        if (G.fireCooldown > 0)
-            --G.fireCooldown;
         const int cw = levels_brick_width(), ch = levels_brick_height();
     int ls = levels_left(), ts = levels_top(); // offset-aware
-        for (auto &L : G.lasers)
-            if (L.active)
+        const brickgrid::GridView grid = levels_grid_view();
+        for (int li = 0; li < G.lasers.size();)
+        {
+            Laser &L = G.lasers[li];
+            L.y -= 4.0f;
+            if (L.y < 0)
             {
-                L.y -= 4.0f;
-                if (L.y < 0)
-                {
-                    L.active = false;
-                    continue;
-                }
-                // collision with brick (grid based at laser x,y)
-                int col = (int)((L.x - ls) / cw);
-                int row = (int)((L.y - ts) / ch);
-                if (col >= 0 && col < levels_grid_width() && row >= 0 && row < levels_grid_height())
+                G.lasers.remove_at(li);
+                continue;
+            }
+            // The beam's target is the nearest occupied cell at or above its tip, looked up in the
+            // column height map; it is only re-resolved when that column changes, and the beam
+            // hits once its tip rises past the target's bottom edge.
+            int col = sim::trunc_int((L.x - ls) / cw);
+            if (grid.occ && col >= 0 && col < levels_grid_width() && (col != L.col || L.grid != grid.occ || L.colVersion != grid.occ->colVersion[col]))
+            {
+                int tipRow = sim::trunc_int((L.y - ts) / ch);
+                if (tipRow >= levels_grid_height()) tipRow = levels_grid_height() - 1;
+                L.col = (int16_t)col;
+                L.grid = grid.occ;
+                L.colVersion = grid.occ->colVersion[col];
+                L.targetRow = (int16_t)grid.occ->next_at_or_above(col, tipRow);
+            }
+            int row = L.targetRow;
+            if (col == L.col && row >= 0 && L.y < ts + (row + 1) * ch)
+            {
+                int raw = levels_brick_at(col, row);
+                if (raw > 0)
                 {
-                    int raw = levels_brick_at(col, row);
-                    if (raw > 0)
+                    BrickType bt = (BrickType)raw;
+                    const uint8_t flags = brick_traits(raw).flags;
+                    bool appliedInBranch = false;
+                    if (flags & kBrickMultiHit)
                     {
-                        BrickType bt = (BrickType)raw;
-                        bool appliedInBranch = false;
-                        if (bt == BrickType::T5)
-                        {
-                            (void)levels_damage_brick(col, row);
-                        }
-                        else if (bt == BrickType::BO)
-                        {
-                            std::vector<DestroyedBrick> list;
-                            levels_explode_bomb(col, row, &list);
-                            for (auto &db : list)
-                            {
-                                float cx = ls + db.col * cw + cw * 0.5f;
-                                float cy = ts + db.row * ch + ch * 0.5f;
-                                apply_brick_effect((BrickType)db.type, cx, cy, G.balls[0]);
-                                if (db.type == (int)BrickType::F1 || db.type == (int)BrickType::F2)
-                                    spawn_destroy_bat_brick((BrickType)db.type, cx, cy);
-                            }
-                            appliedInBranch = true; // effects already applied for all destroyed bricks
-                        }
-                        else if (bt == BrickType::ID)
-                        { /* indestructible: no action */
-                        }
-                        else
-                        {
-                            levels_remove_brick(col, row);
-                        }
-                        // Apply effect at the center of the hit brick so falling pickups spawn in place
-                        if (!appliedInBranch)
+                        if (levels_damage_brick(col, row))
+                            spawn_dust_effect(G, brick_center_x(col), brick_center_y(row));
+                    }
+                    else if (flags & kBrickBomb)
+                    {
+                        std::vector<DestroyedBrick> &list = G.blastScratch;
+                        list.clear();
+                        levels_explode_bomb(col, row, &list);
+                        for (auto &db : list)
                         {
-                            float cx = ls + col * cw + cw * 0.5f;
-                            float cy = ts + row * ch + ch * 0.5f;
-                            apply_brick_effect(bt, cx, cy, G.balls[0]);
-                            if (bt == BrickType::F1 || bt == BrickType::F2)
-                                spawn_destroy_bat_brick(bt, cx, cy);
+                            real cx = ls + db.col * cw + cw * 0.5f;
+                            real cy = ts + db.row * ch + ch * 0.5f;
+                            emit_brick_effect(G, (BrickType)db.type, cx, cy, ball_at(G, 0));
+                            if (brick_traits(db.type).flags & kBrickBatHazard)
+                                emit_bat_hazard(G, (BrickType)db.type, cx, cy);
                         }
-                        L.active = false;
+                        appliedInBranch = true; // effects already applied for all destroyed bricks
+                    }
+                    else if (flags & kBrickIndestructible)
+                    { /* indestructible: no action */
+                    }
+                    else
+                    {
+                        levels_remove_brick(col, row);
+                    }
+                    // Apply effect at the center of the hit brick so falling pickups spawn in place
+                    if (!appliedInBranch)
+                    {
+                        real cx = ls + col * cw + cw * 0.5f;
+                        real cy = ts + row * ch + ch * 0.5f;
+                        emit_brick_effect(G, bt, cx, cy, ball_at(G, 0));
+                        if (flags & kBrickBatHazard)
+                            emit_bat_hazard(G, bt, cx, cy);
                     }
+                    G.lasers.remove_at(li);
+                    continue;
                 }
             }
+            ++li;
+        }
         // If no active lasers and ability is enabled, show indicator again
-        bool anyActive = false;
-        for (const auto &L : G.lasers) if (L.active) { anyActive = true; break; }
-        if (!anyActive && G.laserEnabled)
+        if (G.lasers.empty() && G.laserEnabled)
             G.laserReady = true;
     }
 
+    // Single level-advance point: levels.cpp latches completion when the last required brick
+    // is removed (ball, laser or bomb); handled once per frame after all brick mutations.
+    static void advance_if_level_complete(State &G)
+    {
+        if (!levels_take_level_complete()) return;
+        if (levels_count() <= 0 || editor::test_return_active()) return; // editor test auto-returns instead
+        int next = (levels_current() + 1) % levels_count();
+        levels_set_current(next);
+        set_bat_size(G, 1);
+        reset_positions_for_new_level(G);
+        reset_moving_bricks(G);
+        G.laserEnabled = false;
+        G.laserReady = false;
+        ++G.levelsCompleted;
+        hw_log("LEVEL COMPLETE\n");
+    }
+
+    // Fresh game (3 lives, score 0) on level `index` of the loaded pack: what START does for
+    // the first level, for any level. Pending bombs and every timer are dropped, and every
+    // level is put back as loaded (REWIND/FORWARD pickups can move play onto another level).
+    static void start_level(State &G, int index)
+    {
+        for (int i = 0; i < levels_count(); ++i)
+            levels_reset_level(i);
+        levels_set_current(index);
+        G.mode = Mode::Playing;
+        G.lives = 3;
+        G.score = 0;
+        G.bonusBits = 0;
+        G.murderTimer = 0;
+        G.wheel.clear();
+        G.bombPending.clear();
+        G.letters.clear();
+        G.hazards.clear();
+        G.lasers.clear();
+        G.particles.clear();
+        G.frameEvents.clear();
+        G.trajectories.clear();
+        G.brickHits = 0;
+        G.deathActive = false; G.deathFadeAlpha = 0; G.deathPhase = 0; G.deathSinkVy = 0.f;
+        G.gameOverActive = false; G.gameOverAlpha = 0; G.gameOverPhase = 0;
+        G.laserEnabled = false;
+        G.laserReady = false;
+        G.framesSinceBarrierHit = 0;
+        G.tiltAvailable = false;
+        stop_timer(G, TimerId::TiltCooldown);
+        G.dragging = false;
+        set_bat_size(G, 1);
+        reset_positions_for_new_level(G);
+        reset_moving_bricks(G);
+        start_timer(G, TimerId::LevelIntro, 90);
+    }
+
     // (Options menu state & logic extracted to options.cpp)
 
-    void update(const InputState &in)
+    void update(State &G, const InputState &in)
     {
+        BENCH_COUNT(Ticks);
+        // If in test mode (editor launched) and level ended (no breakables) or lives depleted, return to editor
+        if (editor::test_return_active() && G.mode == Mode::Playing)
+        {
+            bool levelDone = (!editor::test_grace_active());
+            if(levelDone) levelDone = (levels_remaining_required()==0);
+            if (levelDone)
+            {
+                G.mode = Mode::Editor;
+                levels_set_current(editor::current_level_index());
+                editor::on_return_from_test_full();
+                hw_log("TEST return (levelDone)\n");
+            }
+        }
+        // Tick grace once per tick, after the check
+        if (editor::test_grace_active()) editor::tick_test_grace();
         // If the configured hinge gap changes at runtime (Options -> Device Type), shift
         // bottom-world objects by the delta so their on-screen positions remain constant.
         {
-            static int sPrevGapPx = -100000; // sentinel for first-run init
             int curGap = options::hinge_gap_px();
-            if (sPrevGapPx == -100000) {
-                sPrevGapPx = curGap;
-            } else if (curGap != sPrevGapPx) {
-                int delta = curGap - sPrevGapPx;
+            if (G.prevGapPx == -100000) {
+                G.prevGapPx = curGap;
+            } else if (curGap != G.prevGapPx) {
+                int delta = curGap - G.prevGapPx;
                 // Move bat in world space so it stays anchored visually
-                G.bat.y += (float)delta;
+                G.bat.y += (real)delta;
                 // Adjust all dynamic bottom-world objects that were in the bottom band under the previous gap
-                float prevBottomBandY = 240.0f + (float)sPrevGapPx;
-                for (auto &b : G.balls) {
-                    if (b.y >= prevBottomBandY) { b.y += (float)delta; b.py += (float)delta; }
+                real prevBottomBandY = 240.0f + (real)G.prevGapPx;
+                for (int i = 0; i < G.balls.size(); ++i) {
+                    if (G.balls.y[i] >= prevBottomBandY) { G.balls.y[i] += (real)delta; G.balls.py[i] += (real)delta; }
                 }
                 for (auto &lz : G.lasers) {
-                    if (lz.y >= prevBottomBandY) { lz.y += (float)delta; }
+                    if (lz.y >= prevBottomBandY) { lz.y += (real)delta; }
                 }
                 for (auto &L : G.letters) {
-                    if (L.y >= prevBottomBandY) { L.y += (float)delta; }
+                    if (L.y >= prevBottomBandY) { L.y += (real)delta; }
                 }
                 for (auto &H : G.hazards) {
-                    if (H.y >= prevBottomBandY) { H.y += (float)delta; }
+                    if (H.y >= prevBottomBandY) { H.y += (real)delta; }
                 }
-                for (auto &p : G.particles) {
-                    if (p.y >= prevBottomBandY) { p.y += (float)delta; }
+                for (int i = 0; i < G.particles.size(); ++i) {
+                    if (G.particles.y[i] >= prevBottomBandY) { G.particles.y[i] += (real)delta; }
                 }
-                sPrevGapPx = curGap;
+                G.prevGapPx = curGap;
             }
         }
         // Keep brick logic in world coordinates; runtime brick Y offset matches layout (no extra padding)
@@ -1556,11 +1806,10 @@ namespace game
     if (G.mode == Mode::Title)
         {
             // Touch-driven title buttons now trigger on release (press-release inside same button)
-            static int sPressedBtn = -1; // index into kTitleButtons while stylus held
             // Physical button mappings: START=Play, SELECT=Editor, X=Exit
             if (in.startPressed)
             {
-                sound::play_sfx("menu-click", 4, 1.0f, true);
+                play_named(G, "menu-click", 4);
                 levels_set_current(0);
                 levels_reset_level(0);
                 // Fresh play session: reset full game state to avoid carry-over from editor/test
@@ -1568,38 +1817,35 @@ namespace game
                 // Reset balls to a single parked ball locked to the bat
                 G.balls.clear();
                 {
-                    float ballStartX = kScreenWidth * 0.5f + kPlayfieldOffsetX - kInitialBallHalf;
+                    real ballStartX = kScreenWidth * 0.5f + kPlayfieldOffsetX - kInitialBallHalf;
                     int gapPx = options::hinge_gap_px();
-                    G.balls.push_back({ballStartX, kInitialBallY + gapPx, 0.0f, 0.f, ballStartX, kInitialBallY + gapPx, true, false, G.imgBall});
+                    G.balls.add(ballStartX, kInitialBallY + gapPx, 0.0f, 0.f, false);
                 }
                 G.ballLocked = true;
-                set_bat_size(1);
+                set_bat_size(G, 1);
                 // Reset score/timers and transient objects
                 G.score = 0;
                 G.bonusBits = 0;
-                G.reverseTimer = G.lightsOffTimer = G.murderTimer = 0;
-                G.fireCooldown = 0;
+                G.murderTimer = 0;
+                stop_effect_timers(G);
                 G.letters.clear();
                 G.hazards.clear();
                 // Reset Tilt state so it can't appear instantly on new test
                 G.framesSinceBarrierHit = 0;
                 G.tiltAvailable = false;
-                G.tiltCooldownFrames = 0;
-                G.tiltShakeTimer = 0;
+                stop_timer(G, TimerId::TiltCooldown);
+                stop_timer(G, TimerId::TiltShake);
                 // Reinitialize moving bricks data for current layout
-                {
-                    int totalCells = levels_grid_width() * levels_grid_height();
-                    G.moving.assign(totalCells, {-1.f, 1.f, 0.f, 0.f});
-                }
+                reset_moving_bricks(G);
                 G.mode = Mode::Playing;
                 hw_log("start (START)\n");
                 G.prevTouching = in.touching; // keep touch edge tracking consistent
-                G.levelIntroTimer = 90; // show intro ~1.5s
+                start_timer(G, TimerId::LevelIntro, 90); // show intro ~1.5s
                 return;
             }
             if (in.selectPressed)
             {
-                sound::play_sfx("menu-click", 4, 1.0f, true);
+                play_named(G, "menu-click", 4);
                 G.mode = Mode::Editor;
                 hw_log("editor (SELECT)\n");
                 G.prevTouching = in.touching;
@@ -1607,15 +1853,15 @@ namespace game
             }
             if (in.xPressed)
             {
-                sound::play_sfx("menu-click", 4, 1.0f, true);
-                g_exitRequested = true;
+                play_named(G, "menu-click", 4);
+                G.exitRequested = true;
                 hw_log("exit (X)\n");
                 G.prevTouching = in.touching;
                 return;
             }
             if (in.selectPressed)
             {
-                sound::play_sfx("menu-click", 4, 1.0f, true);
+                play_named(G, "menu-click", 4);
                 G.mode = Mode::Editor;
                 hw_log("editor (SELECT)\n");
                 G.prevTouching = in.touching;
@@ -1623,8 +1869,8 @@ namespace game
             }
             if (in.xPressed)
             {
-                sound::play_sfx("menu-click", 4, 1.0f, true);
-                g_exitRequested = true;
+                play_named(G, "menu-click", 4);
+                G.exitRequested = true;
                 hw_log("exit (X)\n");
                 G.prevTouching = in.touching;
                 return;
@@ -1632,35 +1878,35 @@ namespace game
             // Handle stylus interactions (press / drag / release)
             if (in.touchPressed)
             {
-                sPressedBtn = -1;
+                G.titlePressedBtn = -1;
                 int tx = in.stylusX, ty = in.stylusY;
                 for (int i = 0; i < 4; ++i)
                 {
                     if (kTitleButtons[i].btn.contains(tx, ty))
                     {
-                        sPressedBtn = i;
+                        G.titlePressedBtn = i;
                         break;
                     }
                 }
             }
             // If moving while holding and leave button bounds, cancel
-            if (in.touching && sPressedBtn >= 0)
+            if (in.touching && G.titlePressedBtn >= 0)
             {
                 int tx = in.stylusX, ty = in.stylusY;
-                if (!kTitleButtons[sPressedBtn].btn.contains(tx, ty))
-                    sPressedBtn = -1; // canceled
+                if (!kTitleButtons[G.titlePressedBtn].btn.contains(tx, ty))
+                    G.titlePressedBtn = -1; // canceled
             }
             // On release: trigger if still over original button
             if (G.prevTouching && !in.touching)
             {
-                if (sPressedBtn >= 0)
+                if (G.titlePressedBtn >= 0)
                 {
-                    sound::play_sfx("menu-click", 4, 1.0f, true);
+                    play_named(G, "menu-click", 4);
                     // We treat release as valid regardless of final coords (optional: require inside)
-                    TitleBtn &tb = kTitleButtons[sPressedBtn];
+                    const TitleBtn &tb = kTitleButtons[G.titlePressedBtn];
                     if (tb.isExit)
                     {
-                        g_exitRequested = true;
+                        G.exitRequested = true;
                         hw_log("exit (button)\n");
                         G.prevTouching = in.touching;
                         return;
@@ -1674,46 +1920,41 @@ namespace game
                         // Reset balls to a single parked ball locked to the bat
                         G.balls.clear();
                         {
-                            float ballStartX = kScreenWidth * 0.5f + kPlayfieldOffsetX - kInitialBallHalf;
+                            real ballStartX = kScreenWidth * 0.5f + kPlayfieldOffsetX - kInitialBallHalf;
                             int gapPx = options::hinge_gap_px();
-                            G.balls.push_back({ballStartX, kInitialBallY + gapPx, 0.0f, 0.f, ballStartX, kInitialBallY + gapPx, true, false, G.imgBall});
+                            G.balls.add(ballStartX, kInitialBallY + gapPx, 0.0f, 0.f, false);
                         }
                         G.ballLocked = true;
-                        set_bat_size(1);
+                        set_bat_size(G, 1);
                         // Reset score/timers and transient objects
                         G.score = 0;
                         G.bonusBits = 0;
-                        G.reverseTimer = G.lightsOffTimer = G.murderTimer = 0;
-                        G.fireCooldown = 0;
+                        G.murderTimer = 0;
+                        stop_effect_timers(G);
                         G.letters.clear();
                         G.hazards.clear();
                         // Reinitialize moving bricks data for current layout
-                        {
-                            int totalCells = levels_grid_width() * levels_grid_height();
-                            G.moving.assign(totalCells, {-1.f, 1.f, 0.f, 0.f});
-                        }
-                        G.levelIntroTimer = 90;
+                        reset_moving_bricks(G);
+                        start_timer(G, TimerId::LevelIntro, 90);
                     }
                     if (tb.next == Mode::Options)
                         options::begin();
                     G.mode = tb.next;
                     // Ensure touch edge bookkeeping so first playing frame doesn't consider earlier press
                     G.prevTouching = false;
-                    sPressedBtn = -1;
+                    G.titlePressedBtn = -1;
                     return;
                 }
             }
             // Cycle sequence if user idle
-            if (++seqTimer > kSeqDelayFrames)
-            {
-                seqTimer = 0;
-                seqPos = (seqPos + 1) % (int)(sizeof(kSequence) / sizeof(kSequence[0]));
-            }
+            run_scheduled_events(G);
+            if (!timer_active(G, TimerId::TitleCycle))
+                start_timer(G, TimerId::TitleCycle, kSeqDelayFrames + 1);
             G.prevTouching = in.touching; // update before early return
             return;
         }
     // Update Game Over sequence regardless of mode, but it only activates from Playing
-    update_game_over();
+    update_game_over(G);
 
     if (G.mode == Mode::Options)
         {
@@ -1730,29 +1971,28 @@ namespace game
                 // Initialize a fresh play session specifically for editor test runs
                 G.balls.clear();
                         {
-                            float ballStartX = kScreenWidth * 0.5f + kPlayfieldOffsetX - kInitialBallHalf;
+                            real ballStartX = kScreenWidth * 0.5f + kPlayfieldOffsetX - kInitialBallHalf;
                             int gapPx = options::hinge_gap_px();
-                            G.balls.push_back({ballStartX, kInitialBallY + gapPx, 0.0f, 0.f, ballStartX, kInitialBallY + gapPx, true, false, G.imgBall});
+                            G.balls.add(ballStartX, kInitialBallY + gapPx, 0.0f, 0.f, false);
                         }
                 G.ballLocked = true;
                 G.lives = 3; // ensure lives reset (updated default)
-                set_bat_size(1);
+                set_bat_size(G, 1);
                 G.score = 0;
                 G.bonusBits = 0;
-                G.reverseTimer = G.lightsOffTimer = G.murderTimer = 0;
-                G.fireCooldown = 0;
+                G.murderTimer = 0;
+                stop_effect_timers(G);
                 G.letters.clear();
                 G.hazards.clear();
                 // Reset Tilt state (new level from title/debug)
                 G.framesSinceBarrierHit = 0;
                 G.tiltAvailable = false;
-                G.tiltCooldownFrames = 0;
-                G.tiltShakeTimer = 0;
+                stop_timer(G, TimerId::TiltCooldown);
+                stop_timer(G, TimerId::TiltShake);
                 // Reinitialize moving bricks data for current layout
-                int totalCells = levels_grid_width() * levels_grid_height();
-                G.moving.assign(totalCells, {-1.f, 1.f, 0.f, 0.f});
+                reset_moving_bricks(G);
                 hw_log("TEST init session\n");
-                G.levelIntroTimer = 90; // reuse generic intro timer (editor fade overlay still draws if active)
+                start_timer(G, TimerId::LevelIntro, 90); // reuse generic intro timer (editor fade overlay still draws if active)
                 // Important: reset touch edge so the release of the Test button doesn't auto-launch
                 G.prevTouching = false;
                 G.mode = Mode::Playing; return; }
@@ -1763,8 +2003,7 @@ namespace game
 #ifdef __3DS__
         // In play mode, if test session launched from editor and all required bricks gone, auto-return.
         if (G.mode == Mode::Playing && editor::test_return_active() && !editor::test_grace_active()) {
-            int req=0; for(int r=0;r<kBrickRows;++r){ for(int c=0;c<kBrickCols;++c){ int raw=levels_brick_at(c,r); if(raw<=0) continue; BrickType bt=(BrickType)raw; if(bt==BrickType::YB||bt==BrickType::GB||bt==BrickType::CB||bt==BrickType::TB||bt==BrickType::PB||bt==BrickType::RB||bt==BrickType::SS) ++req; }}
-            if(req==0) {
+            if(levels_remaining_required()==0) {
                 levels_reset_level(editor::current_level_index());
                 editor::on_return_from_test_full();
                 G.mode = Mode::Editor;
@@ -1775,7 +2014,7 @@ namespace game
 #endif
         // If Game Over active, allow finalize via A/Start after hold but continue to render overlay later
         if (G.gameOverActive && G.gameOverPhase >= 1 && (in.aPressed || in.startPressed)) {
-            finalize_game_over();
+            finalize_game_over(G);
         }
 #if defined(DEBUG) && DEBUG
         // Debug level switching (L previous, R next)
@@ -1794,39 +2033,39 @@ namespace game
                 // Reset game state (fresh start)
                 G.balls.clear();
                 {
-                    float ballStartX = kScreenWidth * 0.5f + kPlayfieldOffsetX - kInitialBallHalf;
-                    G.balls.push_back(Ball{ballStartX, kInitialBallY, 0.0f, 0.f, ballStartX, kInitialBallY, true, false, G.imgBall});
+                    real ballStartX = kScreenWidth * 0.5f + kPlayfieldOffsetX - kInitialBallHalf;
+                    G.balls.add(ballStartX, kInitialBallY, 0.0f, 0.f, false);
                 }
                 G.ballLocked = true;
                 G.lives = 3; // reset lives when starting from Title
                 G.score = 0;
                 G.bonusBits = 0;
-                G.reverseTimer = G.lightsOffTimer = G.murderTimer = 0;
-                G.fireCooldown = 0;
+                G.murderTimer = 0;
+                stop_effect_timers(G);
                 G.letters.clear();
                 G.hazards.clear();
                 // Re-init moving brick arrays for new layout
-                int totalCells = levels_grid_width() * levels_grid_height();
-                G.moving.assign(totalCells, {-1.f, 1.f, 0.f, 0.f});
+                reset_moving_bricks(G);
                 hw_log("DEBUG: level switched\n");
-                G.levelIntroTimer = 90;
+                start_timer(G, TimerId::LevelIntro, 90);
             }
         }
+        if (G.mode == Mode::Playing && in.lHeld && in.rHeld && in.aPressed && !G.deathActive && !G.gameOverActive)
+            spawn_ball_stress(G);
 #endif
-        // Process bomb chain before physics so collisions see updated board
-        process_bomb_events();
+        // Fire due bomb detonations and timers before physics so collisions see the updated board
+        run_scheduled_events(G);
         // Update Tilt availability timing
         if (G.mode == Mode::Playing && !G.gameOverActive) {
             if (G.framesSinceBarrierHit < kTiltAvailabilityFrames + 1) ++G.framesSinceBarrierHit;
             if (!G.tiltAvailable && G.framesSinceBarrierHit >= kTiltAvailabilityFrames) G.tiltAvailable = true;
-            if (G.tiltCooldownFrames > 0) --G.tiltCooldownFrames;
         }
         // Stylus drag controls bat X (relative). Disabled during death sequence.
         if (!G.deathActive) {
             if (in.touchPressed)
             {
                 G.dragging = true;
-                G.dragAnchorStylusX = (float)in.stylusX;
+                G.dragAnchorStylusX = (real)in.stylusX;
                 G.dragAnchorBatX = G.bat.x;
             }
             if (!in.touching)
@@ -1836,11 +2075,11 @@ namespace game
             if (G.dragging && in.touching)
             {
                 G.prevBatX = G.bat.x; // record before applying delta
-                float curStylusX = (float)in.stylusX;
-                float dx = curStylusX - G.dragAnchorStylusX;
-                if (G.reverseTimer > 0)
+                real curStylusX = (real)in.stylusX;
+                real dx = curStylusX - G.dragAnchorStylusX;
+                if (timer_active(G, TimerId::Reverse))
                     dx = -dx; // reverse control effect
-                float targetX = G.dragAnchorBatX + dx;
+                real targetX = G.dragAnchorBatX + dx;
                 if (targetX < kPlayfieldLeftWallX)
                     targetX = kPlayfieldLeftWallX;
                 if (targetX > kPlayfieldRightWallX - G.bat.width)
@@ -1851,114 +2090,81 @@ namespace game
     // Fire laser on input edge: D-Pad Up, or stylus release (disabled during death sequence)
     // Suppress in the brief editor test grace window to avoid accidental fire from Test tap
     if (!G.deathActive && !editor::test_grace_active() && (in.dpadUpPressed || (G.prevTouching && !in.touching)))
-            fire_laser();
+            fire_laser(G);
     // Tilt activation via D-Pad Down
-    if (G.mode == Mode::Playing && G.tiltAvailable && !G.gameOverActive && in.dpadDownPressed) {
-        for (auto &b : G.balls) if (b.active) {
-            float speed = std::sqrt(b.vx*b.vx + b.vy*b.vy);
+    if (G.mode == Mode::Playing && G.tiltAvailable && !G.gameOverActive && in.dpadDownPressed &&
+        !timer_active(G, TimerId::TiltCooldown)) {
+        for (int bi = 0; bi < G.balls.size(); ++bi) if (G.balls.active(bi)) {
+            Ball b = ball_at(G, bi);
+            real speed = sim::length(b.vx, b.vy);
             if (speed < 0.01f) continue;
-            uint32_t seed = (uint32_t)((uint32_t)(b.x*23) ^ (uint32_t)(b.y*37) ^ (uint32_t)G.framesSinceBarrierHit * 2654435761u);
+            uint32_t seed = (uint32_t)((uint32_t)sim::trunc_int(b.x*23) ^ (uint32_t)sim::trunc_int(b.y*37) ^ (uint32_t)G.framesSinceBarrierHit * 2654435761u) ^ G.seed;
             seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5;
-            float rnd = (seed & 0xFFFF) / 65535.0f;
-            float jitter = (rnd * 2.0f - 1.0f) * (kTiltAngleJitter * 1.5f); // stronger angle change for feedback
-            float ang = std::atan2(b.vy, b.vx) + jitter;
-            float newSpeed = std::max(speed * 1.15f, kTiltMinSpeed); // stronger speed boost
-            b.vx = std::cos(ang) * newSpeed;
-            b.vy = std::sin(ang) * newSpeed;
+            real rnd = (seed & 0xFFFF) / 65535.0f;
+            real jitter = (rnd * 2.0f - 1.0f) * (kTiltAngleJitter * 1.5f); // stronger angle change for feedback
+            real ang = sim::atan2(b.vy, b.vx) + jitter;
+            real newSpeed = sim::max(speed * 1.15f, kTiltMinSpeed); // stronger speed boost
+            b.vx = sim::cos(ang) * newSpeed;
+            b.vy = sim::sin(ang) * newSpeed;
         }
         G.tiltAvailable = false;
         G.framesSinceBarrierHit = 0;
-        G.tiltCooldownFrames = 30;
-        G.tiltShakeTimer = kTiltShakeFrames;
+        start_timer(G, TimerId::TiltCooldown, 30);
+        start_timer(G, TimerId::TiltShake, kTiltShakeFrames);
         hw_log("TILT used\n");
-        sound::play_sfx("hit-hard", 1, 1.0f, true);
+        play_named(G, "hit-hard", 1);
     }
-    if (!G.deathActive && !G.gameOverActive) update_lasers();
-    if (G.reverseTimer > 0)
-            --G.reverseTimer;
-        if (G.lightsOffTimer > 0)
-            --G.lightsOffTimer;
+    if (!G.deathActive && !G.gameOverActive) update_lasers(G);
     // per-ball murder behavior; no global timer countdown needed
-    if (!G.deathActive && !G.gameOverActive) update_moving_bricks();
-    if (!G.deathActive && !G.gameOverActive) update_bonus_letters();
-    if (!G.deathActive && !G.gameOverActive) update_falling_hazards();
-    update_death_sequence();
-        // Update particles
-        for (auto &p : G.particles)
+    if (!G.deathActive && !G.gameOverActive) update_moving_bricks(G);
+    if (!G.deathActive && !G.gameOverActive) update_bonus_letters(G);
+    if (!G.deathActive && !G.gameOverActive) update_falling_hazards(G);
+    update_death_sequence(G);
+        // Update particles (slight gravity); expired ones leave the pool here
+        G.particles.integrate(0.02f);
+        // Update ball(s): park the locked primary ball, integrate and wall-bounce the rest in one
+        // pass over the SoA store, then run per-ball barrier/bat/brick checks.
+        // Index-based so balls spawned mid-frame (queued) cannot invalidate references.
+#if defined(DEBUG) && DEBUG
+        uint64_t ballT0 = hw_ticks();
+#endif
+        const bool parkPrimary = !G.balls.empty() && G.balls.active(0) && G.ballLocked;
+        if (parkPrimary)
         {
-            if (p.life <= 0)
+            Ball b = ball_at(G, 0);
+            b.x = G.bat.x + G.bat.width * 0.5f - kBallW * 0.5f;
+            b.y = G.bat.y - kBallH - 1; // small gap
+            b.px = b.x;
+            b.py = b.y;
+            b.vx = 0.f;
+            b.vy = 0.f;
+        }
+        // Wall and ceiling bounces share the brick-hit sound (channel 1); one play covers the batch
+        if (balls::integrate<real>(G.balls, parkPrimary ? 1 : 0, kPlayfieldLeftWallX,
+                                   kPlayfieldRightWallX - kBallW, kPlayfieldTopWallY) > 0)
+            emit_sound(G, Sfx::BallBrick);
+        // Counted once per frame and kept current as balls drop out below
+        balls::Counts ballCounts = balls::count(G.balls);
+        for (int bi = parkPrimary ? 1 : 0; bi < G.balls.size(); ++bi) {
+            if (!G.balls.active(bi))
                 continue;
-            p.x += p.vx;
-            p.y += p.vy;
-            p.vy += 0.02f; // slight gravity
-            p.life--;
-        }
-        // Compact occasionally
-        if ((int)G.particles.size() > 256)
-        {
-            G.particles.erase(std::remove_if(G.particles.begin(), G.particles.end(), [](const Particle &p)
-                                             { return p.life <= 0; }),
-                              G.particles.end());
-        }
-        // Update ball(s) - use index-based loop to avoid iterator invalidation when spawning new balls mid-frame
-        for (size_t bi = 0; bi < G.balls.size(); ++bi) {
-            Ball &b = G.balls[bi];
-            if (b.active)
+            Ball b = ball_at(G, bi);
             {
-                // If primary ball is locked, keep it attached to bat and skip physics
-                        if (&b == &G.balls[0] && G.ballLocked)
-                        {
-                            b.x = G.bat.x + G.bat.width * 0.5f - kBallW * 0.5f;
-                            b.y = G.bat.y - kBallH - 1; // small gap
-                            b.px = b.x;
-                            b.py = b.y;
-                            b.vx = 0.f;
-                            b.vy = 0.f;
-                            continue; // parked
-                        }
-                b.px = b.x;
-                b.py = b.y;
-                b.x += b.vx;
-                b.y += b.vy;
-                // simple wall bounce using parametric playfield bounds.
-                if (b.x < kPlayfieldLeftWallX)
-                {
-                    b.x = kPlayfieldLeftWallX;
-                    b.vx = -b.vx;
-                    // Wall bounce SFX uses the same brick-hit sound (channel 1)
-                    sound::play_sfx("ball-brick", 1, 1.0f, true);
-                }
-                if (b.x > kPlayfieldRightWallX - kBallW)
-                {
-                    b.x = kPlayfieldRightWallX - kBallW;
-                    b.vx = -b.vx;
-                    // Wall bounce SFX
-                    sound::play_sfx("ball-brick", 1, 1.0f, true);
-                }
-                if (b.y < kPlayfieldTopWallY)
-                {
-                    b.y = kPlayfieldTopWallY;
-                    b.vy = -b.vy;
-                    // Ceiling bounce SFX
-                    sound::play_sfx("ball-brick", 1, 1.0f, true);
-                }
                 // Barrier life: if there's exactly one regular ball and lives>0, bounce off a barrier below the bat and lose a life
                 {
-                    // Count active regular (non-murder) balls
-                    int regActive = 0;
-                    for (const auto &bb : G.balls) if (bb.active && !bb.isMurder) ++regActive;
+                    int regActive = ballCounts.regular;
                     // Unified barrier collision condition
-                    if (barrier_collides() && regActive == 1 && !b.isMurder && b.vy > 0)
+                    if (barrier_collides(G) && regActive == 1 && !b.isMurder() && b.vy > 0)
                     {
                         // Compute barrier top Y using layout-configured offset
-                        float effBatH = (G.bat.img.subtex ? G.bat.img.subtex->height : G.bat.height);
-                        float barrierTopY = (G.bat.y + effBatH + layout::BARRIER_OFFSET_BELOW_BAT);
+                        real effBatH = (G.bat.img.subtex ? G.bat.img.subtex->height : G.bat.height);
+                        real barrierTopY = (G.bat.y + effBatH + layout::BARRIER_OFFSET_BELOW_BAT);
                         // Compute logical ball bottom previous and current positions (account for sprite vs collider size)
-                        float spriteH = (b.img.subtex ? b.img.subtex->height : (float)kBallH);
-                        float ballTopPrev = b.py + (spriteH - (float)kBallH) * 0.5f;
-                        float ballBottomPrev = ballTopPrev + (float)kBallH;
-                        float ballTop = b.y + (spriteH - (float)kBallH) * 0.5f;
-                        float ballBottom = ballTop + (float)kBallH;
+                        real spriteH = ball_sprite_h(G, b);
+                        real ballTopPrev = b.py + (spriteH - (real)kBallH) * 0.5f;
+                        real ballBottomPrev = ballTopPrev + (real)kBallH;
+                        real ballTop = b.y + (spriteH - (real)kBallH) * 0.5f;
+                        real ballBottom = ballTop + (real)kBallH;
                         bool crossedBarrier = (ballBottomPrev <= barrierTopY && ballBottom >= barrierTopY);
                         if (crossedBarrier)
                         {
@@ -1968,12 +2174,12 @@ namespace game
                                 // Consume life first so tint matches the new barrier state (green/orange/red)
                                 G.lives--;
                                 // Play barrier hit SFX (channel 2 reserved for barrier events)
-                                sound::play_sfx("barrier-hit", 2, 1.0f, true);
+                                emit_sound(G, Sfx::BarrierHit);
                                 // Trigger white glow for a short duration
-                                G.barrierGlowTimer = kBarrierGlowFrames;
+                                start_timer(G, TimerId::BarrierGlow, kBarrierGlowFrames);
                             }
                             // Reflect the ball off the barrier and place it just above the barrier
-                            float adjust = (ballBottom - barrierTopY);
+                            real adjust = (ballBottom - barrierTopY);
                             b.y -= adjust;
                             b.vy = -b.vy;
                             // Do not process bottom loss this frame
@@ -1982,17 +2188,15 @@ namespace game
                     }
                 }
                 // bottom: lose life (only applies when no barrier is active or ball skipped it)
-                if (b.y > 480.0f + (float)options::hinge_gap_px())
+                if (b.y > 480.0f + (real)options::hinge_gap_px())
                 {
                     // Only lose a life if this was the last active ball.
-                    int activeCount = 0;
-                    for (const auto &bb : G.balls)
-                        if (bb.active)
-                            ++activeCount;
-                    if (activeCount > 1)
+                    if (ballCounts.active > 1)
                     {
                         // Deactivate this ball; others continue. No life lost.
-                        b.active = false;
+                        b.deactivate();
+                        --ballCounts.active;
+                        if (!b.isMurder()) --ballCounts.regular;
                         continue;
                     }
                     G.lives--;
@@ -2005,7 +2209,7 @@ namespace game
                             return;
                         }
                         // Begin the new game-over sequence instead of immediate reset
-                        begin_game_over();
+                        begin_game_over(G);
                         return;
                     }
                     b.x = G.bat.x + G.bat.width * 0.5f - kBallW * 0.5f;
@@ -2014,7 +2218,7 @@ namespace game
                     b.py = b.y;
                     b.vx = 0;
                     b.vy = 0.f;
-                    if (&b == &G.balls[0])
+                    if (bi == 0)
                         G.ballLocked = true; // relock primary ball after life loss
                     // Lose laser on life loss
                     G.laserEnabled = false;
@@ -2027,31 +2231,31 @@ namespace game
                     constexpr float ballCollW = (float)kBallW;  // logical collision width
                     constexpr float ballCollH = (float)kBallH;  // logical collision height
                     // Align logical collision box centered within the ACTUAL rendered sprite (handles atlas trims)
-                    float spriteW = (b.img.subtex ? b.img.subtex->width : 8.f);
-                    float spriteH = (b.img.subtex ? b.img.subtex->height : 8.f);
-                    float ballCenterX = b.x + spriteW * 0.5f;
-                    float ballCenterYPrev = b.py + spriteH * 0.5f;
-                    float ballCenterY = b.y + spriteH * 0.5f;
-                    float ballHalfW = ballCollW * 0.5f;
-                    float ballHalfH = ballCollH * 0.5f;
-                    float ballBottomPrev = ballCenterYPrev + ballHalfH;
-                    float ballBottom = ballCenterY + ballHalfH;
+                    real spriteW = ball_sprite_w(G, b);
+                    real spriteH = ball_sprite_h(G, b);
+                    real ballCenterX = b.x + spriteW * 0.5f;
+                    real ballCenterYPrev = b.py + spriteH * 0.5f;
+                    real ballCenterY = b.y + spriteH * 0.5f;
+                    real ballHalfW = ballCollW * 0.5f;
+                    real ballHalfH = ballCollH * 0.5f;
+                    real ballBottomPrev = ballCenterYPrev + ballHalfH;
+                    real ballBottom = ballCenterY + ballHalfH;
                     // Bat effective rectangle: centered reduced width (batCollWidth) and legacy height
-                    float effBatW = G.batCollWidth;
-                    float effBatH = (G.bat.img.subtex ? G.bat.img.subtex->height : G.bat.height);
-                    float batPadX = (G.bat.width - effBatW) * 0.5f;
+                    real effBatW = G.batCollWidth;
+                    real effBatH = (G.bat.img.subtex ? G.bat.img.subtex->height : G.bat.height);
+                    real batPadX = (G.bat.width - effBatW) * 0.5f;
                     if (batPadX < 0)
                         batPadX = 0;
                     // Center the logical (legacy) bat height within the rendered sprite height
-                    float batPadY = (G.bat.height - effBatH) * 0.5f;
+                    real batPadY = (G.bat.height - effBatH) * 0.5f;
                     if (batPadY < 0)
                         batPadY = 0;
-                    float batTop = (G.bat.y + batPadY); // logical top surface (no gap offset)
-                    float batLeft = G.bat.x + batPadX;
+                    real batTop = (G.bat.y + batPadY); // logical top surface (no gap offset)
+                    real batLeft = G.bat.x + batPadX;
                     // Full sprite bounds for broad-phase (avoid off-by-one visual mismatch)
-                    float atlasLeft = (G.bat.img.subtex ? G.bat.img.subtex->left : 0.0f);
-                    float fullLeft = G.bat.x - atlasLeft;
-                    float fullRight = fullLeft + G.bat.width;
+                    real atlasLeft = (G.bat.img.subtex ? G.bat.img.subtex->left : 0.0f);
+                    real fullLeft = G.bat.x - atlasLeft;
+                    real fullRight = fullLeft + G.bat.width;
                     // Detect crossing of the bat top line this frame (sweep)
                     bool horizOverlap = (ballCenterX + ballHalfW) > fullLeft && (ballCenterX - ballHalfW) < fullRight;
                     bool crossedTop = (ballBottomPrev <= batTop && ballBottom >= batTop);
@@ -2059,31 +2263,33 @@ namespace game
                     bool enteredFromAbove = (ballCenterYPrev <= batTop && (ballCenterY + ballHalfH) >= batTop * 0.999f);
                     if (horizOverlap && (crossedTop || enteredFromAbove))
                     {
-                        if (b.isMurder) {
+                        if (b.isMurder()) {
                             // Murderball kills on bat hit
-                            begin_death_sequence();
-                            b.active = false; // remove this ball; death sequence takes over
+                            begin_death_sequence(G);
+                            b.deactivate(); // remove this ball; death sequence takes over
+                            // The death / game-over start may have stopped every ball, so recount
+                            ballCounts = balls::count(G.balls);
                             continue;
                         }
                         // Normal ball hits the bat: play SFX (exclude Murderball)
                         // Reset Tilt availability timer on bat hit
                         G.framesSinceBarrierHit = 0;
                         G.tiltAvailable = false;
-                        sound::play_sfx("ball-bat", 0, 1.0f, true);
+                        emit_sound(G, Sfx::BallBat);
                         // Place ball just above logical top using full rendered sprite alignment
-                        float adjust = (ballBottom - batTop);
+                        real adjust = (ballBottom - batTop);
                         b.y -= adjust; // shift up so that logical bottom sits on top line
                         b.vy = -b.vy;
                         // Angle based on horizontal offset inside effective bat width
-                        float rel = (ballCenterX - (batLeft + effBatW * 0.5f)) / (effBatW * 0.5f);
+                        real rel = (ballCenterX - (batLeft + effBatW * 0.5f)) / (effBatW * 0.5f);
                         if (rel < -1.f)
                             rel = -1.f;
                         if (rel > 1.f)
                             rel = 1.f;
                         // Base horizontal component from relative position
-                        float baseVX = rel * 2.0f;
+                        real baseVX = rel * 2.0f;
                         // Add momentum imparted by bat movement this frame
-                        float batDX = G.bat.x - G.prevBatX;
+                        real batDX = G.bat.x - G.prevBatX;
                         baseVX += batDX * 0.08f; // tuning factor from legacy feel approximation
                         // Clamp to reasonable range
                         if (baseVX < -3.f)
@@ -2093,28 +2299,21 @@ namespace game
                         b.vx = baseVX;
                     }
                 }
-                handle_ball_bricks(b);
+                handle_ball_bricks(G, b);
             }
         }
+#if defined(DEBUG) && DEBUG
+        note_ball_cost(G, hw_ticks() - ballT0);
+#endif
+        // Side effects of this tick's hits (may queue split balls, so before the spawns below)
+        drain_frame_events(G);
         // Process deferred ball spawns now (reuse inactive slots first)
         if (!G.spawnQueue.empty()) {
-            for (const auto &req : G.spawnQueue) {
-                bool reused = false;
-                for (auto &bb : G.balls) {
-                    if (!bb.active) {
-                        bb.x = req.x; bb.y = req.y; bb.px = req.x; bb.py = req.y;
-                        bb.vx = req.vx; bb.vy = req.vy; bb.active = true;
-                        bb.isMurder = req.isMurder; bb.img = req.isMurder ? G.imgMurderBall : G.imgBall;
-                        reused = true;
-                        break;
-                    }
-                }
-                if (!reused) {
-                    G.balls.push_back(Ball{req.x, req.y, req.vx, req.vy, req.x, req.y, true, req.isMurder, req.isMurder ? G.imgMurderBall : G.imgBall});
-                }
-            }
+            for (const auto &req : G.spawnQueue)
+                G.balls.add(req.x, req.y, req.vx, req.vy, req.isMurder);
             G.spawnQueue.clear();
         }
+        advance_if_level_complete(G);
         // Fire (D-Pad Up) could spawn extra balls later
         if (in.fireHeld && G.balls.size() < 3)
         {
@@ -2126,81 +2325,105 @@ namespace game
         {
             // Only allow launching if we have seen a touch while locked and now see its release.
             // prevTouching tracks global previous frame, but we only care about transitions that happen after lock.
-            static bool sawTouchWhileLocked = false; // function-static: persists across frames; reset when unlocked
-        if (!sawTouchWhileLocked && in.touching)
-                sawTouchWhileLocked = true; // first touch since lock
+        if (!G.sawTouchWhileLocked && in.touching)
+                G.sawTouchWhileLocked = true; // first touch since lock
         // During the editor test grace window, do not consider releases to prevent auto-launch
-        bool released = !editor::test_grace_active() && sawTouchWhileLocked && G.prevTouching && !in.touching; // release of that touch
+        bool released = !editor::test_grace_active() && G.sawTouchWhileLocked && G.prevTouching && !in.touching; // release of that touch
             if (released)
             {
                 if (!G.balls.empty())
                 {
-                    Ball &b0 = G.balls[0];
+                    Ball b0 = ball_at(G, 0);
                     b0.vy = -1.5f;
-                    float batDX = G.bat.x - G.prevBatX;
+                    real batDX = G.bat.x - G.prevBatX;
             // Clamp initial horizontal influence to avoid extremely shallow angles on quick taps
-            float vx0 = batDX * 0.15f;
+            real vx0 = batDX * 0.15f;
             if (vx0 < -1.0f) vx0 = -1.0f;
             if (vx0 >  1.0f) vx0 =  1.0f;
             b0.vx = vx0;
                     // Apply per-level speed to initial launch velocity (both axes)
-                    float mul = level_speed_multiplier();
+                    real mul = level_speed_multiplier();
                     b0.vx *= mul;
                     b0.vy *= mul;
                 }
                 G.ballLocked = false;
-                sawTouchWhileLocked = false; // reset for next time we lock
+                G.sawTouchWhileLocked = false; // reset for next time we lock
             }
             if (!G.ballLocked)
-                sawTouchWhileLocked = false; // safety
+                G.sawTouchWhileLocked = false; // safety
         }
     G.prevTouching = in.touching;
     // Advance editor test grace countdown if active
     if (editor::test_grace_active()) editor::tick_test_grace();
     }
 
-    void render()
+    // Assist aim guide (Options > Aim Guide): dotted predicted path of each moving ball and a
+    // marker where it will meet the bat line. topScreen draws world y < 240 with the top-screen
+    // x offset; otherwise world y >= 240 + gap, mapped like the other bottom-screen objects.
+    static void draw_aim_guide(const State &G, bool topScreen, int shakeX, int shakeY, int gapPx)
+    {
+        if (!options::is_aim_guide_enabled()) return;
+        HwDrawScope scope("aim-guide");
+        const float kDotSpacing = 6.0f;
+        const uint32_t dotCol = C2D_Color32(255, 255, 255, 110);
+        const uint32_t markCol = C2D_Color32(255, 220, 0, 200);
+        auto plot = [&](float x, float y, float w, float h, uint32_t col) {
+            if (topScreen) {
+                if (y >= 240.0f) return;
+                C2D_DrawRectSolid(x + kTopXOffset + shakeX, y + shakeY, 0, w, h, col);
+            } else {
+                if (y < 240.0f + gapPx) return;
+                C2D_DrawRectSolid(x + shakeX, y - (240.0f + gapPx) + shakeY, 0, w, h, col);
+            }
+        };
+        int drawn = 0;
+        for (int bi = 0; bi < G.balls.size() && drawn < kAimGuideBalls; ++bi) {
+            if (!G.balls.active(bi) || (bi == 0 && G.ballLocked)) continue;
+            const trajectory::Path<real> &p = predict_trajectory(G, bi, kAimGuideBounces);
+            if (p.points < 2) continue;
+            ++drawn;
+            for (int k = 0; k + 1 < p.points; ++k) {
+                float x0 = sim::to_float(p.x[k]), y0 = sim::to_float(p.y[k]);
+                float dx = sim::to_float(p.x[k + 1]) - x0, dy = sim::to_float(p.y[k + 1]) - y0;
+                float len = std::sqrt(dx * dx + dy * dy);
+                for (float d = kDotSpacing; d < len; d += kDotSpacing)
+                    plot(x0 + dx * (d / len) - 1.0f, y0 + dy * (d / len) - 1.0f, 2, 2, dotCol);
+            }
+            if (p.reachesBat) {
+                // Short bar on the bat's top surface, centred on the crossing
+                float mx = sim::to_float(p.batX), my = sim::to_float(p.y[p.points - 1]) + kBallH * 0.5f;
+                plot(mx - 3.0f, my - 1.0f, 7, 2, markCol);
+            }
+        }
+    }
+
+    void render(const State &G)
     {
+    HwDrawScope scope("game");
     // --- Tilt screen shake offsets (applied to bricks & gameplay objects) ---
     int shakeX = 0, shakeY = 0;
-    if (G.tiltShakeTimer > 0) {
-        float t = (float)G.tiltShakeTimer / (float)kTiltShakeFrames; // 1..0
+    const int shakeLeft = timer_left(G, TimerId::TiltShake);
+    if (shakeLeft > 0) {
+        float t = (float)shakeLeft / (float)kTiltShakeFrames; // 1..0
         float mag = kTiltShakeStartMag * t;
-        uint32_t s = (uint32_t)G.tiltShakeTimer * 2246822519u + 3266489917u;
+        // Simple deterministic pseudo-random offset per tick based on remaining time
+        uint32_t s = (uint32_t)shakeLeft * 2246822519u + 3266489917u;
         s ^= s >> 13; s ^= s << 17; s ^= s >> 5;
         float rx = ((s & 0xFFFF) / 65535.0f) * 2.f - 1.f;
         float ry = (((s >> 16) & 0xFFFF) / 65535.0f) * 2.f - 1.f;
         shakeX = (int)std::round(rx * mag);
         shakeY = (int)std::round(ry * mag * 0.6f); // less vertical movement
-        --G.tiltShakeTimer;
     }
     // Ensure correct brick horizontal offset per mode (no background-aligned shift anymore)
     int desiredOffset = 0; // gameplay and editor both use base left now
-    if (levels_get_draw_offset() != desiredOffset) levels_set_draw_offset(desiredOffset);
     // Apply screen shake (tilt) before any world-space rendering (affects bricks & top HUD world elements)
-    if (G.tiltShakeTimer > 0) {
-        float t = (float)G.tiltShakeTimer / (float)kTiltShakeFrames; // 1..0
-        float mag = kTiltShakeStartMag * t;
-        // Simple deterministic pseudo-random each frame based on remaining timer
-        uint32_t s = (uint32_t)G.tiltShakeTimer * 2246822519u + 3266489917u;
-        s ^= s >> 13; s ^= s << 17; s ^= s >> 5;
-        float rx = ((s & 0xFFFF) / 65535.0f) * 2.f - 1.f;
-        float ry = (((s >> 16) & 0xFFFF) / 65535.0f) * 2.f - 1.f;
-        int shakeX = (int)std::round(rx * mag);
-        int shakeY = (int)std::round(ry * mag * 0.6f); // reduced vertical motion
-        levels_set_draw_offset(desiredOffset + shakeX);
-        levels_set_draw_offset_y(shakeY);
-        --G.tiltShakeTimer;
-        if (G.tiltShakeTimer == 0) {
-            // restore defaults after finishing
-            levels_set_draw_offset(desiredOffset);
-            levels_set_draw_offset_y(0);
-        }
-    }
+    if (levels_get_draw_offset() != desiredOffset + shakeX) levels_set_draw_offset(desiredOffset + shakeX);
+    if (levels_get_draw_offset_y() != shakeY) levels_set_draw_offset_y(shakeY);
         if (G.mode == Mode::Title)
         {
+            scope.rename("title");
             // Draw current sequence image (skip if not loaded, fallback attempts)
-            const SeqEntry &cur = kSequence[seqPos];
+            const SeqEntry &cur = kSequence[G.seqPos];
             C2D_Image img = hw_image_from(cur.sheet, cur.index);
             if (!img.tex)
             { // simple fallback chain
@@ -2213,7 +2436,7 @@ namespace game
             }
                     if (img.tex)
                 hw_draw_sprite(img, 0, 0);
-            if (kSequence[seqPos].sheet == HwSheet::High)
+            if (kSequence[G.seqPos].sheet == HwSheet::High)
             {
                 const highscores::Entry *tab = highscores::table();
                 int shown = highscores::NUM_SCORES;
@@ -2241,6 +2464,7 @@ namespace game
         // Top-screen phase (HUD and brick field). Gameplay objects are drawn on both screens appropriately.
     if (G.mode == Mode::Playing) {
             hw_set_top();
+            scope.rename("background");
         // Draw background (top screen half aligned to screen top, under the HUD)
             {
                 C2D_Image sf = hw_image_from(HwSheet::Background, BACKGROUND_idx);
@@ -2249,6 +2473,7 @@ namespace game
                 }
             }
             // Top-screen bricks pass with shake
+            scope.rename("bricks");
             levels_set_draw_offset(kTopXOffset + shakeX);
             levels_set_draw_offset_y(shakeY);
             // Fill only side borders outside the brick field (background now covers top)
@@ -2268,19 +2493,18 @@ namespace game
             }
             levels_render();
             int cols = levels_grid_width();
-            int rows = levels_grid_height();
             int ls = levels_left(); // offset-aware (includes +40)
             int ts = levels_top();
             int cw = levels_brick_width();
             int ch = levels_brick_height();
             // Draw dynamic moving bricks over static grid
-            for (int r = 0; r < rows; ++r)
-                for (int c = 0; c < cols; ++c)
+            brickgrid::GridView grid = levels_grid_view();
+            const brickgrid::Mask *movingMask = grid.valid() ? &grid.occ->moving : nullptr;
+            if (movingMask)
+                for (int idx = movingMask->next(0); idx >= 0; idx = movingMask->next(idx + 1))
                 {
-                    int raw = levels_brick_at(c, r);
-                    if (!is_moving_type(raw))
-                        continue;
-                    int idx = r * cols + c;
+                    int r = idx / cols, c = idx % cols;
+                    int raw = grid.bricks[idx];
                     int atlas = levels_atlas_index(raw);
                     if (atlas < 0)
                         continue;
@@ -2288,17 +2512,17 @@ namespace game
                     // Compute world-space X and clamp within world-space bounds, then convert to draw-space
                     int offX = levels_get_draw_offset(); // should be kTopXOffset here
                     float worldLeft = (float)(ls - offX);
-                    float xWorld = (idx < (int)G.moving.size() && G.moving[idx].pos >= 0.f) ? G.moving[idx].pos : (worldLeft + c * cw);
+                    float xWorld = (idx < (int)G.moving.size() && G.moving[idx].pos >= 0.f) ? sim::to_float(G.moving[idx].pos) : (worldLeft + c * cw);
                     if (idx < (int)G.moving.size())
                     {
                         if (xWorld < G.moving[idx].minX)
-                            xWorld = G.moving[idx].minX;
+                            xWorld = sim::to_float(G.moving[idx].minX);
                         if (xWorld > G.moving[idx].maxX)
-                            xWorld = G.moving[idx].maxX;
+                            xWorld = sim::to_float(G.moving[idx].maxX);
                     }
                     float xDraw = xWorld + offX;
                     hw_draw_sprite(hw_image(atlas), xDraw, y);
-                    if (raw == (int)BrickType::T5)
+                    if (brick_traits(raw).flags & kBrickMultiHit)
                     {
                         int hp = levels_brick_hp(c, r);
                         if (hp > 0)
@@ -2311,13 +2535,14 @@ namespace game
                     }
                 }
 #if defined(DEBUG) && DEBUG
+            int rows = levels_grid_height();
             // Debug colliders for static bricks
             for (int r = 0; r < rows; ++r)
                 for (int c = 0; c < cols; ++c)
                 {
                     int raw = levels_brick_at(c, r);
                     if (raw <= 0) continue;
-                    if (is_moving_type(raw)) continue;
+                    if (brick_traits(raw).flags & kBrickMoving) continue;
                     float bx = ls + c * cw;
                     float by = ts + r * ch;
                     C2D_DrawRectSolid(bx, by, 0, cw, 1, C2D_Color32(255, 0, 0, 200));
@@ -2330,12 +2555,12 @@ namespace game
                 for (int c = 0; c < cols; ++c)
                 {
                     int raw = levels_brick_at(c, r);
-                    if (!is_moving_type(raw)) continue;
+                    if (!(brick_traits(raw).flags & kBrickMoving)) continue;
                     int idx = r * cols + c;
                     if (idx >= (int)G.moving.size()) continue;
                     if (G.moving[idx].pos < 0.f) continue;
             int offX = levels_get_draw_offset();
-            float x = G.moving[idx].pos + offX; // draw-space X on top screen
+            float x = sim::to_float(G.moving[idx].pos) + offX; // draw-space X on top screen
             float y = ts + r * ch;
             C2D_DrawRectSolid(x, y, 0, cw, 1, C2D_Color32(255, 0, 0, 200));
             C2D_DrawRectSolid(x, y + ch - 1, 0, cw, 1, C2D_Color32(255, 0, 0, 80));
@@ -2344,10 +2569,11 @@ namespace game
                 }
 #endif
             // Light/dark overlay on top as well
-            if (G.lightsOffTimer > 0) {
+            if (timer_active(G, TimerId::LightsOff)) {
                 C2D_DrawRectSolid(0, 0, 0, 400, 240, C2D_Color32(0, 0, 0, 140));
             }
             // HUD overlay on top screen (aligned to 320px logical area via +40px offset)
+            scope.rename("hud");
             // --- Enhanced HUD ---
             // Layout: Score (left), Level (center), Bonus (right)
             const int hudHeight = layout::HUD_HEIGHT;
@@ -2401,14 +2627,14 @@ namespace game
                 hw_draw_text_shadow_scaled(livesValX, livesY, livesVal, valueColor, 0x000000FF, valueScale);
             }
             // Reverse controls indicator (right side, second line): icon + seconds remaining
-            if (G.reverseTimer > 0) {
+            if (timer_active(G, TimerId::Reverse)) {
                 // Fetch icon and compute placement
                 C2D_Image rev = hw_image(IMAGE_reverse_indicator_idx);
                 float iw = (rev.subtex ? rev.subtex->width : 10.0f);
                 float ih = (rev.subtex ? rev.subtex->height : 10.0f);
                 int lineY = scoreY + 16; // align with Lives line
                 // Seconds remaining, clamped to at least 1 if any frames remain
-                int sec = (G.reverseTimer + 59) / 60; if (sec < 1) sec = 1;
+                int sec = (timer_left(G, TimerId::Reverse) + 59) / 60; if (sec < 1) sec = 1;
                 char buf[16]; snprintf(buf, sizeof buf, "%d", sec);
                 int txtW = hw_text_width(buf) * labelScale;
                 // Right-align: [ ... icon][space][NNs ] flush to hud right (hudX+hudW)
@@ -2447,7 +2673,8 @@ namespace game
                 }
             }
             // Generic per-level intro (rendered on top now)
-            if (G.levelIntroTimer > 0)
+            scope.rename("overlay");
+            if (timer_active(G, TimerId::LevelIntro))
             {
                 C2D_DrawRectSolid(0,0,0,400,240,C2D_Color32(0,0,0,120));
                 const char *nm = levels_get_name(levels_current()); if (!nm) nm = "Level";
@@ -2456,7 +2683,6 @@ namespace game
                 int x = (int)((400 - tw * scale) * 0.5f);
                 int y = 110 + 24; // moved down 24px
                 hw_draw_text_shadow_scaled(x, y, nm, 0xFFFFFFFF, 0x000000FF, scale);
-                --G.levelIntroTimer;
             }
             // Death fade overlay (top-screen copy)
             if (G.deathActive && G.deathFadeAlpha > 0) {
@@ -2494,6 +2720,7 @@ namespace game
             levels_set_draw_offset(0);
             // Switch back to bottom for gameplay rendering
             hw_set_bottom();
+            scope.rename("background");
         // Draw background (show lower half and center 400px-wide image on 320px bottom screen)
             {
                 C2D_Image sf = hw_image_from(HwSheet::Background, BACKGROUND_idx);
@@ -2502,6 +2729,7 @@ namespace game
                 }
             }
         }
+        scope.rename("overlay");
         // Editor-specific fade overlay still displays if active (bottom screen)
         if (G.mode == Mode::Playing && editor::fade_overlay_active())
             editor::render_fade_overlay();
@@ -2544,81 +2772,98 @@ namespace game
     // Bricks are only rendered on the top screen now; bottom screen draws gameplay objects.
         // Draw world-space objects across both screens
         // Top screen pass for objects with y < 240
+        scope.rename("objects");
         hw_set_top();
-    for (auto &p : G.particles) if (p.life > 0 && p.y < 240.0f) {
-            C2D_DrawRectSolid(p.x + kTopXOffset + shakeX, p.y + shakeY, 0, 2, 2, p.color);
-        }
-        for (auto &L : G.letters) if (L.active && L.y < 240.0f) {
-            hw_draw_sprite(L.img, L.x + kTopXOffset + shakeX, L.y + shakeY);
-        }
-        for (auto &H : G.hazards) if (H.active && H.y < 240.0f) {
-            hw_draw_sprite(H.img, H.x + kTopXOffset + shakeX, H.y + shakeY);
+    {
+        const ParticlePool &P = G.particles;
+        for (int i = 0; i < P.size(); ++i) if (P.y[i] < 240.0f) {
+            C2D_DrawRectSolid(sim::to_float(P.x[i]) + kTopXOffset + shakeX, sim::to_float(P.y[i]) + shakeY, 0, 2, 2, P.color[i]);
         }
-    for (auto &b : G.balls) if (b.active && b.y < 240.0f) {
-        hw_draw_sprite(b.img, b.x + kTopXOffset + shakeX, b.y + shakeY);
+    }
+        for (auto &L : G.letters) if (L.y < 240.0f) {
+            hw_draw_sprite(hw_image(L.sprite), sim::to_float(L.x) + kTopXOffset + shakeX, sim::to_float(L.y) + shakeY);
+        }
+        for (auto &H : G.hazards) if (H.y < 240.0f) {
+            hw_draw_sprite(hw_image(H.sprite), sim::to_float(H.x) + kTopXOffset + shakeX, sim::to_float(H.y) + shakeY);
+        }
+    for (int bi = 0; bi < G.balls.size(); ++bi) {
+        if (!G.balls.active(bi)) continue;
+        float bx = ball_draw_x(G, bi), by = ball_draw_y(G, bi);
+        if (by >= 240.0f) continue;
+        const C2D_Image &img = ball_image(G, bi);
+        hw_draw_sprite(img, bx + kTopXOffset + shakeX, by + shakeY);
 #if defined(DEBUG) && DEBUG
         // Draw ball collider on top screen alongside sprite
-        float spriteW = (b.img.subtex ? b.img.subtex->width : 8.f);
-        float spriteH = (b.img.subtex ? b.img.subtex->height : 8.f);
-        float cx = b.x + spriteW * 0.5f;
-        float cy = b.y + spriteH * 0.5f;
+        float spriteW = (img.subtex ? img.subtex->width : 8.f);
+        float spriteH = (img.subtex ? img.subtex->height : 8.f);
+        float cx = bx + spriteW * 0.5f;
+        float cy = by + spriteH * 0.5f;
         float lx = cx - kBallW * 0.5f;
         float ly = cy - kBallH * 0.5f;
         C2D_DrawRectSolid(lx + kTopXOffset + shakeX, ly + shakeY, 0, kBallW, kBallH, C2D_Color32(0, 255, 0, 90));
 #endif
     }
-        for (auto &LZ : G.lasers) if (LZ.active && LZ.y < 240.0f) {
-            C2D_DrawRectSolid(LZ.x + kTopXOffset + shakeX, LZ.y + shakeY, 0, 3, 10, C2D_Color32(0,255,0,255));
+        for (auto &LZ : G.lasers) if (LZ.y < 240.0f) {
+            C2D_DrawRectSolid(sim::to_float(LZ.x) + kTopXOffset + shakeX, sim::to_float(LZ.y) + shakeY, 0, 3, 10, C2D_Color32(0,255,0,255));
         }
+        draw_aim_guide(G, true, shakeX, shakeY, 0);
     // Bottom screen pass for objects with y >= 240. We simulate the hinge gap by hiding objects whose
     // world Y is in [240, 240 + gap). Rendering uses a consistent mapping of drawY = worldY - 240 for
     // all entities so on-screen positions match collision/physics; the gap only affects visibility.
         hw_set_bottom();
     const int gapPx = options::hinge_gap_px();
-        if (G.lightsOffTimer > 0) {
+        if (timer_active(G, TimerId::LightsOff)) {
             C2D_DrawRectSolid(0, 0, 0, 320, 240, C2D_Color32(0, 0, 0, 140));
         }
-        for (auto &p : G.particles) if (p.life > 0 && p.y >= 240.0f + gapPx) {
-            C2D_DrawRectSolid(p.x + shakeX, p.y - (240.0f + gapPx) + shakeY, 0, 2, 2, p.color);
+        {
+            const ParticlePool &P = G.particles;
+            for (int i = 0; i < P.size(); ++i) if (P.y[i] >= 240.0f + gapPx) {
+                C2D_DrawRectSolid(sim::to_float(P.x[i]) + shakeX, sim::to_float(P.y[i]) - (240.0f + gapPx) + shakeY, 0, 2, 2, P.color[i]);
+            }
         }
-        for (auto &L : G.letters) if (L.active && L.y >= 240.0f + gapPx) {
-            hw_draw_sprite(L.img, L.x + shakeX, L.y - (240.0f + gapPx) + shakeY);
+        for (auto &L : G.letters) if (L.y >= 240.0f + gapPx) {
+            hw_draw_sprite(hw_image(L.sprite), sim::to_float(L.x) + shakeX, sim::to_float(L.y) - (240.0f + gapPx) + shakeY);
         }
-        for (auto &H : G.hazards) if (H.active && H.y >= 240.0f + gapPx) {
-            hw_draw_sprite(H.img, H.x + shakeX, H.y - (240.0f + gapPx) + shakeY);
+        for (auto &H : G.hazards) if (H.y >= 240.0f + gapPx) {
+            hw_draw_sprite(hw_image(H.sprite), sim::to_float(H.x) + shakeX, sim::to_float(H.y) - (240.0f + gapPx) + shakeY);
         }
-        for (auto &b : G.balls) if (b.active && b.y >= 240.0f + gapPx) {
-            hw_draw_sprite(b.img, b.x + shakeX, b.y - (240.0f + gapPx) + shakeY);
+        for (int bi = 0; bi < G.balls.size(); ++bi) {
+            if (!G.balls.active(bi)) continue;
+            float bx = ball_draw_x(G, bi), by = ball_draw_y(G, bi);
+            if (by < 240.0f + gapPx) continue;
+            const C2D_Image &img = ball_image(G, bi);
+            hw_draw_sprite(img, bx + shakeX, by - (240.0f + gapPx) + shakeY);
 #if defined(DEBUG) && DEBUG
         // Draw ball collider on bottom screen alongside sprite
-        float spriteW = (b.img.subtex ? b.img.subtex->width : 8.f);
-        float spriteH = (b.img.subtex ? b.img.subtex->height : 8.f);
-        float cx = b.x + spriteW * 0.5f;
-        float cy = b.y + spriteH * 0.5f;
+        float spriteW = (img.subtex ? img.subtex->width : 8.f);
+        float spriteH = (img.subtex ? img.subtex->height : 8.f);
+        float cx = bx + spriteW * 0.5f;
+        float cy = by + spriteH * 0.5f;
         float lx = cx - kBallW * 0.5f;
         float ly = cy - kBallH * 0.5f;
             C2D_DrawRectSolid(lx + shakeX, ly - (240.0f + gapPx) + shakeY, 0, kBallW, kBallH, C2D_Color32(0, 255, 0, 90));
 #endif
     }
-        for (auto &LZ : G.lasers) if (LZ.active && LZ.y >= 240.0f + gapPx) {
-            C2D_DrawRectSolid(LZ.x + shakeX, LZ.y - (240.0f + gapPx) + shakeY, 0, 3, 10, C2D_Color32(0,255,0,255));
+        for (auto &LZ : G.lasers) if (LZ.y >= 240.0f + gapPx) {
+            C2D_DrawRectSolid(sim::to_float(LZ.x) + shakeX, sim::to_float(LZ.y) - (240.0f + gapPx) + shakeY, 0, 3, 10, C2D_Color32(0,255,0,255));
         }
+        draw_aim_guide(G, false, shakeX, shakeY, gapPx);
         // Draw bat on bottom screen only
         {
             float batAtlasLeft = (G.bat.img.subtex ? G.bat.img.subtex->left : 0.0f);
-            float batDrawX = G.bat.x - batAtlasLeft;
+            float batDrawX = sim::to_float(G.bat.x) - batAtlasLeft;
             float gapPxF = (float)options::hinge_gap_px();
-            hw_draw_sprite(G.bat.img, batDrawX + shakeX, (G.bat.y - (240.0f + gapPxF)) + shakeY);
+            hw_draw_sprite(G.bat.img, batDrawX + shakeX, (sim::to_float(G.bat.y) - (240.0f + gapPxF)) + shakeY);
             if (G.laserEnabled && G.laserReady) {
                 C2D_Image ind = hw_image(IMAGE_laser_indicator_idx);
                 float iw = (ind.subtex ? ind.subtex->width : 6.0f);
                 float ih = (ind.subtex ? ind.subtex->height : 6.0f);
                 float scale = 2.0f; // double size
-                float centerX = G.bat.x + G.bat.width * 0.5f;
+                float centerX = sim::to_float(G.bat.x) + sim::to_float(G.bat.width) * 0.5f;
                 float scaledW = iw * scale;
                 float scaledH = ih * scale;
                 float drawX = centerX - scaledW * 0.5f;
-                float drawY = (G.bat.y - (240.0f + gapPxF)) - scaledH - 2.0f; // keep same gap
+                float drawY = (sim::to_float(G.bat.y) - (240.0f + gapPxF)) - scaledH - 2.0f; // keep same gap
                 if (drawX < kPlayfieldLeftWallX) drawX = kPlayfieldLeftWallX;
                 if (drawX + scaledW > kPlayfieldRightWallX) drawX = kPlayfieldRightWallX - scaledW;
                 C2D_DrawImageAt(ind, drawX + shakeX, drawY + shakeY, 0.0f, nullptr, scale, scale);
@@ -2627,12 +2872,12 @@ namespace game
     // Barrier line 4px high, 8px below bat. Visible for lives >= 1; hidden at 0.
     // Glow still appears even if barrier is hidden (life just dropped to 0).
     {
-        float effBatH = (G.bat.img.subtex ? G.bat.img.subtex->height : G.bat.height);
-    float barrierTopY = (G.bat.y + effBatH + layout::BARRIER_OFFSET_BELOW_BAT);
+        float effBatH = (G.bat.img.subtex ? G.bat.img.subtex->height : sim::to_float(G.bat.height));
+    float barrierTopY = (sim::to_float(G.bat.y) + effBatH + layout::BARRIER_OFFSET_BELOW_BAT);
     float barrierYBottomView = barrierTopY - (240.0f + (float)options::hinge_gap_px()); // bottom screen coords
         float leftX = (float)kPlayfieldLeftWallX;
         float width = (float)(kPlayfieldRightWallX - kPlayfieldLeftWallX);
-        if (barrier_visible())
+        if (barrier_visible(G))
         {
             uint32_t col = (G.lives >= 3) ? C2D_Color32(0, 200, 0, 200)
                              : (G.lives == 2) ? C2D_Color32(255, 165, 0, 220)
@@ -2640,10 +2885,10 @@ namespace game
             C2D_DrawRectSolid(leftX + shakeX, barrierYBottomView + shakeY, 0, width, 4.0f, col);
         }
         // Draw a momentary semi-transparent glow above the barrier if recently hit (even if barrier is now hidden at 0 lives)
-        if (G.barrierGlowTimer > 0)
+        if (timer_active(G, TimerId::BarrierGlow))
         {
             // Smooth ease-out over time for a soft fade
-            float t = (float)G.barrierGlowTimer / (float)kBarrierGlowFrames; // 0..1
+            float t = (float)timer_left(G, TimerId::BarrierGlow) / (float)kBarrierGlowFrames; // 0..1
             float ease = t * t * (3.0f - 2.0f * t); // smoothstep-like
             // Alpha gradient: brightest at the top, falling off quickly
             uint8_t a0 = (uint8_t)(160 * ease);
@@ -2657,7 +2902,6 @@ namespace game
             // Optional tiny specular line right at the edge to sell the glow
             uint8_t spec = (uint8_t)(70 * ease);
             C2D_DrawRectSolid(leftX + shakeX, glowBaseY - 3.0f + shakeY, 0, width, 1.0f, C2D_Color32(255,255,255,spec));
-            --G.barrierGlowTimer;
         }
     }
 #if defined(DEBUG) && DEBUG
@@ -2680,15 +2924,15 @@ namespace game
 #if defined(DEBUG) && DEBUG
         // Draw logical bat collision rectangle (centered reduced width & height) on bottom screen
         {
-            float effBatW = G.batCollWidth;
-            float effBatH = (G.bat.img.subtex ? G.bat.img.subtex->height : G.bat.height);
-            float batPadX = (G.bat.width - effBatW) * 0.5f;
+            float effBatW = sim::to_float(G.batCollWidth);
+            float effBatH = (G.bat.img.subtex ? G.bat.img.subtex->height : sim::to_float(G.bat.height));
+            float batPadX = (sim::to_float(G.bat.width) - effBatW) * 0.5f;
             if (batPadX < 0) batPadX = 0;
-            float batPadY = (G.bat.height - effBatH) * 0.5f;
+            float batPadY = (sim::to_float(G.bat.height) - effBatH) * 0.5f;
             if (batPadY < 0) batPadY = 0;
             float batAtlasLeft2 = (G.bat.img.subtex ? G.bat.img.subtex->left : 0.0f);
-            float batLeft2 = G.bat.x + batPadX - batAtlasLeft2;
-            float batTop2 = G.bat.y + batPadY;
+            float batLeft2 = sim::to_float(G.bat.x) + batPadX - batAtlasLeft2;
+            float batTop2 = sim::to_float(G.bat.y) + batPadY;
             C2D_DrawRectSolid(batLeft2, batTop2 - 240.0f, 0, effBatW, 1, C2D_Color32(255, 0, 0, 180));              // top line
             C2D_DrawRectSolid(batLeft2, batTop2 - 240.0f + effBatH - 1, 0, effBatW, 1, C2D_Color32(255, 0, 0, 80)); // bottom line
             C2D_DrawRectSolid(batLeft2, batTop2 - 240.0f, 0, 1, effBatH, C2D_Color32(255, 0, 0, 80));               // left
@@ -2696,31 +2940,198 @@ namespace game
         }
 #endif
     // Ball and laser drawing handled in split top/bottom passes above
-        // If in test mode (editor launched) and level ended (no breakables) or lives depleted, return to editor
-        if (editor::test_return_active() && G.mode == Mode::Playing)
-        {
-            bool levelDone = (!editor::test_grace_active());
-            if(levelDone){ int req=0; for(int r=0;r<kBrickRows;++r){ for(int c=0;c<kBrickCols;++c){ int raw=levels_brick_at(c,r); if(raw<=0) continue; BrickType bt=(BrickType)raw; if(bt==BrickType::YB||bt==BrickType::GB||bt==BrickType::CB||bt==BrickType::TB||bt==BrickType::PB||bt==BrickType::RB||bt==BrickType::SS) ++req; }} levelDone = (req==0); }
-            if (levelDone)
-            {
-                G.mode = Mode::Editor;
-                levels_set_current(editor::current_level_index());
-                editor::on_return_from_test_full();
-                hw_log("TEST return (levelDone)\n");
+    }
+}
+
+namespace game {
+    // FNV-1a over the simulation state that decides how play unfolds. Values are hashed by
+    // their bits (float or Q16.16 raw), so any divergence in a replay shows up on the tick
+    // it happens; render-only state (alpha, shake, particles) is left out.
+    struct StateHash {
+        uint32_t h = 2166136261u;
+        void u32(uint32_t v) { for (int i = 0; i < 4; ++i) { h ^= (v >> (i * 8)) & 0xFF; h *= 16777619u; } }
+#ifdef BALLISTICA_FIXED_SIM
+        void r(real v) { u32((uint32_t)v.raw); }
+#else
+        void r(real v) { uint32_t b; memcpy(&b, &v, sizeof b); u32(b); }
+#endif
+    };
+
+    static uint32_t state_hash(const State &G)
+    {
+        StateHash s;
+        s.u32((uint32_t)G.mode);
+        s.u32((uint32_t)levels_current());
+        s.u32((uint32_t)G.lives); s.u32((uint32_t)G.score); s.u32(G.bonusBits);
+        s.u32((G.ballLocked ? 1u : 0u) | (G.deathActive ? 2u : 0u) | (G.gameOverActive ? 4u : 0u) |
+              (G.laserEnabled ? 8u : 0u) | (G.tiltAvailable ? 16u : 0u));
+        s.r(G.bat.x); s.r(G.bat.y); s.r(G.batCollWidth);
+        for (int i = 0; i < G.balls.size(); ++i) {
+            if (!G.balls.active(i)) continue;
+            s.u32(G.balls.flags[i]);
+            s.r(G.balls.x[i]); s.r(G.balls.y[i]); s.r(G.balls.vx[i]); s.r(G.balls.vy[i]);
+        }
+        for (const Laser &L : G.lasers) { s.r(L.x); s.r(L.y); }
+        for (const FallingLetter &L : G.letters) { s.r(L.x); s.r(L.y); s.u32((uint32_t)L.letter); }
+        for (const FallingHazard &H : G.hazards) { s.r(H.x); s.r(H.y); s.u32((uint32_t)H.type); }
+        brickgrid::GridView grid = levels_grid_view();
+        if (grid.occ)
+            for (int w = 0; w < brickgrid::kWords; ++w) { s.u32((uint32_t)grid.occ->any.w[w]); s.u32((uint32_t)(grid.occ->any.w[w] >> 32)); }
+        return s.h;
+    }
+
+    // Ticks for ball i to follow its predicted path to the bat line (-1 if it does not get there)
+    static int ticks_to_bat(const State &G, int i)
+    {
+        const trajectory::Path<real> &p = predict_trajectory(G, i, kObserveBounces);
+        if (!p.reachesBat) return -1;
+        float speed = sim::to_float(sim::length(G.balls.vx[i], G.balls.vy[i]));
+        if (speed < 0.01f) return -1;
+        float len = 0.f;
+        for (int k = 0; k + 1 < p.points; ++k) {
+            float dx = sim::to_float(p.x[k + 1] - p.x[k]), dy = sim::to_float(p.y[k + 1] - p.y[k]);
+            len += std::sqrt(dx * dx + dy * dy);
+        }
+        return (int)(len / speed);
+    }
+
+    static void observe(const State &G, GameObservation &o)
+    {
+        o = GameObservation();
+        o.playing = G.mode == Mode::Playing;
+        o.batX = sim::to_float(G.bat.x);
+        o.batY = sim::to_float(G.bat.y);
+        o.batWidth = sim::to_float(G.bat.width);
+        o.batCollWidth = sim::to_float(G.batCollWidth);
+        o.batMinX = (float)kPlayfieldLeftWallX;
+        o.batMaxX = (float)kPlayfieldRightWallX - o.batWidth;
+        o.lives = G.lives;
+        o.level = levels_current();
+        o.levelsCompleted = G.levelsCompleted;
+        o.bricksLeft = levels_remaining_required();
+        o.brickHits = G.brickHits;
+        o.ballLocked = G.ballLocked;
+        o.deathActive = G.deathActive;
+        o.gameOver = G.gameOverActive;
+        o.tiltAvailable = G.tiltAvailable;
+        o.reverseControls = timer_active(G, TimerId::Reverse);
+        o.balls = balls::count(G.balls).active;
+        o.particles = G.particles.size();
+        float lowestY = -1.f;
+        for (int bi = 0; bi < G.balls.size(); ++bi) {
+            if (!G.balls.active(bi) || (bi == 0 && G.ballLocked)) continue;
+            const bool murder = G.balls.murder(bi);
+            const float cx = sim::to_float(G.balls.x[bi] + ball_sprite_w(G, bi) * 0.5f), y = sim::to_float(G.balls.y[bi]);
+            if (!murder && y > lowestY) { lowestY = y; o.trackX = cx; }
+            int t = ticks_to_bat(G, bi);
+            if (t < 0) continue;
+            const float x = sim::to_float(predict_trajectory(G, bi, kObserveBounces).batX);
+            if (murder) {
+                if (!o.murderLanding || t < o.murderTicks) { o.murderLanding = true; o.murderX = x; o.murderTicks = t; }
+            } else if (!o.landing || t < o.landingTicks) {
+                o.landing = true; o.landingX = x; o.landingTicks = t;
             }
         }
-        // Tick grace after all logic
-        if (editor::test_grace_active()) editor::tick_test_grace();
+        if (lowestY < 0.f) o.trackX = o.batX + o.batWidth * 0.5f;
+    }
+}
+
+// One game: its state plus the level grids it plays on (nullptr: the default levels world)
+struct GameWorld
+{
+    game::State game;
+    LevelsWorld *levels = nullptr;
+};
+static GameWorld g_defaultWorld;
+
+namespace game {
+    // Binds a world's levels to the calling thread for the length of one public call
+    struct LevelsBinding
+    {
+        LevelsWorld *prev;
+        explicit LevelsBinding(const GameWorld &w) : prev(levels_world_bind(w.levels)) {}
+        ~LevelsBinding() { levels_world_bind(prev); }
+    };
+}
+
+#ifdef BALLISTICA_BENCH
+namespace bench_hooks {
+    using namespace game;
+    uint64_t g_calls[kCounters];
+    static BallStore sSavedBalls;
+
+    void start_level(int index) { game::start_level(g_defaultWorld.game, index); }
+    void clear_balls() { State &G = g_defaultWorld.game; G.balls.clear(); G.ballLocked = false; }
+    void add_ball(float x, float y, float vx, float vy)
+    {
+        State &G = g_defaultWorld.game;
+        int i = G.balls.add(x, y, vx, vy, false);
+        G.balls.px[i] = x - vx;
+        G.balls.py[i] = y - vy;
+    }
+    void add_murder_ball(float x, float y, float vx, float vy)
+    {
+        State &G = g_defaultWorld.game;
+        int i = G.balls.add(x, y, vx, vy, true);
+        G.balls.px[i] = x - vx;
+        G.balls.py[i] = y - vy;
+    }
+    void bat_landing(float &x, float &y, float &vy)
+    {
+        const State &G = g_defaultWorld.game;
+        real effBatH = (G.bat.img.subtex ? G.bat.img.subtex->height : G.bat.height);
+        real batPadY = sim::max((G.bat.height - effBatH) * 0.5f, 0.f);
+        const float h = (float)kBallH + 8.f; // covers the murder ball sprite
+        x = sim::to_float(G.bat.x + G.bat.width * 0.5f) - kBallW * 0.5f;
+        y = sim::to_float(G.bat.y + batPadY) - h;
+        vy = h;
+    }
+    float bottom_y() { return 480.0f + (float)options::hinge_gap_px(); }
+    int lives() { return g_defaultWorld.game.lives; }
+    int active_balls() { return balls::count(g_defaultWorld.game.balls).active; }
+    void save_balls() { sSavedBalls = g_defaultWorld.game.balls; }
+    void restore_balls() { g_defaultWorld.game.balls = sSavedBalls; }
+    int ball_bricks()
+    {
+        State &G = g_defaultWorld.game;
+        int n = 0;
+        for (int i = 0; i < G.balls.size(); ++i)
+            if (G.balls.active(i)) { handle_ball_bricks(G, ball_at(G, i)); ++n; }
+        return n;
+    }
+    void moving_bricks() { update_moving_bricks(g_defaultWorld.game); }
+    bool trigger_bomb(int c, int r)
+    {
+        State &G = g_defaultWorld.game;
+        if (levels_brick_at(c, r) != (int)BrickType::BO) return false;
+        const int cell = r * brickgrid::kCols + c;
+        GameEvent ev{EventKind::Bomb, 0, (uint16_t)cell};
+        if (!G.wheel.schedule(1, ev)) return false;
+        G.bombPending.set(cell);
+        return true;
+    }
+    bool bomb_tick()
+    {
+        State &G = g_defaultWorld.game;
+        run_scheduled_events(G);
+        drain_frame_events(G);
+        return G.bombPending.any();
     }
 }
+#endif
 
 // Public facade
-void game_init() { game::init(); }
-void game_update(const InputState &in) { game::update(in); }
-void game_render() { game::render(); }
+void game_init()
+{
+    game::LevelsBinding bind(g_defaultWorld);
+    game::init(g_defaultWorld.game);
+}
+void game_update(const InputState &in) { game_update(g_defaultWorld, in); }
+void game_render() { game_render(g_defaultWorld); }
+void game_set_render_alpha(float alpha) { g_defaultWorld.game.renderAlpha = alpha < 0.f ? 0.f : (alpha > 1.f ? 1.f : alpha); }
 void game_render_title_buttons(const InputState &in) {
     using namespace game;
-    if (G.mode != Mode::Title) return;
+    if (g_defaultWorld.game.mode != Mode::Title) return;
     // Draw the title buttons using bottom-screen coordinate system.
     for (int i = 0; i < 4; ++i) {
         auto &tb = kTitleButtons[i];
@@ -2728,10 +3139,122 @@ void game_render_title_buttons(const InputState &in) {
         ui_draw_button(tb.btn, pressed);
     }
 }
-GameMode game_mode()
+void game_render_frame(const InputState &in, bool topLogs, bool bottomLogs)
 {
-    using namespace game;
-    switch (G.mode)
+    HwDrawScope scope("frame");
+    GameMode gm = game_mode();
+    // Dedicated handling: Editor and Options both own the bottom screen completely.
+    if (gm == GameMode::Options)
+    {
+        // Top: simple dark backdrop (could show rotating title sequence later if desired)
+        hw_set_top();
+        C2D_DrawRectSolid(0, 0, 0, 400, 240, C2D_Color32(0, 0, 0, 255));
+        hw_draw_text(8, 8, "Options", 0xFFFFFFFF);
+        if (topLogs) hw_draw_logs(4, 40, 200);
+        // Bottom: full options UI (game_render draws it for this mode)
+        hw_set_bottom();
+        C2D_DrawRectSolid(0, 0, 0, 320, 240, C2D_Color32(0, 0, 0, 255));
+        game_render();
+        return;
+    }
+    if (gm == GameMode::Editor)
+    {
+        // Editor lives on the bottom screen for touch drawing.
+        // Top: show INSTRUCT.png (same as main menu) while the editor is open.
+        hw_set_top();
+        C2D_DrawRectSolid(0, 0, 0, 400, 240, C2D_Color32(0, 0, 0, 255));
+        if (hw_sheet_loaded(HwSheet::Instruct))
+        {
+            C2D_Image instruct = hw_image_from(HwSheet::Instruct, INSTRUCT_idx);
+            // Draw at its natural top-screen position (image is designed for top)
+            hw_draw_sprite(instruct, 0, 0, 0, 1.0f, 1.0f);
+        }
+        if (topLogs) hw_draw_logs(4, 40, 200);
+        // Bottom: editor UI
+        hw_set_bottom();
+        C2D_DrawRectSolid(0, 0, 0, 320, 240, C2D_Color32(0, 0, 0, 255));
+        game_render();
+        return;
+    }
+    // Normal: gameplay/title etc on top
+    hw_set_top();
+    game_render();
+    if (topLogs) hw_draw_logs(4, 4, 232);
+    // Bottom screen overlays (title menu only; gameplay bottom is drawn by game_render)
+    hw_set_bottom();
+    if (gm == GameMode::Title)
+    {
+        scope.rename("title-menu");
+        // Underlay: MENUBOTTOM sheet (single image at index 0) behind the buttons if available
+        if (hw_sheet_loaded(HwSheet::MenuBottom))
+        {
+            C2D_Image under = hw_image_from(HwSheet::MenuBottom, 0);
+            hw_draw_sprite(under, 0, 0, 0, 1.0f, 1.0f);
+        }
+        hw_draw_text(10, 6, "START=Play  SELECT=Editor  X=Exit", 0xFFFFFFFF);
+        // Version label at bottom-left
+        char vbuf[32];
+        snprintf(vbuf, sizeof vbuf, "Version %.1f", game::kGameVersion);
+        hw_draw_text(10, 230, vbuf, 0xFFFF00FF); // yellow, scale 1.0 via hw_draw_text
+        game_render_title_buttons(in);
+        if (in.touching)
+        {
+            // small crosshair to visualize touch
+            int tx = in.stylusX, ty = in.stylusY;
+            C2D_DrawRectSolid(tx - 2, ty, 0, 5, 1, C2D_Color32(255, 255, 0, 255));
+            C2D_DrawRectSolid(tx, ty - 2, 0, 1, 5, C2D_Color32(255, 255, 0, 255));
+        }
+        if (bottomLogs) hw_draw_logs(4, 200, 36);
+    }
+    else
+    {
+        // Gameplay: bottom is rendered by game_render; only optional logs overlay here.
+        if (bottomLogs) hw_draw_logs(2, 220, 18);
+    }
+}
+GameMode game_mode() { return game_mode(g_defaultWorld); }
+bool exit_requested() { return game::exit_requested_internal(g_defaultWorld.game); }
+void game_set_seed(uint32_t seed) { g_defaultWorld.game.seed = seed; }
+uint32_t game_seed() { return g_defaultWorld.game.seed; }
+uint32_t game_state_hash() { return game_state_hash(g_defaultWorld); }
+void game_observe(GameObservation &out) { game_observe(g_defaultWorld, out); }
+void game_start_level(int index) { game_start_level(g_defaultWorld, index); }
+
+// Worlds
+GameWorld *game_world_create()
+{
+    GameWorld *w = new GameWorld;
+    {
+        game::LevelsBinding bind(g_defaultWorld);
+        w->levels = levels_world_create();
+    }
+    game::State &G = w->game;
+    G.headless = true;
+    game::LevelsBinding bind(*w);
+    game::init_assets(G);
+    game::reset_moving_bricks(G);
+    return w;
+}
+void game_world_destroy(GameWorld *w)
+{
+    if (!w || w == &g_defaultWorld) return;
+    levels_world_destroy(w->levels);
+    delete w;
+}
+GameWorld &game_default_world() { return g_defaultWorld; }
+void game_update(GameWorld &w, const InputState &in)
+{
+    game::LevelsBinding bind(w);
+    game::update(w.game, in);
+}
+void game_render(const GameWorld &w)
+{
+    game::LevelsBinding bind(w);
+    game::render(w.game);
+}
+GameMode game_mode(const GameWorld &w)
+{
+    switch (w.game.mode)
     {
     case game::Mode::Title:
         return GameMode::Title;
@@ -2744,4 +3267,19 @@ GameMode game_mode()
     }
     return GameMode::Title;
 }
-bool exit_requested() { return game::exit_requested_internal(); }
+void game_set_seed(GameWorld &w, uint32_t seed) { w.game.seed = seed; }
+uint32_t game_state_hash(const GameWorld &w)
+{
+    game::LevelsBinding bind(w);
+    return game::state_hash(w.game);
+}
+void game_observe(const GameWorld &w, GameObservation &out)
+{
+    game::LevelsBinding bind(w);
+    game::observe(w.game, out);
+}
+void game_start_level(GameWorld &w, int index)
+{
+    game::LevelsBinding bind(w);
+    game::start_level(w.game, index);
+}
@@ -14,8 +14,8 @@
 #include "IMAGE.h"
 #include "brick.hpp"
 #include "levels.hpp"
-#include "game.hpp"
 #include "layout.hpp" // centralized layout constants
+#include "bench_hooks.hpp"
 
 namespace levels {
     // Geometry constants
@@ -54,13 +54,40 @@ namespace levels {
     std::vector<uint8_t> hp;     // per-brick hit points (only used for multi-hit like T5)
     std::vector<uint8_t> origBricks; // pristine copy
     std::vector<uint8_t> origHp;     // pristine hp copy
+    brickgrid::Occupancy occ;        // bitboard mirror of bricks (kept in sync by setCell/syncOcc)
     };
+    static_assert(NumBricks == brickgrid::kCells, "brickgrid masks must cover the level grid");
 
-    static bool g_loaded = false;         // successfully parsed any levels
-    static std::vector<Level> g_levels;    // parsed levels
-    static int g_currentLevel = 0;         // index into g_levels
-    static int g_renderOffsetX = 0;        // runtime horizontal render offset (kept 0 for dual-screen alignment)
-    static int g_renderOffsetY = 0;        // runtime vertical render offset
+    // Every brick write goes through here so the occupancy masks never drift
+    static inline void setCell(Level& L, int idx, uint8_t type) { L.bricks[idx] = type; L.occ.set(idx, type); }
+    static inline void syncOcc(Level& L) { L.occ.rebuild(L.bricks.data(), (int)L.bricks.size()); }
+
+} // namespace levels
+
+// Parsed level list and live play state (current level, bricks, hp, completion latch, render
+// offsets) of one simulation. The level files and the active-file choice are shared.
+struct LevelsWorld {
+    bool loaded = false;                // successfully parsed any levels
+    std::vector<levels::Level> levels;  // parsed levels; bricks/hp change in play, orig* stay pristine
+    int current = 0;                    // index into levels
+    bool completePending = false;       // see levels_take_level_complete()
+    int renderOffsetX = 0;              // runtime horizontal render offset (kept 0 for dual-screen alignment)
+    int renderOffsetY = 0;              // runtime vertical render offset
+};
+
+namespace levels {
+    static LevelsWorld g_defaultWorld;
+    // World the levels_* calls act on (levels_world_bind). Per thread on the host, where tools
+    // run a simulation per thread; the 3DS build only ever has the default world.
+#ifdef PLATFORM_HOST
+    static thread_local LevelsWorld* t_world = &g_defaultWorld;
+#else
+    static LevelsWorld* t_world = &g_defaultWorld;
+#endif
+    static inline LevelsWorld& world() { return *t_world; }
+
+    // Latched by gameplay removals that clear the last required brick; read via levels_take_level_complete()
+    static inline void noteRemoval(const Level& L) { if(L.occ.requiredCount==0) world().completePending = true; }
 
     struct BrickDef { int atlasIndex; };
     // Map legacy shorthand index (enum order) to atlas image indices
@@ -192,33 +219,35 @@ namespace levels {
     const std::string& get_active_level_file() { return g_activeLevelFile; }
 
     // ---------- Legacy shorthand mapping (2-char codes) ----------------------
-    // Order must match brickMap order.
-    static const char* kBrickCodes[] = {
-        "NB","YB","GB","CB","TB","PB","RB","LB","SB","FB","F1","F2","B1","B2","B3","B4","B5","BS","BB","ID","RW","RE","IS","IF","AB","FO","LA","MB","BA","T5","BO","OF","ON","SS","SF"
-    };
+    // Codes come from kBrickTraits (brick.hpp), in BrickType order like brickMap.
+    static_assert(sizeof(brickMap)/sizeof(brickMap[0]) == (size_t)BrickType::COUNT, "brickMap needs one entry per BrickType");
     static std::unordered_map<std::string,int> buildCodeMap() {
-        std::unordered_map<std::string,int> m; m.reserve(sizeof(kBrickCodes)/sizeof(kBrickCodes[0]));
-        for(size_t i=0;i<sizeof(kBrickCodes)/sizeof(kBrickCodes[0]);++i) m[kBrickCodes[i]] = (int)i;
+        std::unordered_map<std::string,int> m; m.reserve((size_t)BrickType::COUNT);
+        for(int i=0;i<(int)BrickType::COUNT;++i) m[kBrickTraits[i].code] = i;
         return m;
     }
     static const std::unordered_map<std::string,int> kCodeToIndex = buildCodeMap();
 
     // ---------- Fallback -----------------------------------------------------
     static void buildFallback() {
+        LevelsWorld &w = world();
         Level L; L.name = "Fallback"; L.speed = kDefaultSpeed; L.bricks.assign(NumBricks,0);
         for(int r=0;r<BricksY;++r) {
             int base = 1 + (r % 6); // cycle simple colored bricks
             for(int c=0;c<BricksX;++c) L.bricks[r*BricksX+c] = (uint8_t)base;
         }
-    L.hp.assign(NumBricks,1);
-        g_levels.push_back(L);
-        g_loaded = true;
+    L.hp.resize(NumBricks);
+        for(int i=0;i<NumBricks;++i) L.hp[i] = brick_traits(L.bricks[i]).hp;
+        syncOcc(L);
+        w.levels.push_back(L);
+        w.loaded = true;
         hw_log("fallback level generated\n");
     }
 
     // ---------- Parser -------------------------------------------------------
     static void parseAll(FILE* f) {
-        g_levels.clear();
+        LevelsWorld &w = world();
+        w.levels.clear();
         char token[64];
         Level cur; bool inLevel=false; int bricks=0; int lineBricks=0;
     while(fscanf(f, "%63s", token)==1) {
@@ -228,7 +257,7 @@ namespace levels {
                 if(inLevel) {
                     // Accept legacy 13x11 (143) by padding to 13x13 with NB rows
                     if((int)cur.bricks.size()==NumBricks) {
-                        g_levels.push_back(cur);
+                        w.levels.push_back(cur);
                     } else if ((int)cur.bricks.size()==13*11) {
                         // pad with NB (and hp=0) to reach 13*13
                         cur.bricks.resize(NumBricks, (uint8_t)BrickType::NB);
@@ -236,9 +265,9 @@ namespace levels {
                         // snapshot originals
                         cur.origBricks = cur.bricks;
                         cur.origHp = cur.hp;
-                        g_levels.push_back(cur);
+                        w.levels.push_back(cur);
                     } else {
-                        char dbg[64]; snprintf(dbg,sizeof dbg,"level %d incomplete (%d bricks)\n", (int)g_levels.size()+1, (int)cur.bricks.size()); hw_log(dbg);
+                        char dbg[64]; snprintf(dbg,sizeof dbg,"level %d incomplete (%d bricks)\n", (int)w.levels.size()+1, (int)cur.bricks.size()); hw_log(dbg);
                     }
                 }
                 cur = Level(); bricks=0; lineBricks=0; inLevel=true; // reset
@@ -261,10 +290,8 @@ namespace levels {
                         if(cur.bricks.empty()) cur.bricks.reserve(NumBricks);
                         cur.bricks.push_back((uint8_t)idx); ++bricks; ++lineBricks;
                         if(cur.hp.empty()) cur.hp.reserve(NumBricks);
-                        // assign hp: default 1, T5 gets 5 hits; NB/ID are non-hittable (hp=0)
-                        uint8_t hpv = 1;
-                        if(idx == (int)BrickType::T5) hpv = 5; else if(idx == (int)BrickType::NB) hpv = 0; else if(idx == (int)BrickType::ID) hpv = 0;
-                        cur.hp.push_back(hpv);
+                        // initial hp from the traits table (T5 gets 5 hits; NB/ID are non-hittable)
+                        cur.hp.push_back(brick_traits(idx).hp);
                         if(bricks==NumBricks) {
                             if(cur.name.empty()) cur.name = "Level";
                             if(cur.speed==0) cur.speed = kDefaultSpeed;
@@ -281,25 +308,27 @@ namespace levels {
         if(inLevel) {
             if((int)cur.bricks.size()==NumBricks) {
                 if(cur.speed==0) cur.speed = kDefaultSpeed;
-                g_levels.push_back(cur);
+                w.levels.push_back(cur);
             } else if((int)cur.bricks.size()==13*11) {
                 cur.bricks.resize(NumBricks, (uint8_t)BrickType::NB);
                 cur.hp.resize(NumBricks, 0);
                 if(cur.speed==0) cur.speed = kDefaultSpeed;
                 cur.origBricks = cur.bricks;
                 cur.origHp = cur.hp;
-                g_levels.push_back(cur);
+                w.levels.push_back(cur);
             }
         }
-        if(!g_levels.empty()) {
-            g_loaded = true;
-            char buf[64]; snprintf(buf,sizeof buf,"levels parsed:%d\n", (int)g_levels.size()); hw_log(buf);
+        for(auto &L : w.levels) syncOcc(L);
+        if(!w.levels.empty()) {
+            w.loaded = true;
+            char buf[64]; snprintf(buf,sizeof buf,"levels parsed:%d\n", (int)w.levels.size()); hw_log(buf);
         }
     }
 
     // ---------- Public-ish internal operations -------------------------------
     void load() {
-        if(g_loaded) return;
+        LevelsWorld &w = world();
+        if(w.loaded) return;
         ensureOnSdmc();
         // Attempt to override default active file from persisted config (only first time before parsing)
         load_persisted_active_file();
@@ -307,24 +336,25 @@ namespace levels {
         FILE* f = fopen(sdPath, "rb");
         if(!f) { hw_log("open sd LEVELS fail\n"); buildFallback(); return; }
         parseAll(f); fclose(f);
-        if(!g_loaded) buildFallback();
+        if(!w.loaded) buildFallback();
     }
 
     void renderBricks() {
+        LevelsWorld &w = world();
         // Caller is responsible for setting draw offset (e.g., +40 on top screen).
-        if(!g_loaded || g_levels.empty()) return;
-        const Level& L = g_levels[g_currentLevel];
+        if(!w.loaded || w.levels.empty()) return;
+        const Level& L = w.levels[w.current];
         if(L.bricks.size()!=NumBricks) return;
         for(int i=0;i<NumBricks;i++) {
             uint8_t v = L.bricks[i]; if(v==0) continue; if(v >= (int)(sizeof(brickMap)/sizeof(brickMap[0]))) continue;
             // Skip moving bricks here; they are rendered dynamically in game.cpp
-            if (v == (uint8_t)BrickType::SS || v == (uint8_t)BrickType::SF) continue;
+            if (brick_traits(v).flags & kBrickMoving) continue;
             int col = i % BricksX; int row = i / BricksX;
-            float x = (float)(LEFTSTART + g_renderOffsetX) + col * CellW;
-            float y = (float)(TOPSTART + g_renderOffsetY) + row * CellH;
+            float x = (float)(LEFTSTART + w.renderOffsetX) + col * CellW;
+            float y = (float)(TOPSTART + w.renderOffsetY) + row * CellH;
             int atlasIndex = brickMap[v].atlasIndex;
             // For five-hit bricks, select sprite based on HP
-            if (v == (int)BrickType::T5 && L.hp.size() == NumBricks) {
+            if ((brick_traits(v).flags & kBrickMultiHit) && L.hp.size() == NumBricks) {
                 int hp = L.hp[i];
                 // Clamp hp to [1,5], show correct stage (5=full, 1=last)
                 if (hp >= 1 && hp <= 5) {
@@ -336,103 +366,89 @@ namespace levels {
         }
     }
     // Adjust runtime render offset
-    void set_draw_offset(int off) { g_renderOffsetX = off; }
-    int draw_offset() { return g_renderOffsetX; }
-    int left_with_offset() { return LEFTSTART + g_renderOffsetX; }
+    void set_draw_offset(int off) { world().renderOffsetX = off; }
+    int draw_offset() { return world().renderOffsetX; }
+    int left_with_offset() { return LEFTSTART + world().renderOffsetX; }
     // The score UI background is drawn at y=0 with height hudHeight (currently 34).
     // To start the bricks one brick height below the UI, set top = hudHeight + CellH
     // Always use TOPSTART for both rendering and colliders
-    int top_with_offset() { return TOPSTART + g_renderOffsetY; }
+    int top_with_offset() { return TOPSTART + world().renderOffsetY; }
     int edit_left() { return EDIT_LEFTSTART; }
     int edit_top() { return EDIT_TOPSTART; }
     int levels_remaining_breakable() {
-    if(g_levels.empty()) return 0;
-    const auto &L = g_levels[g_currentLevel];
-    int cnt=0;
-    for(auto b: L.bricks) {
-        if(b && b!=(int)BrickType::ID && b!=(int)BrickType::OF && b!=(int)BrickType::ON) ++cnt;
-    }
-    return cnt;
+    LevelsWorld &w = world();
+    if(w.levels.empty()) return 0;
+    return w.levels[w.current].occ.breakable.count();
 }
 
 bool levels_damage_brick(int c,int r) {
-    if(g_levels.empty()) return false;
+    LevelsWorld &w = world();
+    if(w.levels.empty()) return false;
     if(c<0||c>=BricksX||r<0||r>=BricksY) return false;
-    auto &L = g_levels[g_currentLevel];
+    auto &L = w.levels[w.current];
     int idx=r*BricksX+c;
     if(idx >= (int)L.bricks.size()) return false;
     int type = L.bricks[idx];
     if(!type) return false;
-    if(type == (int)BrickType::ID) return false;
+    if(brick_traits(type).flags & kBrickIndestructible) return false;
     if(L.hp.size()!=L.bricks.size()) {
-        L.hp.assign(L.bricks.size(),1);
-        for(size_t i=0;i<L.bricks.size();++i) {
-            if(L.bricks[i]==(int)BrickType::T5) L.hp[i]=5;
-            else if(L.bricks[i]==0 || L.bricks[i]==(int)BrickType::ID) L.hp[i]=0;
-        }
+        L.hp.resize(L.bricks.size());
+        for(size_t i=0;i<L.bricks.size();++i) L.hp[i] = brick_traits(L.bricks[i]).hp;
     }
     if (L.hp[idx] > 1) {
         L.hp[idx]--;
         return false;
     }
-    // Now HP is 1 or less, so destroy and show effect if needed
-    // log an event for testing
-    char dbg[64]; snprintf(dbg,sizeof dbg,"brick %d,%d destroyed\n", c, r); hw_log(dbg);
-    if (L.bricks[idx] == (int)BrickType::T5) {
-        float x = (float)(LEFTSTART + g_renderOffsetX) + c * CellW + CellW * 0.5f;
-        float y = (float)(TOPSTART + g_renderOffsetY) + r * CellH + CellH * 0.5f;
-        game::spawn_dust_effect(x, y); // Visual effect on brick destruction
-    }
-    L.bricks[idx]=0;
+    // Now HP is 1 or less, so destroy (the caller shows the dust effect)
+    setCell(L, idx, 0);
     L.hp[idx]=0;
+    noteRemoval(L);
     return true;
 }
 
 int levels_brick_hp(int c,int r) {
-    if(g_levels.empty()) return 0;
+    LevelsWorld &w = world();
+    if(w.levels.empty()) return 0;
     if(c<0||c>=BricksX||r<0||r>=BricksY) return 0;
-    auto &L = g_levels[g_currentLevel];
+    auto &L = w.levels[w.current];
     int idx=r*BricksX+c;
     if(idx >= (int)L.bricks.size()) return 0;
     if(L.hp.size()!=L.bricks.size()) {
-        return (L.bricks[idx]==(int)BrickType::T5)?5: (L.bricks[idx]==0||L.bricks[idx]==(int)BrickType::ID?0:1);
+        return brick_traits(L.bricks[idx]).hp;
     }
     return L.hp[idx];
 }
 
 int levels_explode_bomb(int c,int r, std::vector<DestroyedBrick>* outDestroyed) {
-    if(g_levels.empty()) return 0;
+    LevelsWorld &w = world();
+    BENCH_COUNT(ExplodeBomb);
+    if(w.levels.empty()) return 0;
     if(c<0||c>=BricksX||r<0||r>=BricksY) return 0;
-    auto &L = g_levels[g_currentLevel];
+    auto &L = w.levels[w.current];
     int idx=r*BricksX+c;
     if(idx >= (int)L.bricks.size()) return 0;
     int type = L.bricks[idx];
-    if(type != (int)BrickType::BO) return 0;
+    if(!brick_is_bomb((BrickType)type)) return 0;
+    // The whole cluster goes up at once, plus every brick 8-adjacent to one of its bombs.
+    // Depth layers grow from the hit bomb one 8-neighbour step at a time (bounded by reach).
+    brickgrid::Mask cluster = L.occ.bombClusters.members(idx, L.occ.bomb);
+    brickgrid::Mask reach = cluster | (brickgrid::dilate8(cluster) & L.occ.any);
+    brickgrid::Mask frontier; frontier.clear(); frontier.set(idx);
+    brickgrid::Mask done = frontier;
     int destroyed = 0;
-    std::vector<std::pair<int,int>> stack;
-    stack.push_back(std::make_pair(c,r));
-    while(!stack.empty()) {
-        std::pair<int,int> pr = stack.back();
-        stack.pop_back();
-        int cc = pr.first; int rr = pr.second;
-        if(cc<0||cc>=BricksX||rr<0||rr>=BricksY) continue;
-        int i = rr*BricksX+cc;
-        if(i >= (int)L.bricks.size()) continue;
-        int t = L.bricks[i];
-        if(!t) continue;
-        bool isBomb = (t == (int)BrickType::BO);
-        if(outDestroyed) outDestroyed->push_back({cc,rr,t});
-        L.bricks[i]=0;
-        if(L.hp.size()==L.bricks.size()) L.hp[i]=0;
-        ++destroyed;
-        if(isBomb) {
-            for(int dy=-1; dy<=1; ++dy) {
-                for(int dx=-1; dx<=1; ++dx) {
-                    if(dx||dy) stack.push_back(std::make_pair(cc+dx, rr+dy));
-                }
-            }
+    for(int depth=0; frontier.any(); ++depth) {
+        for(int i=frontier.next(0); i>=0; i=frontier.next(i+1)) {
+            if(outDestroyed) outDestroyed->push_back({i%BricksX, i/BricksX, (int)L.bricks[i], depth});
+            setCell(L, i, 0);
+            if(L.hp.size()==L.bricks.size()) L.hp[i]=0;
+            ++destroyed;
         }
+        // Only bombs pass the blast on; bricks reached this layer stop there
+        brickgrid::Mask bombs = frontier & cluster;
+        frontier = brickgrid::minus(brickgrid::dilate8(bombs) & reach, done);
+        done = done | frontier;
     }
+    if(destroyed) noteRemoval(L);
     return destroyed;
 }
 
@@ -443,59 +459,65 @@ int levels_atlas_index(int rawType) {
 }
 
 void levels_reset_level(int idx) {
-    if(g_levels.empty()) return;
-    if(idx<0 || idx >= (int)g_levels.size()) return;
-    Level &L = g_levels[idx];
+    LevelsWorld &w = world();
+    if(w.levels.empty()) return;
+    if(idx<0 || idx >= (int)w.levels.size()) return;
+    Level &L = w.levels[idx];
+    if(idx == w.current) w.completePending = false;
     if(L.origBricks.size()==NumBricks) L.bricks = L.origBricks;
     if(L.origHp.size()==NumBricks) L.hp = L.origHp; else if(L.hp.size()==NumBricks) {
-        for(int i=0;i<NumBricks;i++) {
-            if(L.bricks[i]==(int)BrickType::T5) L.hp[i]=5; else if(L.bricks[i]==0 || L.bricks[i]==(int)BrickType::ID) L.hp[i]=0; else L.hp[i]=1;
-        }
+        for(int i=0;i<NumBricks;i++) L.hp[i] = brick_traits(L.bricks[i]).hp;
     }
+    syncOcc(L);
 }
 void levels_snapshot_level(int idx) {
-    if(levels::g_levels.empty()) return;
-    if(idx<0 || idx >= (int)levels::g_levels.size()) return;
-    auto &L = levels::g_levels[idx];
+    LevelsWorld &w = world();
+    if(w.levels.empty()) return;
+    if(idx<0 || idx >= (int)w.levels.size()) return;
+    auto &L = w.levels[idx];
     if(L.bricks.size()==(size_t)levels::NumBricks) L.origBricks = L.bricks;
     if(L.hp.size()==L.bricks.size()) L.origHp = L.hp;
 }
 
     // Editor helpers
     int edit_get_brick(int levelIndex, int col, int row) {
-        if(levelIndex<0 || levelIndex >= (int)g_levels.size()) return -1;
+        LevelsWorld &w = world();
+        if(levelIndex<0 || levelIndex >= (int)w.levels.size()) return -1;
         if(col<0||col>=BricksX||row<0||row>=BricksY) return -1;
-        Level &L = g_levels[levelIndex];
+        Level &L = w.levels[levelIndex];
         int idx = row*BricksX+col; if(idx >= (int)L.bricks.size()) return -1; return (int)L.bricks[idx];
     }
     void edit_set_brick(int levelIndex, int col, int row, int brickType) {
-        if(levelIndex<0 || levelIndex >= (int)g_levels.size()) return;
+        LevelsWorld &w = world();
+        if(levelIndex<0 || levelIndex >= (int)w.levels.size()) return;
         if(col<0||col>=BricksX||row<0||row>=BricksY) return;
         if(brickType < 0 || brickType >= (int)BrickType::COUNT) brickType = 0;
-        Level &L = g_levels[levelIndex]; int idx=row*BricksX+col; if(idx >= (int)L.bricks.size()) return;
-        L.bricks[idx] = (uint8_t)brickType;
+        Level &L = w.levels[levelIndex]; int idx=row*BricksX+col; if(idx >= (int)L.bricks.size()) return;
+        setCell(L, idx, (uint8_t)brickType);
         if(L.hp.size()==L.bricks.size()) {
-            if(brickType==(int)BrickType::T5) L.hp[idx]=5; else if(brickType==0 || brickType==(int)BrickType::ID) L.hp[idx]=0; else L.hp[idx]=1;
+            L.hp[idx] = brick_traits(brickType).hp;
         }
     }
-    int get_speed(int levelIndex) { if(levelIndex<0||levelIndex>=(int)g_levels.size()) return 0; return g_levels[levelIndex].speed; }
-    void set_speed(int levelIndex, int speed) { if(levelIndex<0||levelIndex>=(int)g_levels.size()) return; if(speed<1) speed=1; if(speed>99) speed=99; g_levels[levelIndex].speed = speed; }
-    const char* get_name(int levelIndex) { if(levelIndex<0||levelIndex>=(int)g_levels.size()) return ""; return g_levels[levelIndex].name.c_str(); }
+    int get_speed(int levelIndex) { LevelsWorld &w = levels::world(); if(levelIndex<0||levelIndex>=(int)w.levels.size()) return 0; return w.levels[levelIndex].speed; }
+    void set_speed(int levelIndex, int speed) { LevelsWorld &w = levels::world(); if(levelIndex<0||levelIndex>=(int)w.levels.size()) return; if(speed<1) speed=1; if(speed>99) speed=99; w.levels[levelIndex].speed = speed; }
+    const char* get_name(int levelIndex) { LevelsWorld &w = levels::world(); if(levelIndex<0||levelIndex>=(int)w.levels.size()) return ""; return w.levels[levelIndex].name.c_str(); }
     void set_name(int levelIndex, const char* name) {
-    if(levelIndex<0||levelIndex>=(int)g_levels.size()) return;
+    LevelsWorld &w = world();
+    if(levelIndex<0||levelIndex>=(int)w.levels.size()) return;
     if(!name) return;
     std::string s(name);
         if(s.size()>32) s.resize(32); // simple cap
         // trim leading spaces
         size_t p=0; while(p<s.size() && (unsigned char)s[p]<=' ') ++p; if(p>0) s = s.substr(p);
-        g_levels[levelIndex].name = s;
+        w.levels[levelIndex].name = s;
     }
     bool save_active() {
-        if(g_levels.empty()) return false;
+        LevelsWorld &w = world();
+        if(w.levels.empty()) return false;
         char path[256]; snprintf(path,sizeof path, "%s/%s", kLevelsSubDir, g_activeLevelFile.c_str());
         FILE* f = fopen(path, "wb"); if(!f) return false;
-        for(size_t li=0; li<g_levels.size(); ++li) {
-            const Level &L = g_levels[li];
+        for(size_t li=0; li<w.levels.size(); ++li) {
+            const Level &L = w.levels[li];
             fprintf(f, "LEVEL %zu\n", li+1);
             fprintf(f, "SPEED %d\n", L.speed);
             fprintf(f, "NAME %s\n", L.name.c_str());
@@ -503,7 +525,7 @@ void levels_snapshot_level(int idx) {
             for(int r=0;r<BricksY;r++) {
                 for(int c=0;c<BricksX;c++) {
                     int idx = r*BricksX+c; int b = (idx<(int)L.bricks.size())? L.bricks[idx]:0;
-                    const char* code = (b>=0 && b < (int)(sizeof(kBrickCodes)/sizeof(kBrickCodes[0]))) ? kBrickCodes[b] : "NB";
+                    const char* code = brick_traits(b).code;
                     fprintf(f, "%s", code);
                     if(c<BricksX-1) fputc(' ', f);
                 }
@@ -519,9 +541,9 @@ void levels_snapshot_level(int idx) {
 // Public simple C interface used by game.cpp
 void levels_load() { levels::load(); }
 void levels_render() { levels::renderBricks(); }
-int levels_count() { return (int)levels::g_levels.size(); }
-int levels_current() { return levels::g_currentLevel; }
-bool levels_set_current(int idx) { if(idx>=0 && idx < (int)levels::g_levels.size()) { levels::g_currentLevel = idx; return true; } return false; }
+int levels_count() { return (int)levels::world().levels.size(); }
+int levels_current() { return levels::world().current; }
+bool levels_set_current(int idx) { LevelsWorld &w = levels::world(); if(idx>=0 && idx < (int)w.levels.size()) { w.current = idx; w.completePending = false; return true; } return false; }
 int levels_grid_width() { using namespace levels; return BricksX; }
 int levels_grid_height() { using namespace levels; return BricksY; }
 int levels_left() { return levels::left_with_offset(); }
@@ -532,9 +554,19 @@ int levels_brick_width() { return levels::CellW; }
 int levels_brick_height() { return levels::CellH; }
 int levels_edit_brick_width() { return levels::EditCellW; }
 int levels_edit_brick_height() { return levels::EditCellH; }
-int levels_brick_at(int c,int r) { if(levels::g_levels.empty()) return -1; using namespace levels; if(c<0||c>=BricksX||r<0||r>=BricksY) return -1; const auto &L = levels::g_levels[levels::g_currentLevel]; int idx=r*BricksX+c; if(idx >= (int)L.bricks.size()) return -1; return (int)L.bricks[idx]; }
-void levels_remove_brick(int c,int r) { if(levels::g_levels.empty()) return; using namespace levels; if(c<0||c>=BricksX||r<0||r>=BricksY) return; auto &L = levels::g_levels[levels::g_currentLevel]; int idx=r*BricksX+c; if(idx >= (int)L.bricks.size()) return; L.bricks[idx]=0; if(L.hp.size()==L.bricks.size()) L.hp[idx]=0; }
+int levels_brick_at(int c,int r) { LevelsWorld &w = levels::world(); if(w.levels.empty()) return -1; using namespace levels; if(c<0||c>=BricksX||r<0||r>=BricksY) return -1; const auto &L = w.levels[w.current]; int idx=r*BricksX+c; if(idx >= (int)L.bricks.size()) return -1; return (int)L.bricks[idx]; }
+void levels_remove_brick(int c,int r) { LevelsWorld &w = levels::world(); if(w.levels.empty()) return; using namespace levels; if(c<0||c>=BricksX||r<0||r>=BricksY) return; auto &L = w.levels[w.current]; int idx=r*BricksX+c; if(idx >= (int)L.bricks.size()) return; if(!L.bricks[idx]) return; setCell(L, idx, 0); if(L.hp.size()==L.bricks.size()) L.hp[idx]=0; noteRemoval(L); }
+brickgrid::GridView levels_grid_view() {
+    LevelsWorld &w = levels::world();
+    brickgrid::GridView v; if(w.levels.empty()) return v;
+    const auto &L = w.levels[w.current];
+    if(L.bricks.size()!=(size_t)levels::NumBricks) return v;
+    v.bricks = L.bricks.data(); v.hp = (L.hp.size()==L.bricks.size()) ? L.hp.data() : nullptr; v.occ = &L.occ;
+    return v;
+}
 int levels_remaining_breakable() { return levels::levels_remaining_breakable(); }
+int levels_remaining_required() { LevelsWorld &w = levels::world(); if(w.levels.empty()) return 0; return w.levels[w.current].occ.requiredCount; }
+bool levels_take_level_complete() { LevelsWorld &w = levels::world(); bool p = w.completePending; w.completePending = false; return p; }
 bool levels_damage_brick(int c,int r) { return levels::levels_damage_brick(c,r); }
 int levels_brick_hp(int c,int r) { return levels::levels_brick_hp(c,r); }
 int levels_explode_bomb(int c,int r, std::vector<DestroyedBrick>* outDestroyed) { return levels::levels_explode_bomb(c,r,outDestroyed); }
@@ -543,14 +575,14 @@ void levels_reset_level(int idx) { levels::levels_reset_level(idx); }
 void levels_snapshot_level(int idx) { levels::levels_snapshot_level(idx); }
 void levels_set_draw_offset(int off) { levels::set_draw_offset(off); }
 int levels_get_draw_offset() { return levels::draw_offset(); }
-void levels_set_draw_offset_y(int off) { using namespace levels; g_renderOffsetY = off; }
-int levels_get_draw_offset_y() { using namespace levels; return g_renderOffsetY; }
+void levels_set_draw_offset_y(int off) { using namespace levels; world().renderOffsetY = off; }
+int levels_get_draw_offset_y() { using namespace levels; return world().renderOffsetY; }
 // New selection APIs
 const std::vector<std::string>& levels_available_files() { return levels::available_level_files(); }
 void levels_refresh_files() { levels::refresh_level_files(); }
 void levels_set_active_file(const char* f) { if(f) levels::set_active_level_file(f); }
 const char* levels_get_active_file() { return levels::get_active_level_file().c_str(); }
-void levels_reload_active() { using namespace levels; g_loaded=false; g_levels.clear(); load(); }
+void levels_reload_active() { LevelsWorld &w = levels::world(); using namespace levels; w.loaded=false; w.levels.clear(); w.completePending=false; load(); }
 bool levels_duplicate_active(const char* newBase) {
     if(!newBase || !*newBase) return false;
     // Sanitize: uppercase, strip invalid, max 8 chars
@@ -582,4 +614,23 @@ void levels_set_speed(int levelIndex, int speed) { levels::set_speed(levelIndex,
 const char* levels_get_name(int levelIndex) { return levels::get_name(levelIndex); }
 void levels_set_name(int levelIndex, const char* name) { levels::set_name(levelIndex,name); }
 bool levels_save_active() { return levels::save_active(); }
-void levels_persist_active_file() { levels::persist_active_level_file(); }
\ No newline at end of file
+void levels_persist_active_file() { levels::persist_active_level_file(); }
+
+LevelsWorld* levels_world_create() { return new LevelsWorld(levels::world()); }
+void levels_world_destroy(LevelsWorld* w) { if(w && w != &levels::g_defaultWorld) delete w; }
+LevelsWorld* levels_world_bind(LevelsWorld* w) {
+    LevelsWorld* prev = levels::t_world;
+    levels::t_world = w ? w : &levels::g_defaultWorld;
+    return prev;
+}
+
+#ifdef BALLISTICA_BENCH
+// Replaces the loaded pack (callers reload the active file afterwards)
+int bench_hooks::parse(FILE* f) {
+    LevelsWorld &w = levels::world();
+    using namespace levels;
+    w.loaded=false; w.completePending=false;
+    parseAll(f);
+    return (int)w.levels.size();
+}
+#endif
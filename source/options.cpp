@@ -29,6 +29,42 @@ namespace ui {
     constexpr int MUSIC_SZ      = 16;    // checkbox square size
     constexpr int MUSIC_GAP     = 8;     // horizontal gap from label to checkbox
     constexpr int MUSIC_VOFFSET = 0;    // vertical adjust of checkbox relative to label baseline
+    // Aim guide checkbox shares the music row, same box size and gap
+    constexpr int AIM_LABEL_X = 180;
+    constexpr int AIM_LABEL_Y = MUSIC_LABEL_Y;
+}
+
+// Checkbox with its label on the left; the label and box together are the tap target
+struct Checkbox { int labelX, labelY; const char* label; };
+static const Checkbox kMusicBox = { ui::MUSIC_LABEL_X, ui::MUSIC_LABEL_Y, "Music Enabled" };
+static const Checkbox kAimGuideBox = { ui::AIM_LABEL_X, ui::AIM_LABEL_Y, "Aim Guide" };
+
+static void checkbox_box(const Checkbox &c, int &bx, int &by) {
+    bx = c.labelX + hw_text_width(c.label) + ui::MUSIC_GAP;              // checkbox X to the right of label
+    by = c.labelY - (ui::MUSIC_SZ - 6)/2 + ui::MUSIC_VOFFSET;            // align box center to 6px text height
+}
+static bool checkbox_hit(const Checkbox &c, int x, int y) {
+    int bx, by; checkbox_box(c, bx, by);
+    // Clickable region: from start of label to end of checkbox, union of label height and box height
+    int rx0 = c.labelX;
+    int rx1 = bx + ui::MUSIC_SZ;
+    int ry0 = std::min(c.labelY, by);
+    int ry1 = std::max(c.labelY + 6, by + ui::MUSIC_SZ);
+    return x >= rx0 && x < rx1 && y >= ry0 && y < ry1;
+}
+static void checkbox_draw(const Checkbox &c, bool checked) {
+    hw_draw_text(c.labelX, c.labelY, c.label, 0xFFFFFFFF);
+    int bx, by; checkbox_box(c, bx, by);
+    uint32_t boxCol = C2D_Color32(80,80,110,255);
+    uint32_t fillCol = C2D_Color32(200,200,255,255);
+    // Outline box
+    C2D_DrawRectSolid(bx-1, by-1, 0, ui::MUSIC_SZ+2, 1, boxCol); // top
+    C2D_DrawRectSolid(bx-1, by+ui::MUSIC_SZ, 0, ui::MUSIC_SZ+2, 1, boxCol); // bottom
+    C2D_DrawRectSolid(bx-1, by-1, 0, 1, ui::MUSIC_SZ+2, boxCol); // left
+    C2D_DrawRectSolid(bx+ui::MUSIC_SZ, by-1, 0, 1, ui::MUSIC_SZ+2, boxCol); // right
+    if (checked) {
+        C2D_DrawRectSolid(bx+3, by+3, 0, ui::MUSIC_SZ-6, ui::MUSIC_SZ-6, fillCol);
+    }
 }
 
 static int selectedIndex = 0; // mirrors dropdown.selectedIndex
@@ -39,11 +75,16 @@ static UIDropdown deviceDD; // device type dropdown
 static std::vector<std::string> deviceItems = {"Emulator", "3DS", "3DS XL"};
 static std::vector<UIButton> buttons; // NAME, DUPLICATE, CANCEL, SAVE
 static bool musicEnabled = true; // default to playing music
+static bool aimGuideEnabled = false; // assist: predicted ball path drawn in play
+static bool recordReplay = false; // record each session's input (no UI; options.cfg only)
 // Device selection controls hinge gap. Default: 3DS
 static DeviceType currentDevice = DeviceType::ThreeDS;
 
 bool is_music_enabled() { return musicEnabled; }
+bool is_aim_guide_enabled() { return aimGuideEnabled; }
 DeviceType device_type() { return currentDevice; }
+void set_device_type(DeviceType type) { currentDevice = type; }
+bool is_replay_recording_enabled() { return recordReplay; }
 int hinge_gap_px() {
     switch (currentDevice) {
         case DeviceType::Emulator: return 0;
@@ -61,6 +102,10 @@ void load_settings() {
         if (strcmp(key, "music") == 0) {
             if (strcmp(val, "0") == 0 || strcasecmp(val, "false") == 0 || strcasecmp(val, "off") == 0) musicEnabled = false;
             else musicEnabled = true;
+        } else if (strcmp(key, "aim_guide") == 0) {
+            aimGuideEnabled = !(strcmp(val, "0") == 0 || strcasecmp(val, "false") == 0 || strcasecmp(val, "off") == 0);
+        } else if (strcmp(key, "record_replay") == 0) {
+            recordReplay = !(strcmp(val, "0") == 0 || strcasecmp(val, "false") == 0 || strcasecmp(val, "off") == 0);
         } else if (strcmp(key, "device") == 0) {
             if (strcasecmp(val, "emulator") == 0) currentDevice = DeviceType::Emulator;
             else if (strcasecmp(val, "3dsxl") == 0 || strcasecmp(val, "3ds_xl") == 0 || strcasecmp(val, "3ds-xl") == 0) currentDevice = DeviceType::ThreeDSXL;
@@ -76,6 +121,8 @@ void save_settings() {
     FILE* f = fopen("sdmc:/ballistica/options.cfg", "wb");
     if (!f) return;
     fprintf(f, "music=%s\n", musicEnabled ? "1" : "0");
+    fprintf(f, "aim_guide=%s\n", aimGuideEnabled ? "1" : "0");
+    fprintf(f, "record_replay=%s\n", recordReplay ? "1" : "0");
     const char* devStr = (currentDevice == DeviceType::Emulator) ? "emulator"
                         : (currentDevice == DeviceType::ThreeDSXL) ? "3dsxl"
                         : "3ds";
@@ -199,29 +246,21 @@ Action update(const InputState &in) {
     if (in.touchPressed) {
         int x=in.stylusX, y=in.stylusY;
         // Handle Music checkbox toggle (label on left)
-        {
-            const char* label = "Music Enabled";
-            int labelW = hw_text_width(label);
-            int bx = ui::MUSIC_LABEL_X + labelW + ui::MUSIC_GAP; // checkbox X to the right of label
-            int by = ui::MUSIC_LABEL_Y - (ui::MUSIC_SZ - 6)/2 + ui::MUSIC_VOFFSET; // align box center to 6px text height
-            int bw = ui::MUSIC_SZ;
-            int bh = ui::MUSIC_SZ;
-            // Clickable region: from start of label to end of checkbox, union of label height and box height
-            int rx0 = ui::MUSIC_LABEL_X;
-            int rx1 = bx + bw;
-            int ry0 = std::min(ui::MUSIC_LABEL_Y, by);
-            int ry1 = std::max(ui::MUSIC_LABEL_Y + 6, by + bh);
-            if (x >= rx0 && x < rx1 && y >= ry0 && y < ry1) {
-                musicEnabled = !musicEnabled;
-                sound::play_sfx("menu-click", 4, 1.0f, true);
-                if (!musicEnabled) {
-                    sound::stop_music();
-                } else {
-                    // Resume background track at 80% volume, looped
-                    sound::play_music("music", true, 0.8f, true);
-                }
-                return Action::None;
+        if (checkbox_hit(kMusicBox, x, y)) {
+            musicEnabled = !musicEnabled;
+            sound::play_sfx("menu-click", 4, 1.0f, true);
+            if (!musicEnabled) {
+                sound::stop_music();
+            } else {
+                // Resume background track at 80% volume, looped
+                sound::play_music("music", true, 0.8f, true);
             }
+            return Action::None;
+        }
+        if (checkbox_hit(kAimGuideBox, x, y)) {
+            aimGuideEnabled = !aimGuideEnabled;
+            sound::play_sfx("menu-click", 4, 1.0f, true);
+            return Action::None;
         }
         // Device Type selection is handled by device dropdown; no tap-to-cycle region needed now.
         for(size_t i=0;i<buttons.size();++i) {
@@ -240,6 +279,7 @@ Action update(const InputState &in) {
 }
 
 void render() {
+    HwDrawScope scope("options");
     // Background
     C2D_Image img = hw_image_from(HwSheet::Options, OPTIONS_idx);
     if (img.tex) hw_draw_sprite(img,0,0); else { C2D_DrawRectSolid(0,0,0,320,240,C2D_Color32(20,20,40,255)); hw_draw_text(100,20,"OPTIONS",0xFFFFFFFF); }
@@ -257,24 +297,9 @@ void render() {
             hw_draw_text(ui::NAME_X+8, ui::NAME_Y+6, duplicateName[0]?duplicateName:"TAP", 0xFFFFFFFF);
         }
     }
-    // Music label (left) and checkbox (right)
-    {
-        const char* label = "Music Enabled";
-        int labelW = hw_text_width(label);
-        hw_draw_text(ui::MUSIC_LABEL_X, ui::MUSIC_LABEL_Y, label, 0xFFFFFFFF);
-        int bx = ui::MUSIC_LABEL_X + labelW + ui::MUSIC_GAP;
-        int by = ui::MUSIC_LABEL_Y - (ui::MUSIC_SZ - 6)/2 + ui::MUSIC_VOFFSET;
-        uint32_t boxCol = C2D_Color32(80,80,110,255);
-        uint32_t fillCol = C2D_Color32(200,200,255,255);
-        // Outline box
-        C2D_DrawRectSolid(bx-1, by-1, 0, ui::MUSIC_SZ+2, 1, boxCol); // top
-        C2D_DrawRectSolid(bx-1, by+ui::MUSIC_SZ, 0, ui::MUSIC_SZ+2, 1, boxCol); // bottom
-        C2D_DrawRectSolid(bx-1, by-1, 0, 1, ui::MUSIC_SZ+2, boxCol); // left
-        C2D_DrawRectSolid(bx+ui::MUSIC_SZ, by-1, 0, 1, ui::MUSIC_SZ+2, boxCol); // right
-        if (musicEnabled) {
-            C2D_DrawRectSolid(bx+3, by+3, 0, ui::MUSIC_SZ-6, ui::MUSIC_SZ-6, fillCol);
-        }
-    }
+    // Music and aim guide labels (left) and checkboxes (right)
+    checkbox_draw(kMusicBox, musicEnabled);
+    checkbox_draw(kAimGuideBox, aimGuideEnabled);
     // Device Type selector row: label + dropdown to the right
     {
         const char* label = "Device Type:";
@@ -4,6 +4,8 @@
 namespace options {
 // Returns whether music should play (default true). Implemented in options.cpp
 bool is_music_enabled();
+// Returns whether the assist aim guide (predicted ball path) is drawn (default false)
+bool is_aim_guide_enabled();
 
 // Device selection controls the simulated hinge gap in pixels.
 enum class DeviceType { Emulator = 0, ThreeDS = 1, ThreeDSXL = 2 };
@@ -11,6 +13,10 @@ enum class DeviceType { Emulator = 0, ThreeDS = 1, ThreeDSXL = 2 };
 DeviceType device_type();
 // Returns the hinge gap in pixels derived from the current device type: Emulator=0, 3DS=52, 3DS XL=68
 int hinge_gap_px();
+// Override the device type for this run without saving it (replay playback)
+void set_device_type(DeviceType type);
+// Whether play sessions are recorded to sdmc:/ballistica/replays (options.cfg record_replay=1)
+bool is_replay_recording_enabled();
 // Load/save persistent options from/to SD card.
 void load_settings();
 void save_settings();
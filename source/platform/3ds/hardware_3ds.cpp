@@ -10,6 +10,7 @@
 #include <string.h>
 #include <vector>
 #include <string>
+#include "font5x6.hpp"
 
 #include "IMAGE_t3x.h"
 #include "IMAGE.h"
@@ -54,83 +55,12 @@ namespace {
     std::vector<std::string> g_logs;
     const size_t kMaxLogLines = 64;
 
-    // 5x6 pixel bitmap font (uppercase + digits + some punctuation)
-    // Each row uses low 5 bits of a byte.
-    struct Glyph { char c; uint8_t rows[6]; };
-    static const Glyph kGlyphs[] = {
-        {'A',{0x0E,0x11,0x1F,0x11,0x11,0x00}},
-        {'B',{0x1E,0x11,0x1E,0x11,0x1E,0x00}},
-        {'C',{0x0E,0x11,0x10,0x11,0x0E,0x00}},
-        {'D',{0x1E,0x11,0x11,0x11,0x1E,0x00}},
-        {'E',{0x1F,0x10,0x1E,0x10,0x1F,0x00}},
-        {'F',{0x1F,0x10,0x1E,0x10,0x10,0x00}},
-        {'G',{0x0F,0x10,0x13,0x11,0x0F,0x00}},
-        {'H',{0x11,0x11,0x1F,0x11,0x11,0x00}},
-        {'I',{0x1F,0x04,0x04,0x04,0x1F,0x00}},
-        {'J',{0x01,0x01,0x01,0x11,0x0E,0x00}},
-        {'K',{0x11,0x12,0x1C,0x12,0x11,0x00}},
-        {'L',{0x10,0x10,0x10,0x10,0x1F,0x00}},
-        {'M',{0x11,0x1B,0x15,0x11,0x11,0x00}},
-        {'N',{0x11,0x19,0x15,0x13,0x11,0x00}},
-        {'O',{0x0E,0x11,0x11,0x11,0x0E,0x00}},
-        {'P',{0x1E,0x11,0x1E,0x10,0x10,0x00}},
-        {'Q',{0x0E,0x11,0x11,0x15,0x0E,0x01}},
-        {'R',{0x1E,0x11,0x1E,0x12,0x11,0x00}},
-        {'S',{0x0F,0x10,0x0E,0x01,0x1E,0x00}},
-        {'T',{0x1F,0x04,0x04,0x04,0x04,0x00}},
-        {'U',{0x11,0x11,0x11,0x11,0x0E,0x00}},
-        {'V',{0x11,0x11,0x11,0x0A,0x04,0x00}},
-        {'W',{0x11,0x11,0x15,0x1B,0x11,0x00}},
-        {'X',{0x11,0x0A,0x04,0x0A,0x11,0x00}},
-        {'Y',{0x11,0x0A,0x04,0x04,0x04,0x00}},
-        {'Z',{0x1F,0x02,0x04,0x08,0x1F,0x00}},
-        {'0',{0x0E,0x13,0x15,0x19,0x0E,0x00}},
-        {'1',{0x04,0x0C,0x04,0x04,0x0E,0x00}},
-        {'2',{0x0E,0x11,0x02,0x04,0x1F,0x00}},
-        {'3',{0x1F,0x02,0x04,0x02,0x1F,0x00}},
-        {'4',{0x02,0x06,0x0A,0x1F,0x02,0x00}},
-        {'5',{0x1F,0x10,0x1E,0x01,0x1E,0x00}},
-        {'6',{0x06,0x08,0x1E,0x11,0x0E,0x00}},
-        {'7',{0x1F,0x01,0x02,0x04,0x08,0x00}},
-        {'8',{0x0E,0x11,0x0E,0x11,0x0E,0x00}},
-        {'9',{0x0E,0x11,0x0F,0x01,0x06,0x00}},
-        {':',{0x00,0x04,0x00,0x04,0x00,0x00}},
-        {'.',{0x00,0x00,0x00,0x00,0x04,0x00}},
-        {'-',{0x00,0x00,0x0E,0x00,0x00,0x00}},
-        {'_',{0x00,0x00,0x00,0x00,0x1F,0x00}},
-    {'/',{0x01,0x02,0x04,0x08,0x10,0x00}},
-        {' ' ,{0x00,0x00,0x00,0x00,0x00,0x00}},
-    {'(' ,{0x06,0x08,0x08,0x08,0x06,0x00}},
-    {')' ,{0x0C,0x02,0x02,0x02,0x0C,0x00}},
-    {'+' ,{0x00,0x04,0x0E,0x04,0x00,0x00}},
-    {'=' ,{0x00,0x0E,0x00,0x0E,0x00,0x00}},
-    {'%' ,{0x19,0x19,0x02,0x04,0x13,0x13}},
-    {',' ,{0x00,0x00,0x00,0x06,0x02,0x04}},
-    {'>' ,{0x10,0x08,0x04,0x08,0x10,0x00}},
-    {'<' ,{0x01,0x02,0x04,0x02,0x01,0x00}},
-    {']' ,{0x1C,0x04,0x04,0x04,0x1C,0x00}},
-    {'[' ,{0x07,0x04,0x04,0x04,0x07,0x00}},
-    };
-
-    const Glyph* findGlyph(char c) {
-        if(c>='a' && c<='z') c = (char)(c - 'a' + 'A');
-        for(const auto &g : kGlyphs) if(g.c==c) return &g;
-        return &kGlyphs[sizeof(kGlyphs)/sizeof(kGlyphs[0]) - 1]; // space fallback
-    }
-
-
     void drawGlyphString(int x,int y,const char* s, uint32_t rgba) {
         uint8_t r=(rgba>>24)&0xFF,g=(rgba>>16)&0xFF,b=(rgba>>8)&0xFF,a=rgba&0xFF;
-        for(const char* p=s; *p; ++p) {
-            const Glyph* gptr = findGlyph(*p);
-            for(int ry=0; ry<6; ++ry) {
-                uint8_t row = gptr->rows[ry];
-                for(int rx=0; rx<5; ++rx) if(row & (1 << (4-rx)))
-                    C2D_DrawRectSolid(x+rx, y+ry, 0, 1,1, C2D_Color32(r,g,b,a));
-            }
-            x += 6;
-            if(x > g_targetWidth-6) break; // dynamic width
-        }
+        const u32 col = C2D_Color32(r,g,b,a);
+        font5x6::layout(x, y, s, g_targetWidth, [col](float rx, float ry, float w, float h) {
+            C2D_DrawRectSolid(rx, ry, 0, w, h, col);
+        });
     }
 }
 
@@ -140,7 +70,7 @@ bool hw_init() {
     romfsInit();
     if (!C3D_Init(C3D_DEFAULT_CMDBUF_SIZE)) { hw_log("C3D_Init FAILED\n"); return false; }
     // Increase max objects budget to reduce risk of overflow when drawing many scaled font quads
-    if (!C2D_Init(C2D_DEFAULT_MAX_OBJECTS * 2)) { hw_log("C2D_Init FAILED\n"); return false; }
+    if (!C2D_Init(kHwMaxObjects)) { hw_log("C2D_Init FAILED\n"); return false; }
     C2D_Prepare();
     g_bottom = C2D_CreateScreenTarget(GFX_BOTTOM, GFX_LEFT);
     g_top = C2D_CreateScreenTarget(GFX_TOP, GFX_LEFT);
@@ -218,6 +148,9 @@ void hw_begin_frame() {
 }
 void hw_end_frame() { C3D_FrameEnd(0); }
 
+uint64_t hw_ticks() { return svcGetSystemTick(); }
+uint64_t hw_ticks_per_second() { return SYSCLOCK_ARM11; }
+
 void hw_draw_sprite(C2D_Image img, float x, float y, float z, float sx, float sy) {
     C2D_DrawImageAt(img, x, y, z, nullptr, sx, sy);
 }
@@ -226,23 +159,11 @@ void hw_draw_text(int x,int y,const char* text, uint32_t rgba) { drawGlyphString
 
 void hw_draw_text_scaled(int x,int y,const char* text, uint32_t rgba, float scale) {
     if(scale <= 1.01f) { hw_draw_text(x,y,text,rgba); return; }
-    float cursorX = (float)x;
     uint8_t r=(rgba>>24)&0xFF,g=(rgba>>16)&0xFF,b=(rgba>>8)&0xFF,a=rgba&0xFF;
-    for(const char* p=text; *p; ++p) {
-        char c = *p;
-        if(c=='\n') { y += (int)std::ceil(6*scale + scale); cursorX = (float)x; continue; }
-        const Glyph* glyph = findGlyph(c);
-        for(int ry=0; ry<6; ++ry) {
-            uint8_t row = glyph->rows[ry];
-            for(int rx=0; rx<5; ++rx) if(row & (1<<(4-rx))) {
-                float px = cursorX + rx*scale;
-                float py = (float)y + ry*scale;
-                C2D_DrawRectSolid(px, py, 0, scale, scale, C2D_Color32(r,g,b,a));
-            }
-        }
-    cursorX += 6*scale;
-    if(cursorX > 400 - 6*scale) break;
-    }
+    const u32 col = C2D_Color32(r,g,b,a);
+    font5x6::layout_scaled(x, y, text, scale, [col](float px, float py, float w, float h) {
+        C2D_DrawRectSolid(px, py, 0, w, h, col);
+    });
 }
 
 void hw_draw_text_shadow_scaled(int x,int y,const char* text, uint32_t mainRGBA, uint32_t shadowRGBA, float scale) {
@@ -254,29 +175,11 @@ void hw_draw_text_shadow_scaled(int x,int y,const char* text, uint32_t mainRGBA,
     auto drawLayer = [&](int ox,int oy,uint32_t rgba){
         if((rgba & 0xFF)==0) return; // skip if alpha zero
         uint8_t r=(rgba>>24)&0xFF,g=(rgba>>16)&0xFF,b=(rgba>>8)&0xFF,a=rgba&0xFF;
-        float cursorX = (float)(x+ox);
-        int baseY = y+oy;
-        for(const char* p=text; *p; ++p) {
-            char c=*p; if(c=='\n'){ baseY += (int)std::ceil(6*scale + scale); cursorX=(float)(x+ox); continue; }
-            const Glyph* glyph = findGlyph(c);
-            // For each row merge consecutive set bits into one rect
-            for(int ry=0; ry<6; ++ry) {
-                uint8_t row = glyph->rows[ry];
-                int rx=0;
-                while(rx<5) {
-                    while(rx<5 && !(row & (1<<(4-rx)))) ++rx; // skip unset
-                    if(rx>=5) break;
-                    int start=rx;
-                    while(rx<5 && (row & (1<<(4-rx)))) ++rx; // advance run
-                    int run = rx-start;
-                    float px = cursorX + start*scale;
-                    float py = (float)baseY + ry*scale;
-                    C2D_DrawRectSolid(px, py, 0, run*scale, scale, C2D_Color32(r,g,b,a));
-                }
-            }
-            cursorX += 6*scale;
-            if(cursorX > 400 - 6*scale) break;
-        }
+        const u32 col = C2D_Color32(r,g,b,a);
+        // For each row merge consecutive set bits into one rect
+        font5x6::layout_scaled_runs(x+ox, y+oy, text, scale, [col](float px, float py, float w, float h) {
+            C2D_DrawRectSolid(px, py, 0, w, h, col);
+        });
     };
     // Shadow first
     drawLayer(1,1,shadowRGBA);
@@ -292,16 +195,7 @@ void hw_draw_logs(int x,int y,int maxPixelsY) {
     if(start<0) start=0;
     int yy=y;
     for(size_t i=start;i<g_logs.size();++i) {
-        int xx=x;
-        for(char c : g_logs[i]) {
-            const Glyph* g = findGlyph(c);
-            for(int ry=0; ry<6; ++ry) {
-                uint8_t row = g->rows[ry];
-                for(int rx=0; rx<5; ++rx) if(row & (1<<(4-rx))) C2D_DrawRectSolid(xx+rx, yy+ry, 0,1,1,C2D_Color32(180,180,180,255));
-            }
-            xx += 6;
-        if(xx > g_targetWidth-6) break;
-        }
+        drawGlyphString(x, yy, g_logs[i].c_str(), C2D_Color32(180,180,180,255));
     yy += lineH;
     if(yy + lineH > y + maxPixelsY) break;
     }
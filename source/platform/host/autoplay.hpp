@@ -0,0 +1,157 @@
+// autoplay.hpp - a bot that plays levels through InputState, steering by predicted landings
+#pragma once
+#include <cstdint>
+#include "hardware.hpp"
+#include "game.hpp"
+
+// The bot sees only game_observe() and answers with the input a player would give: it holds
+// the stylus down and drags the bat (the game moves the bat by the drag distance from where
+// the touch began) so the earliest regular ball lands off-centre on it, keeps out of the way
+// of murder balls, launches a locked ball with a flick and a release, and presses TILT when
+// no required brick has gone for a while. Deterministic for a given seed and policy.
+namespace autoplay {
+
+// How the bot plays; the defaults are the autoplayer's, the difficulty estimator varies them
+struct Policy {
+    int launchFlick = 6;         // stylus px flicked before release (sets the launch angle, max kMaxStep)
+    float aimSpread = 0.35f;     // landing offsets on the bat, as a fraction of its collision width
+    int murderDodgeTicks = 45;   // murder balls closer than this are dodged
+    int stuckTicks = 900;        // ticks without progress before tilting
+};
+
+class Bot {
+public:
+    static constexpr int kStylusMin = 0, kStylusMax = 319;
+    static constexpr int kMaxStep = 10;       // stylus px per tick (about 600 px/s)
+
+    explicit Bot(uint32_t seed = 1u, const Policy &policy = Policy()) : seed_(seed ? seed : 1u), policy_(policy) {}
+
+    // Forget the drag and progress state (new level or restart)
+    void reset() { touching_ = false; launchPhase_ = 0; lastBricks_ = -1; idleTicks_ = 0; offset_ = 0.f; aimTicks_ = -1; }
+
+    int tilts() const { return tilts_; }
+    int launches() const { return launches_; }
+
+    InputState next(const GameObservation &o) {
+        InputState in;
+        if (!o.playing || o.gameOver || o.deathActive) { release(); return in; }
+        track_progress(o);
+        if (o.ballLocked) launch(o, in);
+        else steer(o, in);
+        if (o.tiltAvailable && idleTicks_ >= policy_.stuckTicks && o.balls > 0) {
+            in.dpadDownPressed = true;
+            ++tilts_;
+            idleTicks_ = 0;
+        }
+        return in;
+    }
+
+private:
+    uint32_t rnd() { seed_ ^= seed_ << 13; seed_ ^= seed_ >> 17; seed_ ^= seed_ << 5; return seed_; }
+
+    void release() { touching_ = false; launchPhase_ = 0; }
+
+    void track_progress(const GameObservation &o) {
+        if (o.bricksLeft != lastBricks_) { lastBricks_ = o.bricksLeft; idleTicks_ = 0; }
+        else ++idleTicks_;
+    }
+
+    // Touch down at stylusX (anchoring the drag at the current bat position) or move towards it
+    void touch(const GameObservation &o, InputState &in, int stylusX) {
+        if (!touching_) {
+            touching_ = true;
+            anchorStylus_ = stylusX_ = stylusX;
+            anchorBat_ = o.batX;
+            in.touchPressed = true;
+        } else {
+            int step = stylusX - stylusX_;
+            if (step > kMaxStep) step = kMaxStep;
+            if (step < -kMaxStep) step = -kMaxStep;
+            stylusX_ += step;
+        }
+        in.touching = true;
+        in.stylusX = stylusX_;
+        in.stylusY = 200;
+    }
+
+    // Stylus x that drags the bat's left edge to batX from the current anchor
+    int stylus_for(const GameObservation &o, float batX) const {
+        float dx = batX - anchorBat_;
+        if (o.reverseControls) dx = -dx;
+        return anchorStylus_ + (int)(dx + (dx < 0 ? -0.5f : 0.5f));
+    }
+
+    // Touch, flick a few pixels one way, release: the ball leaves with the flick's momentum
+    void launch(const GameObservation &o, InputState &in) {
+        switch (launchPhase_) {
+        case 0:
+            if (touching_) { touching_ = false; return; } // lift first so the next touch anchors
+            touch(o, in, 160);
+            launchDir_ = (rnd() & 1) ? 1 : -1;
+            launchPhase_ = 1;
+            break;
+        case 1:
+            touch(o, in, stylusX_ + launchDir_ * policy_.launchFlick);
+            launchPhase_ = 2;
+            break;
+        default:
+            touching_ = false; // release launches
+            launchPhase_ = 0;
+            ++launches_;
+            break;
+        }
+    }
+
+    void steer(const GameObservation &o, InputState &in) {
+        launchPhase_ = 0;
+        // Aim point on the bat: re-picked for each approach so rebounds vary in angle
+        float aimX = o.trackX;
+        if (o.landing) {
+            if (aimTicks_ < 0 || o.landingTicks > aimTicks_ + 2) {
+                const float spread = o.batCollWidth * policy_.aimSpread;
+                offset_ = spread * ((float)(rnd() % 201) / 100.0f - 1.0f);
+            }
+            aimTicks_ = o.landingTicks;
+            aimX = o.landingX;
+        } else {
+            aimTicks_ = -1;
+        }
+        float batX = aimX - offset_ - o.batWidth * 0.5f;
+        // A murder ball about to land under the bat: stand clear of it instead
+        if (o.murderLanding && o.murderTicks < policy_.murderDodgeTicks && (!o.landing || o.murderTicks < o.landingTicks)) {
+            const float clear = o.batWidth * 0.5f + 8.0f;
+            const float centre = batX + o.batWidth * 0.5f;
+            if (centre > o.murderX - clear && centre < o.murderX + clear)
+                batX = (centre < o.murderX ? o.murderX - clear : o.murderX + clear) - o.batWidth * 0.5f;
+        }
+        if (batX < o.batMinX) batX = o.batMinX;
+        if (batX > o.batMaxX) batX = o.batMaxX;
+        if (!touching_) {
+            // Touch down on the side away from the target so the drag has room to get there
+            float dx = batX - o.batX;
+            if (o.reverseControls) dx = -dx;
+            int at = 160 - (int)(dx * 0.5f);
+            touch(o, in, at < 10 ? 10 : (at > 309 ? 309 : at));
+            return;
+        }
+        int want = stylus_for(o, batX);
+        if (want < kStylusMin || want > kStylusMax) {
+            touching_ = false; // out of reach from this anchor: lift and touch down again
+            return;
+        }
+        touch(o, in, want);
+    }
+
+    uint32_t seed_;
+    Policy policy_;
+    bool touching_ = false;
+    int stylusX_ = 160, anchorStylus_ = 160;
+    float anchorBat_ = 0.f;
+    int launchPhase_ = 0, launchDir_ = 1;
+    int lastBricks_ = -1, idleTicks_ = 0;
+    float offset_ = 0.f;
+    int aimTicks_ = -1;
+    int tilts_ = 0, launches_ = 0;
+};
+
+} // namespace autoplay
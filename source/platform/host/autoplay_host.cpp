@@ -0,0 +1,233 @@
+// Host autoplayer: plays every level of a pack with autoplay::Bot and reports what it cost.
+//
+// Each level starts as a fresh game (game_start_level) and is played until it is cleared, the
+// game is over or --max-frames ticks have passed; a failed attempt is retried up to
+// --attempts times. The bot acts only through InputState, so the runs exercise the same paths
+// as a player. Per level it reports the ticks of the clearing attempt, ticks over all
+// attempts, lives lost, TILT presses, launches, peak ball and particle counts, and the worst
+// and mean game_update() time. Results go to stdout, and to --csv / --json files.
+//
+// Every level gets its own bot, seeded from --seed and the level number, so its result does not
+// depend on the levels played before it. With --threads N the levels are shared out over N
+// threads, each playing in its own GameWorld; the results are the same as with one thread.
+//
+// Usage: ballistica_autoplay [--pack NAME.DAT] [--attempts N] [--max-frames N] [--seed N]
+//                            [--threads N] [--render] [--csv FILE] [--json FILE] [--sdmc DIR]
+//                            [--romfs DIR]
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include "hardware.hpp"
+#include "game.hpp"
+#include "levels.hpp"
+#include "sound.hpp"
+#include "options.hpp"
+#include "autoplay.hpp"
+
+namespace {
+
+struct LevelReport {
+    int level = 0;
+    std::string name;
+    bool cleared = false;
+    int attempts = 0;
+    long clearFrames = -1;    // ticks of the attempt that cleared it
+    long totalFrames = 0;     // ticks over every attempt
+    int livesLost = 0;
+    int tilts = 0;
+    int launches = 0;
+    int peakBalls = 0;
+    int peakParticles = 0;
+    double worstUpdateUs = 0.0;
+    double totalUpdateUs = 0.0;
+};
+
+struct Config {
+    int attempts = 3;
+    long maxFrames = 36000; // 10 minutes at 60 fps
+    uint32_t seed = 1;
+    int threads = 1;
+    bool render = false;
+};
+
+LevelReport play_level(GameWorld& world, int index, const Config& cfg) {
+    LevelReport rep;
+    rep.level = index;
+    rep.name = levels_get_name(index);
+    autoplay::Bot bot(cfg.seed + (uint32_t)index * 2654435761u);
+    GameObservation obs;
+    for (int attempt = 0; attempt < cfg.attempts && !rep.cleared; ++attempt) {
+        ++rep.attempts;
+        game_start_level(world, index);
+        bot.reset();
+        game_observe(world, obs);
+        const uint32_t completed0 = obs.levelsCompleted;
+        const int tilts0 = bot.tilts(), launches0 = bot.launches();
+        int prevLives = obs.lives;
+        long f = 0;
+        for (; f < cfg.maxFrames; ++f) {
+            InputState in = bot.next(obs);
+            auto t0 = std::chrono::steady_clock::now();
+            game_update(world, in);
+            auto t1 = std::chrono::steady_clock::now();
+            const double us = std::chrono::duration<double, std::micro>(t1 - t0).count();
+            rep.totalUpdateUs += us;
+            if (us > rep.worstUpdateUs) rep.worstUpdateUs = us;
+            if (cfg.threads == 1) sound::update();
+            if (cfg.render) {
+                hw_begin_frame();
+                hw_set_top();
+                game_render(world);
+                hw_end_frame();
+            }
+            game_observe(world, obs);
+            if (obs.lives < prevLives) rep.livesLost += prevLives - obs.lives;
+            prevLives = obs.lives;
+            if (obs.balls > rep.peakBalls) rep.peakBalls = obs.balls;
+            if (obs.particles > rep.peakParticles) rep.peakParticles = obs.particles;
+            if (obs.levelsCompleted != completed0) { rep.cleared = true; ++f; break; }
+            if (obs.gameOver || !obs.playing) { ++f; break; }
+        }
+        rep.totalFrames += f;
+        if (rep.cleared) rep.clearFrames = f;
+        rep.tilts += bot.tilts() - tilts0;
+        rep.launches += bot.launches() - launches0;
+    }
+    return rep;
+}
+
+// Plays every level into reps (indexed by level). One thread uses the default world; more take
+// levels off a shared counter, each in a world of its own.
+void play_all(const Config& cfg, std::vector<LevelReport>& reps) {
+    const int count = (int)reps.size();
+    if (cfg.threads == 1) {
+        for (int L = 0; L < count; ++L) reps[L] = play_level(game_default_world(), L, cfg);
+        return;
+    }
+    std::atomic<int> next(0);
+    std::vector<GameWorld*> worlds;
+    for (int t = 0; t < cfg.threads; ++t) {
+        worlds.push_back(game_world_create());
+        game_set_seed(*worlds.back(), cfg.seed);
+    }
+    std::vector<std::thread> pool;
+    for (int t = 0; t < cfg.threads; ++t)
+        pool.emplace_back([&, t]() {
+            for (int L = next++; L < count; L = next++) reps[L] = play_level(*worlds[t], L, cfg);
+        });
+    for (std::thread& th : pool) th.join();
+    for (GameWorld* w : worlds) game_world_destroy(w);
+}
+
+// Level names come from the pack; keep them to characters that need no quoting
+std::string plain(const std::string& s) {
+    std::string out;
+    for (char c : s) out += (c == '"' || c == '\\' || c == ',' || (unsigned char)c < 0x20) ? ' ' : c;
+    return out;
+}
+
+bool write_csv(const char* path, const char* pack, const std::vector<LevelReport>& reps) {
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+    fprintf(f, "pack,level,name,cleared,attempts,clear_frames,total_frames,lives_lost,tilts,launches,"
+               "peak_balls,peak_particles,worst_update_us,mean_update_us\n");
+    for (const LevelReport& r : reps)
+        fprintf(f, "%s,%d,%s,%d,%d,%ld,%ld,%d,%d,%d,%d,%d,%.2f,%.3f\n", pack, r.level + 1, plain(r.name).c_str(),
+                r.cleared ? 1 : 0, r.attempts, r.clearFrames, r.totalFrames, r.livesLost, r.tilts, r.launches,
+                r.peakBalls, r.peakParticles, r.worstUpdateUs, r.totalFrames ? r.totalUpdateUs / r.totalFrames : 0.0);
+    return fclose(f) == 0;
+}
+
+bool write_json(const char* path, const char* pack, uint32_t seed, const std::vector<LevelReport>& reps) {
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+#ifdef BALLISTICA_FIXED_SIM
+    const char* sim = "fixed";
+#else
+    const char* sim = "float";
+#endif
+    fprintf(f, "{\n  \"pack\": \"%s\",\n  \"seed\": %u,\n  \"sim\": \"%s\",\n  \"levels\": [\n", plain(pack).c_str(), seed, sim);
+    for (size_t i = 0; i < reps.size(); ++i) {
+        const LevelReport& r = reps[i];
+        fprintf(f, "    {\"level\": %d, \"name\": \"%s\", \"cleared\": %s, \"attempts\": %d, \"clear_frames\": %ld, "
+                   "\"total_frames\": %ld, \"lives_lost\": %d, \"tilts\": %d, \"launches\": %d, \"peak_balls\": %d, "
+                   "\"peak_particles\": %d, \"worst_update_us\": %.2f, \"mean_update_us\": %.3f}%s\n",
+                r.level + 1, plain(r.name).c_str(), r.cleared ? "true" : "false", r.attempts, r.clearFrames,
+                r.totalFrames, r.livesLost, r.tilts, r.launches, r.peakBalls, r.peakParticles, r.worstUpdateUs,
+                r.totalFrames ? r.totalUpdateUs / r.totalFrames : 0.0, i + 1 < reps.size() ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+    return fclose(f) == 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const char* pack = nullptr;
+    const char* csvPath = nullptr;
+    const char* jsonPath = nullptr;
+    const char* sdmc = "build-host/autoplay_sdmc";
+    const char* romfs = nullptr;
+    Config cfg;
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--pack") && i + 1 < argc) pack = argv[++i];
+        else if (!strcmp(argv[i], "--attempts") && i + 1 < argc) cfg.attempts = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--max-frames") && i + 1 < argc) cfg.maxFrames = atol(argv[++i]);
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc) cfg.seed = (uint32_t)strtoul(argv[++i], nullptr, 0);
+        else if (!strcmp(argv[i], "--threads") && i + 1 < argc) cfg.threads = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--render")) cfg.render = true;
+        else if (!strcmp(argv[i], "--csv") && i + 1 < argc) csvPath = argv[++i];
+        else if (!strcmp(argv[i], "--json") && i + 1 < argc) jsonPath = argv[++i];
+        else if (!strcmp(argv[i], "--sdmc") && i + 1 < argc) sdmc = argv[++i];
+        else if (!strcmp(argv[i], "--romfs") && i + 1 < argc) romfs = argv[++i];
+        else {
+            fprintf(stderr, "usage: %s [--pack NAME.DAT] [--attempts N] [--max-frames N] [--seed N] [--threads N]"
+                            " [--render] [--csv FILE] [--json FILE] [--sdmc DIR] [--romfs DIR]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (cfg.attempts < 1) cfg.attempts = 1;
+    if (cfg.threads < 1) cfg.threads = 1;
+    if (cfg.render) cfg.threads = 1; // the draw counters are not shared safely
+    hw_host_set_dirs(sdmc, romfs);
+    if (!hw_init()) { fprintf(stderr, "hw_init failed (no IMAGE sheet table)\n"); return 1; }
+    options::load_settings();
+    sound::init();
+    game_init();
+    game_set_seed(cfg.seed);
+    if (pack) {
+        levels_set_active_file(pack);
+        levels_reload_active();
+        const char* active = levels_get_active_file();
+        if (!active || strcmp(active, pack) != 0 || levels_count() <= 0) {
+            fprintf(stderr, "cannot load level pack %s\n", pack);
+            return 1;
+        }
+    }
+    const std::string packName = levels_get_active_file() ? levels_get_active_file() : "?";
+
+    std::vector<LevelReport> reps(levels_count() > 0 ? levels_count() : 0);
+    play_all(cfg, reps);
+    printf("%-5s %-20s %-7s %3s %8s %8s %5s %5s %6s %9s %10s %10s\n", "level", "name", "result", "try", "clear",
+           "total", "lives", "tilts", "balls", "particles", "worst us", "mean us");
+    for (const LevelReport& r : reps) {
+        printf("%-5d %-20.20s %-7s %3d %8ld %8ld %5d %5d %6d %9d %10.1f %10.2f\n", r.level + 1, r.name.c_str(),
+               r.cleared ? "cleared" : "failed", r.attempts, r.clearFrames, r.totalFrames, r.livesLost, r.tilts,
+               r.peakBalls, r.peakParticles, r.worstUpdateUs, r.totalFrames ? r.totalUpdateUs / r.totalFrames : 0.0);
+    }
+    int cleared = 0;
+    for (const LevelReport& r : reps) cleared += r.cleared;
+    printf("%s: %d/%d levels cleared\n", packName.c_str(), cleared, (int)reps.size());
+
+    int rc = 0;
+    if (csvPath && !write_csv(csvPath, packName.c_str(), reps)) { fprintf(stderr, "cannot write %s\n", csvPath); rc = 1; }
+    if (jsonPath && !write_json(jsonPath, packName.c_str(), cfg.seed, reps)) { fprintf(stderr, "cannot write %s\n", jsonPath); rc = 1; }
+    sound::shutdown();
+    hw_shutdown();
+    return rc;
+}
@@ -0,0 +1,435 @@
+// Host microbenchmarks for the gameplay, level and font hot paths (make PLATFORM=host bench).
+//
+// Built with -DBALLISTICA_BENCH, which compiles the hooks in bench_hooks.hpp into game.cpp
+// and levels.cpp. Every shipped romfs pack and a generated pack of worst cases (a dense
+// multi-hit board, sliders in every row, a board of bombs, bombs checkered with bricks) is
+// measured with:
+//   handle_ball_bricks    64 balls placed in empty cells, one swept step each (per ball)
+//   update_moving_bricks  one tick of every sliding brick
+//   bomb_chain            event-wheel ticks until a chain started at each bomb ends (per detonation)
+//   levels_explode_bomb   the cluster blast from each bomb cell
+//   levels_parse          levels::parseAll over the whole pack, read from memory
+//   game_update / game_render  scripted play on every level of the pack (per tick)
+// plus hw_draw_text* on HUD-style and worst-case strings through the real font layout.
+// Calls per frame come from the call counters during the scripted play; allocations are
+// counted by replacing the global operator new. Prints a table and, with --json FILE, writes
+// a machine-readable report so optimisation work can be compared between commits. Gameplay
+// checks that need the hooks (see check_murder_and_bottom_loss) run first; a failure makes the
+// exit status non-zero.
+//
+// Usage: ballistica_bench [--json FILE] [--label TEXT] [--quick] [--romfs DIR] [--sdmc DIR]
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+#include "hardware.hpp"
+#include "game.hpp"
+#include "levels.hpp"
+#include "brick.hpp"
+#include "sound.hpp"
+#include "options.hpp"
+#include "bench_hooks.hpp"
+#include "host_script.hpp"
+
+// ---- allocation counting -------------------------------------------------------------------
+namespace {
+    uint64_t g_allocs = 0, g_allocBytes = 0;
+}
+void* operator new(size_t n) {
+    ++g_allocs; g_allocBytes += n;
+    void* p = malloc(n ? n : 1);
+    if (!p) abort();
+    return p;
+}
+void* operator new[](size_t n) { return operator new(n); }
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+// Time, calls and allocations accumulated over begin()/end() pairs
+struct Meter {
+    uint64_t ns = 0, calls = 0, allocs = 0, bytes = 0;
+    Clock::time_point t0;
+    uint64_t a0 = 0, b0 = 0;
+    void begin() { a0 = g_allocs; b0 = g_allocBytes; t0 = Clock::now(); }
+    void end(uint64_t n) {
+        Clock::time_point t1 = Clock::now();
+        ns += (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+        calls += n; allocs += g_allocs - a0; bytes += g_allocBytes - b0;
+    }
+};
+
+struct Result {
+    std::string name, scenario;
+    Meter m;
+    double perFrame; // < 0: not a per-frame routine
+};
+std::vector<Result> g_results;
+
+void report(const char* name, const std::string& scenario, const Meter& m, double perFrame) {
+    if (!m.calls) return;
+    Result r; r.name = name; r.scenario = scenario; r.m = m; r.perFrame = perFrame;
+    g_results.push_back(r);
+}
+
+uint32_t g_seed = 12345u;
+uint32_t rnd() { g_seed = g_seed * 1664525u + 1013904223u; return g_seed >> 8; }
+float frand(float lo, float hi) { return lo + (hi - lo) * (float)(rnd() & 0xFFFF) / 65535.0f; }
+
+const char* const kPacks[] = { "LEVELS.DAT", "NASTY.DAT", "SPIKE1.DAT", "SPIKE2.DAT", "SPIKE3.DAT",
+                               "SPIKE4.DAT", "LEVBAK.DAT" };
+const char* const kSyntheticPack = "BENCHSYN.DAT";
+const int kCols = 13, kRows = 13;
+const int kBenchBalls = 64;
+
+struct Config {
+    int reps = 20;            // repeats of the per-level micro loops
+    int playTicks = 600;      // scripted ticks per level for calls per frame
+    int fontCalls = 20000;
+};
+
+// ---- synthetic worst cases -----------------------------------------------------------------
+const char* dense(int c, int r) { return r < 9 ? ((c + r) % 4 == 0 ? "ID" : "T5") : "NB"; }
+const char* sliders(int c, int) { return (c % 2 == 0) ? "SS" : "NB"; }
+const char* bombs(int, int) { return "BO"; }
+const char* bomb_checker(int c, int r) { return ((c + r) & 1) ? "YB" : "BO"; }
+
+std::string synthetic_pack() {
+    struct Gen { const char* name; const char* (*cell)(int, int); };
+    static const Gen kGens[] = { { "Dense multi-hit", dense }, { "Sliders everywhere", sliders },
+                                 { "Bomb field", bombs }, { "Bomb checker", bomb_checker } };
+    std::string out = "MAXLEVEL 4\n\n";
+    int n = 0;
+    for (const Gen& g : kGens) {
+        char head[96];
+        snprintf(head, sizeof head, "LEVEL %d\nSPEED 10\nNAME %s\n", ++n, g.name);
+        out += head;
+        for (int r = 0; r < kRows; ++r) {
+            out += '\t';
+            for (int c = 0; c < kCols; ++c) { out += g.cell(c, r); out += ' '; }
+            out += '\n';
+        }
+        out += '\n';
+    }
+    return out;
+}
+
+bool read_file(const std::string& path, std::string& out) {
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) return false;
+    char buf[4096]; size_t r;
+    out.clear();
+    while ((r = fread(buf, 1, sizeof buf, f)) > 0) out.append(buf, r);
+    fclose(f);
+    return true;
+}
+
+// ---- per-pack measurements -----------------------------------------------------------------
+void bench_parse(const std::string& scenario, const std::string& bytes, const Config& cfg) {
+    Meter m;
+    for (int i = 0; i < cfg.reps; ++i) {
+        FILE* f = fmemopen((void*)bytes.data(), bytes.size(), "rb");
+        if (!f) return;
+        m.begin();
+        bench_hooks::parse(f);
+        m.end(1);
+        fclose(f);
+    }
+    report("levels_parse", scenario, m, -1.0);
+}
+
+// Scripted play on every level; fills calls per tick for the routines below
+struct PlayRates { double ballBricks, moving, detonations, explode, texts; };
+PlayRates bench_play(const std::string& scenario, const Config& cfg) {
+    uint64_t c0[bench_hooks::kCounters];
+    memcpy(c0, bench_hooks::g_calls, sizeof c0);
+    const uint64_t texts0 = hw_host_stats().texts, frames0 = hw_host_stats().frames;
+    Meter update, render;
+    for (int L = 0; L < levels_count(); ++L) {
+        bench_hooks::start_level(L);
+        bool touching = false;
+        for (long f = 0; f < cfg.playTicks; ++f) {
+            if (game_mode() != GameMode::Playing) bench_hooks::start_level(L); // game over: go again
+            InputState in = host_script::input(f, game_mode(), touching);
+            touching = in.touching;
+            update.begin(); game_update(in); update.end(1);
+            hw_begin_frame();
+            hw_set_top();
+            render.begin(); game_render(); render.end(1);
+            hw_end_frame();
+        }
+    }
+    const double ticks = (double)(bench_hooks::g_calls[bench_hooks::Ticks] - c0[bench_hooks::Ticks]);
+    auto rate = [&](int c) { return ticks > 0 ? (double)(bench_hooks::g_calls[c] - c0[c]) / ticks : 0.0; };
+    PlayRates pr;
+    pr.ballBricks = rate(bench_hooks::BallBricks);
+    pr.moving = rate(bench_hooks::MovingBricks);
+    pr.detonations = rate(bench_hooks::BombDetonations);
+    pr.explode = rate(bench_hooks::ExplodeBomb);
+    const uint64_t frames = hw_host_stats().frames - frames0;
+    pr.texts = frames ? (double)(hw_host_stats().texts - texts0) / frames : 0.0;
+    report("game_update", scenario, update, 1.0);
+    report("game_render", scenario, render, 1.0);
+    return pr;
+}
+
+void bench_ball_bricks(const std::string& scenario, const Config& cfg, double perFrame) {
+    Meter m;
+    const float cw = (float)levels_brick_width(), ch = (float)levels_brick_height();
+    const float left = (float)levels_left(), top = (float)levels_top();
+    for (int L = 0; L < levels_count(); ++L) {
+        bench_hooks::start_level(L);
+        bench_hooks::moving_bricks(); // place the sliders so the sweep sees them
+        std::vector<int> empty;
+        for (int i = 0; i < kCols * kRows; ++i)
+            if (levels_brick_at(i % kCols, i / kCols) <= 0) empty.push_back(i);
+        bench_hooks::clear_balls();
+        for (int b = 0; b < kBenchBalls; ++b) {
+            float x, y;
+            if (!empty.empty()) {
+                int cell = empty[rnd() % empty.size()];
+                x = left + (cell % kCols) * cw + cw * 0.5f - 3.0f;
+                y = top + (cell / kCols) * ch + ch * 0.5f - 3.0f;
+            } else { // full board: come up from just below it
+                x = frand(left, left + kCols * cw - 6.0f);
+                y = top + kRows * ch + 2.0f;
+            }
+            const float a = frand(0.3f, 2.84f) * ((rnd() & 1) ? 1.0f : -1.0f);
+            const float speed = frand(2.0f, 4.0f);
+            bench_hooks::add_ball(x, y, std::cos(a) * speed, std::sin(a) * speed);
+        }
+        bench_hooks::save_balls();
+        for (int i = 0; i < cfg.reps; ++i) {
+            bench_hooks::restore_balls();
+            levels_reset_level(L);
+            m.begin();
+            int n = bench_hooks::ball_bricks();
+            m.end((uint64_t)n);
+        }
+    }
+    report("handle_ball_bricks", scenario, m, perFrame);
+}
+
+void bench_moving_bricks(const std::string& scenario, const Config& cfg, double perFrame) {
+    Meter m;
+    const int ticks = cfg.reps * 16;
+    for (int L = 0; L < levels_count(); ++L) {
+        bench_hooks::start_level(L);
+        m.begin();
+        for (int i = 0; i < ticks; ++i) bench_hooks::moving_bricks();
+        m.end((uint64_t)ticks);
+    }
+    report("update_moving_bricks", scenario, m, perFrame);
+}
+
+void bench_bombs(const std::string& scenario, double detonationsPerFrame, double explodePerFrame) {
+    Meter chain, blast;
+    static std::vector<DestroyedBrick> list; // reused like the game's list
+    list.reserve(kCols * kRows);
+    for (int L = 0; L < levels_count(); ++L) {
+        bench_hooks::start_level(L);
+        std::vector<int> bombCells;
+        for (int i = 0; i < kCols * kRows; ++i)
+            if (levels_brick_at(i % kCols, i / kCols) == (int)BrickType::BO) bombCells.push_back(i);
+        for (int cell : bombCells) {
+            const int c = cell % kCols, r = cell / kCols;
+            // Chain driven through the event wheel, as in play
+            bench_hooks::start_level(L);
+            if (bench_hooks::trigger_bomb(c, r)) {
+                const uint64_t d0 = bench_hooks::g_calls[bench_hooks::BombDetonations];
+                bool more = true;
+                for (int t = 0; more && t < 4000; ++t) {
+                    chain.begin();
+                    more = bench_hooks::bomb_tick();
+                    chain.end(0);
+                }
+                chain.calls += bench_hooks::g_calls[bench_hooks::BombDetonations] - d0;
+            }
+            // Whole-cluster blast from this cell
+            levels_reset_level(L);
+            list.clear();
+            blast.begin();
+            levels_explode_bomb(c, r, &list);
+            blast.end(1);
+        }
+    }
+    report("bomb_chain", scenario, chain, detonationsPerFrame);
+    report("levels_explode_bomb", scenario, blast, explodePerFrame);
+}
+
+// Returns false if the pack would not load; textsPerFrame gets the text calls per rendered frame
+bool run_pack(const char* name, const std::string& bytes, const std::string& scenario, const Config& cfg,
+              double* textsPerFrame = nullptr) {
+    bench_parse(scenario, bytes, cfg);
+    levels_set_active_file(name);
+    levels_reload_active();
+    const char* active = levels_get_active_file();
+    if (levels_count() <= 0 || !active || strcmp(active, name) != 0) {
+        fprintf(stderr, "bench: cannot load %s\n", name);
+        return false;
+    }
+    PlayRates pr = bench_play(scenario, cfg);
+    if (textsPerFrame) *textsPerFrame = pr.texts;
+    bench_ball_bricks(scenario, cfg, pr.ballBricks);
+    bench_moving_bricks(scenario, cfg, pr.moving);
+    bench_bombs(scenario, pr.detonations, pr.explode);
+    return true;
+}
+
+// ---- gameplay checks -----------------------------------------------------------------------
+// A murder ball hits the bat and the last regular ball drops out in the same tick. The hit
+// starts the death sequence, which stops every ball, so the tick costs exactly one life and the
+// ball count kept across the loop must not let the fallen ball act on a stale total
+bool check_murder_and_bottom_loss() {
+    bench_hooks::start_level(0);
+    bench_hooks::clear_balls();
+    float x, y, vy;
+    bench_hooks::bat_landing(x, y, vy);
+    bench_hooks::add_murder_ball(x, y, 0.f, vy);
+    bench_hooks::add_ball(160.f, bench_hooks::bottom_y() + 1.f, 0.f, 1.f);
+    game_update(InputState());
+    const int lives = bench_hooks::lives(), balls = bench_hooks::active_balls();
+    if (lives == 2 && balls == 0) return true;
+    fprintf(stderr, "bench: murder ball on the bat plus a bottom loss left %d lives and %d balls, expected 2 and 0\n",
+            lives, balls);
+    return false;
+}
+
+// ---- font ----------------------------------------------------------------------------------
+void bench_font(const Config& cfg, double textsPerFrame) {
+    static const char kAll[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789:.-_/ ()+=%,><][ABCDEFGHIJKLMN";
+    static const char kLines[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ\n0123456789:.-_/ ()+=%,><][\nABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    struct Case { const char* name; const char* scenario; const char* text; int kind; float scale; };
+    static const Case kCases[] = {
+        { "hw_draw_text", "hud", "SCORE 0012340", 0, 1.0f },
+        { "hw_draw_text_scaled", "hud", "LEVEL 01", 1, 2.0f },
+        { "hw_draw_text_shadow_scaled", "hud", "GAME OVER", 2, 3.0f },
+        { "hw_draw_text", "synthetic", kAll, 0, 1.0f },
+        { "hw_draw_text_scaled", "synthetic", kLines, 1, 2.0f },
+        { "hw_draw_text_shadow_scaled", "synthetic", kLines, 2, 2.0f },
+    };
+    hw_set_top();
+    for (const Case& k : kCases) {
+        Meter m;
+        m.begin();
+        for (int i = 0; i < cfg.fontCalls; ++i) {
+            if (k.kind == 0) hw_draw_text(2, 2, k.text, 0xFFFFFFFF);
+            else if (k.kind == 1) hw_draw_text_scaled(2, 2, k.text, 0xFFFFFFFF, k.scale);
+            else hw_draw_text_shadow_scaled(2, 2, k.text, 0xFFFFFFFF, 0x000000FF, k.scale);
+        }
+        m.end((uint64_t)cfg.fontCalls);
+        // Text calls of every kind per rendered frame, from the scripted play
+        const bool hud = strcmp(k.scenario, "hud") == 0 && k.kind == 0;
+        report(k.name, k.scenario, m, hud ? textsPerFrame : -1.0);
+    }
+}
+
+// ---- output --------------------------------------------------------------------------------
+void print_table() {
+    printf("%-28s %-12s %12s %10s %10s %10s %10s\n", "routine", "scenario", "ns/call", "calls", "calls/frm",
+           "allocs/cl", "bytes/cl");
+    for (const Result& r : g_results) {
+        const double calls = (double)r.m.calls;
+        char perFrame[32] = "-";
+        if (r.perFrame >= 0) snprintf(perFrame, sizeof perFrame, "%.3f", r.perFrame);
+        printf("%-28s %-12s %12.1f %10llu %10s %10.3f %10.1f\n", r.name.c_str(), r.scenario.c_str(),
+               (double)r.m.ns / calls, (unsigned long long)r.m.calls, perFrame, r.m.allocs / calls, r.m.bytes / calls);
+    }
+}
+
+std::string json_string(const char* s) {
+    std::string out = "\"";
+    for (; s && *s; ++s) {
+        if (*s == '"' || *s == '\\') out += '\\';
+        if ((unsigned char)*s >= 0x20) out += *s;
+    }
+    return out + "\"";
+}
+
+bool write_json(const char* path, const char* label) {
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+#ifdef BALLISTICA_FIXED_SIM
+    const char* sim = "fixed";
+#else
+    const char* sim = "float";
+#endif
+    fprintf(f, "{\n  \"label\": %s,\n  \"sim\": \"%s\",\n  \"results\": [\n", json_string(label).c_str(), sim);
+    for (size_t i = 0; i < g_results.size(); ++i) {
+        const Result& r = g_results[i];
+        const double calls = (double)r.m.calls;
+        char perFrame[32] = "null";
+        if (r.perFrame >= 0) snprintf(perFrame, sizeof perFrame, "%.4f", r.perFrame);
+        fprintf(f, "    {\"name\": %s, \"scenario\": %s, \"ns_per_call\": %.2f, \"calls\": %llu, "
+                   "\"calls_per_frame\": %s, \"allocs_per_call\": %.4f, \"bytes_per_call\": %.2f}%s\n",
+                json_string(r.name.c_str()).c_str(), json_string(r.scenario.c_str()).c_str(), (double)r.m.ns / calls,
+                (unsigned long long)r.m.calls, perFrame, r.m.allocs / calls, r.m.bytes / calls,
+                i + 1 < g_results.size() ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+    return fclose(f) == 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const char* jsonPath = nullptr;
+    const char* label = "";
+    std::string romfs = "romfs";
+    const char* sdmc = "build-host/bench_sdmc";
+    Config cfg;
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--json") && i + 1 < argc) jsonPath = argv[++i];
+        else if (!strcmp(argv[i], "--label") && i + 1 < argc) label = argv[++i];
+        else if (!strcmp(argv[i], "--quick")) { cfg.reps = 3; cfg.playTicks = 120; cfg.fontCalls = 2000; }
+        else if (!strcmp(argv[i], "--romfs") && i + 1 < argc) romfs = argv[++i];
+        else if (!strcmp(argv[i], "--sdmc") && i + 1 < argc) sdmc = argv[++i];
+        else {
+            fprintf(stderr, "usage: %s [--json FILE] [--label TEXT] [--quick] [--romfs DIR] [--sdmc DIR]\n", argv[0]);
+            return 2;
+        }
+    }
+    hw_host_set_dirs(sdmc, romfs.c_str());
+    if (!hw_init()) { fprintf(stderr, "hw_init failed (no IMAGE sheet table)\n"); return 1; }
+    options::load_settings();
+    sound::init();
+    game_init(); // also creates sdmc:/ballistica/levels
+
+    int failures = 0;
+    if (!check_murder_and_bottom_loss()) ++failures;
+    double textsPerFrame = 0.0;
+    for (const char* pack : kPacks) {
+        std::string bytes;
+        if (!read_file(romfs + "/" + pack, bytes)) { fprintf(stderr, "bench: missing %s/%s\n", romfs.c_str(), pack); ++failures; continue; }
+        std::string scenario(pack, strlen(pack) - 4); // drop .DAT
+        if (!run_pack(pack, bytes, scenario, cfg, !strcmp(pack, "LEVELS.DAT") ? &textsPerFrame : nullptr)) ++failures;
+    }
+    {
+        const std::string bytes = synthetic_pack();
+        const std::string path = std::string("sdmc:/ballistica/levels/") + kSyntheticPack;
+        FILE* f = fopen(path.c_str(), "wb");
+        if (!f || fwrite(bytes.data(), 1, bytes.size(), f) != bytes.size()) { fprintf(stderr, "bench: cannot write %s\n", path.c_str()); ++failures; }
+        if (f) fclose(f);
+        if (!run_pack(kSyntheticPack, bytes, "synthetic", cfg)) ++failures;
+    }
+    bench_font(cfg, textsPerFrame);
+    levels_set_active_file("LEVELS.DAT"); // leave the bench sdmc pointing at the default pack
+
+    print_table();
+    if (jsonPath) {
+        if (!write_json(jsonPath, label)) { fprintf(stderr, "bench: cannot write %s\n", jsonPath); ++failures; }
+        else printf("wrote %s\n", jsonPath);
+    }
+    sound::shutdown();
+    hw_shutdown();
+    return failures ? 1 : 0;
+}
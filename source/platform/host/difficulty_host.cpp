@@ -0,0 +1,293 @@
+// Host difficulty estimator: many randomized bot runs per level, summarised per level.
+//
+// A run is one fresh game (3 lives) on one level, played by autoplay::Bot until the level is
+// cleared, the game is over or --max-frames ticks have passed. Each run draws its own bot seed
+// and policy (launch flick, so launch angle; aim spread on the bat; murder-ball dodge distance;
+// patience before TILT) from --seed, the level and the run number, so the results do not depend
+// on the thread count or on which thread ran what. Runs go through a work-stealing pool
+// (worksteal.hpp), one GameWorld per worker.
+//
+// Per level it reports the failure rate, the clear time distribution of the runs that cleared
+// (p10 / median / p90 seconds), brick hits per second, the most balls in play at once and the
+// mean lives lost, next to the level's SPEED. --speed N plays every level at SPEED N instead,
+// for comparing candidate values.
+//
+// Usage: ballistica_difficulty [--pack NAME.DAT]... [--all] [--runs N] [--max-frames N]
+//                              [--threads N] [--seed N] [--speed N] [--csv FILE] [--json FILE]
+//                              [--sdmc DIR] [--romfs DIR]
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include "hardware.hpp"
+#include "game.hpp"
+#include "levels.hpp"
+#include "sound.hpp"
+#include "options.hpp"
+#include "autoplay.hpp"
+#include "worksteal.hpp"
+
+namespace {
+
+struct Config {
+    int runs = 200;
+    long maxFrames = 18000; // 5 minutes at 60 fps
+    int threads = 1;
+    uint32_t seed = 1;
+    int speed = 0;          // 0: each level's own SPEED
+};
+
+struct RunResult {
+    bool cleared = false;
+    long ticks = 0;
+    uint32_t brickHits = 0;
+    int peakBalls = 0;
+    int livesLost = 0;
+};
+
+struct LevelSummary {
+    std::string pack;
+    int level = 0;
+    std::string name;
+    int speed = 0;
+    int runs = 0;
+    double failRate = 0.0;
+    double clearP10 = -1.0, clearMedian = -1.0, clearP90 = -1.0, clearMean = -1.0; // seconds
+    double hitsPerSecMedian = 0.0, hitsPerSecMean = 0.0;
+    int peakBallsMedian = 0, peakBallsMax = 0;
+    double livesLostMean = 0.0;
+};
+
+uint32_t mix(uint32_t h) {
+    h ^= h >> 16; h *= 0x7feb352dU;
+    h ^= h >> 15; h *= 0x846ca68bU;
+    h ^= h >> 16;
+    return h;
+}
+
+// Bot seed and policy of run `trial` on `level`
+autoplay::Bot make_bot(const Config& cfg, int level, int trial) {
+    uint32_t s = mix(cfg.seed ^ mix((uint32_t)level * 0x9E3779B9u ^ mix((uint32_t)trial + 1u)));
+    auto next = [&s]() { s = mix(s + 0x9E3779B9u); return s; };
+    autoplay::Policy p;
+    p.launchFlick = 1 + (int)(next() % 9);                       // 1..9 px
+    p.aimSpread = 0.10f + 0.40f * (float)(next() % 1001) / 1000.f; // 0.10..0.50
+    p.murderDodgeTicks = 30 + (int)(next() % 31);                 // 30..60
+    p.stuckTicks = 600 + (int)(next() % 601);                     // 600..1200
+    return autoplay::Bot(next(), p);
+}
+
+RunResult play_run(GameWorld& world, int level, int trial, const Config& cfg) {
+    RunResult r;
+    autoplay::Bot bot = make_bot(cfg, level, trial);
+    GameObservation obs;
+    game_start_level(world, level);
+    game_observe(world, obs);
+    const uint32_t completed0 = obs.levelsCompleted;
+    int prevLives = obs.lives;
+    for (; r.ticks < cfg.maxFrames; ) {
+        game_update(world, bot.next(obs));
+        ++r.ticks;
+        game_observe(world, obs);
+        if (obs.lives < prevLives) r.livesLost += prevLives - obs.lives;
+        prevLives = obs.lives;
+        if (obs.balls > r.peakBalls) r.peakBalls = obs.balls;
+        if (obs.levelsCompleted != completed0) { r.cleared = true; break; }
+        if (obs.gameOver || !obs.playing) break;
+    }
+    r.brickHits = obs.brickHits;
+    return r;
+}
+
+// Nearest-rank percentile of sorted values (q in 0..1)
+template <typename T>
+T percentile(const std::vector<T>& sorted, double q) {
+    if (sorted.empty()) return T();
+    size_t i = (size_t)(q * (double)(sorted.size() - 1) + 0.5);
+    return sorted[i < sorted.size() ? i : sorted.size() - 1];
+}
+
+LevelSummary summarise(const std::string& pack, int level, const RunResult* runs, int count) {
+    LevelSummary s;
+    s.pack = pack;
+    s.level = level;
+    s.name = levels_get_name(level);
+    s.speed = levels_get_speed(level);
+    s.runs = count;
+    std::vector<double> clear, hitsPerSec;
+    std::vector<int> balls;
+    int failed = 0;
+    long lives = 0;
+    for (int i = 0; i < count; ++i) {
+        const RunResult& r = runs[i];
+        if (r.cleared) clear.push_back((double)r.ticks / 60.0);
+        else ++failed;
+        hitsPerSec.push_back(r.ticks ? r.brickHits * 60.0 / (double)r.ticks : 0.0);
+        balls.push_back(r.peakBalls);
+        lives += r.livesLost;
+    }
+    std::sort(clear.begin(), clear.end());
+    std::sort(hitsPerSec.begin(), hitsPerSec.end());
+    std::sort(balls.begin(), balls.end());
+    s.failRate = count ? (double)failed / count : 0.0;
+    if (!clear.empty()) {
+        s.clearP10 = percentile(clear, 0.10);
+        s.clearMedian = percentile(clear, 0.50);
+        s.clearP90 = percentile(clear, 0.90);
+        double sum = 0.0;
+        for (double c : clear) sum += c;
+        s.clearMean = sum / clear.size();
+    }
+    double hsum = 0.0;
+    for (double h : hitsPerSec) hsum += h;
+    s.hitsPerSecMean = count ? hsum / count : 0.0;
+    s.hitsPerSecMedian = percentile(hitsPerSec, 0.50);
+    s.peakBallsMedian = percentile(balls, 0.50);
+    s.peakBallsMax = balls.empty() ? 0 : balls.back();
+    s.livesLostMean = count ? (double)lives / count : 0.0;
+    return s;
+}
+
+// Level names come from the pack; keep them to characters that need no quoting
+std::string plain(const std::string& s) {
+    std::string out;
+    for (char c : s) out += (c == '"' || c == '\\' || c == ',' || (unsigned char)c < 0x20) ? ' ' : c;
+    return out;
+}
+
+bool write_csv(const char* path, const std::vector<LevelSummary>& rows) {
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+    fprintf(f, "pack,level,name,speed,runs,fail_rate,clear_p10_s,clear_median_s,clear_p90_s,clear_mean_s,"
+               "hits_per_s_median,hits_per_s_mean,peak_balls_median,peak_balls_max,lives_lost_mean\n");
+    for (const LevelSummary& s : rows)
+        fprintf(f, "%s,%d,%s,%d,%d,%.4f,%.2f,%.2f,%.2f,%.2f,%.3f,%.3f,%d,%d,%.3f\n", plain(s.pack).c_str(), s.level + 1,
+                plain(s.name).c_str(), s.speed, s.runs, s.failRate, s.clearP10, s.clearMedian, s.clearP90, s.clearMean,
+                s.hitsPerSecMedian, s.hitsPerSecMean, s.peakBallsMedian, s.peakBallsMax, s.livesLostMean);
+    return fclose(f) == 0;
+}
+
+bool write_json(const char* path, const Config& cfg, const std::vector<LevelSummary>& rows) {
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+#ifdef BALLISTICA_FIXED_SIM
+    const char* sim = "fixed";
+#else
+    const char* sim = "float";
+#endif
+    fprintf(f, "{\n  \"seed\": %u,\n  \"runs\": %d,\n  \"max_frames\": %ld,\n  \"speed_override\": %d,\n  \"sim\": \"%s\",\n"
+               "  \"levels\": [\n", cfg.seed, cfg.runs, cfg.maxFrames, cfg.speed, sim);
+    for (size_t i = 0; i < rows.size(); ++i) {
+        const LevelSummary& s = rows[i];
+        fprintf(f, "    {\"pack\": \"%s\", \"level\": %d, \"name\": \"%s\", \"speed\": %d, \"runs\": %d, \"fail_rate\": %.4f, "
+                   "\"clear_p10_s\": %.2f, \"clear_median_s\": %.2f, \"clear_p90_s\": %.2f, \"clear_mean_s\": %.2f, "
+                   "\"hits_per_s_median\": %.3f, \"hits_per_s_mean\": %.3f, \"peak_balls_median\": %d, "
+                   "\"peak_balls_max\": %d, \"lives_lost_mean\": %.3f}%s\n",
+                plain(s.pack).c_str(), s.level + 1, plain(s.name).c_str(), s.speed, s.runs, s.failRate, s.clearP10,
+                s.clearMedian, s.clearP90, s.clearMean, s.hitsPerSecMedian, s.hitsPerSecMean, s.peakBallsMedian,
+                s.peakBallsMax, s.livesLostMean, i + 1 < rows.size() ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+    return fclose(f) == 0;
+}
+
+// Every level of the active pack, cfg.runs times each; appends one summary per level
+bool run_pack(const Config& cfg, std::vector<LevelSummary>& out) {
+    const std::string pack = levels_get_active_file() ? levels_get_active_file() : "?";
+    const int levels = levels_count();
+    if (levels <= 0) return false;
+    if (cfg.speed > 0)
+        for (int L = 0; L < levels; ++L) levels_set_speed(L, cfg.speed);
+
+    worksteal::Pool pool(cfg.threads);
+    std::vector<GameWorld*> worlds;
+    for (int w = 0; w < pool.threads(); ++w) worlds.push_back(game_world_create());
+    const int jobs = levels * cfg.runs;
+    std::vector<RunResult> results(jobs);
+    auto t0 = std::chrono::steady_clock::now();
+    // Level-major job order: the ranges dealt out first are whole levels, so a worker holding
+    // a slow level is the one others steal from
+    pool.run(jobs, [&](int worker, int job) {
+        results[job] = play_run(*worlds[worker], job / cfg.runs, job % cfg.runs, cfg);
+    });
+    const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    for (GameWorld* w : worlds) game_world_destroy(w);
+
+    printf("%s\n%-5s %-20s %5s %6s %7s %8s %8s %8s %8s %6s %6s\n", pack.c_str(), "level", "name", "speed", "runs",
+           "fail%", "p10 s", "median s", "p90 s", "hits/s", "balls", "lives");
+    for (int L = 0; L < levels; ++L) {
+        LevelSummary s = summarise(pack, L, &results[(size_t)L * cfg.runs], cfg.runs);
+        printf("%-5d %-20.20s %5d %6d %7.1f %8.1f %8.1f %8.1f %8.2f %3d/%-2d %6.2f\n", s.level + 1, s.name.c_str(),
+               s.speed, s.runs, s.failRate * 100.0, s.clearP10, s.clearMedian, s.clearP90, s.hitsPerSecMedian,
+               s.peakBallsMedian, s.peakBallsMax, s.livesLostMean);
+        out.push_back(s);
+    }
+    long steals = 0;
+    double busy = 0.0;
+    for (int w = 0; w < pool.threads(); ++w) { steals += pool.stats(w).steals; busy += pool.stats(w).busySeconds; }
+    printf("%s: %d runs in %.1f s (%.1f runs/s) on %d threads, %ld steals, %.0f%% busy\n\n", pack.c_str(), jobs, wall,
+           wall > 0.0 ? jobs / wall : 0.0, pool.threads(), steals,
+           wall > 0.0 ? 100.0 * busy / (wall * pool.threads()) : 0.0);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<std::string> packs;
+    bool all = false;
+    const char* csvPath = nullptr;
+    const char* jsonPath = nullptr;
+    const char* sdmc = "build-host/autoplay_sdmc";
+    const char* romfs = nullptr;
+    Config cfg;
+    cfg.threads = (int)std::thread::hardware_concurrency();
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--pack") && i + 1 < argc) packs.push_back(argv[++i]);
+        else if (!strcmp(argv[i], "--all")) all = true;
+        else if (!strcmp(argv[i], "--runs") && i + 1 < argc) cfg.runs = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--max-frames") && i + 1 < argc) cfg.maxFrames = atol(argv[++i]);
+        else if (!strcmp(argv[i], "--threads") && i + 1 < argc) cfg.threads = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc) cfg.seed = (uint32_t)strtoul(argv[++i], nullptr, 0);
+        else if (!strcmp(argv[i], "--speed") && i + 1 < argc) cfg.speed = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--csv") && i + 1 < argc) csvPath = argv[++i];
+        else if (!strcmp(argv[i], "--json") && i + 1 < argc) jsonPath = argv[++i];
+        else if (!strcmp(argv[i], "--sdmc") && i + 1 < argc) sdmc = argv[++i];
+        else if (!strcmp(argv[i], "--romfs") && i + 1 < argc) romfs = argv[++i];
+        else {
+            fprintf(stderr, "usage: %s [--pack NAME.DAT]... [--all] [--runs N] [--max-frames N] [--threads N] [--seed N]"
+                            " [--speed N] [--csv FILE] [--json FILE] [--sdmc DIR] [--romfs DIR]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (cfg.runs < 1) cfg.runs = 1;
+    if (cfg.threads < 1) cfg.threads = 1;
+    hw_host_set_dirs(sdmc, romfs);
+    if (!hw_init()) { fprintf(stderr, "hw_init failed (no IMAGE sheet table)\n"); return 1; }
+    options::load_settings();
+    sound::init();
+    game_init();
+    if (all) packs = levels_available_files();
+    if (packs.empty()) packs.push_back(levels_get_active_file() ? levels_get_active_file() : "LEVELS.DAT");
+
+    std::vector<LevelSummary> rows;
+    int rc = 0;
+    for (const std::string& pack : packs) {
+        levels_set_active_file(pack.c_str());
+        levels_reload_active();
+        const char* active = levels_get_active_file();
+        if (!active || pack != active || !run_pack(cfg, rows)) {
+            fprintf(stderr, "cannot load level pack %s\n", pack.c_str());
+            rc = 1;
+        }
+    }
+    if (csvPath && !write_csv(csvPath, rows)) { fprintf(stderr, "cannot write %s\n", csvPath); rc = 1; }
+    if (jsonPath && !write_json(jsonPath, cfg, rows)) { fprintf(stderr, "cannot write %s\n", jsonPath); rc = 1; }
+    sound::shutdown();
+    hw_shutdown();
+    return rc;
+}
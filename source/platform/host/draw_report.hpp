@@ -0,0 +1,127 @@
+// draw_report.hpp - per-frame draw-count report and object budget check for host runs
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "hardware.hpp"
+
+// Listens to the host backend's draw sinks while attached. Optionally writes every draw
+// (--draw-log) and every frame's per-screen totals (--draw-report) as CSV, and keeps the
+// busiest frame per screen with a breakdown by HwDrawScope for the summary. A budget of 0
+// means no limit; the frame budget defaults to what hw_init() gives citro2d on the console.
+namespace draw_report {
+
+struct Budget {
+    uint32_t screen[2] = { 0, 0 }; // objects on the top / bottom screen
+    uint32_t frame = kHwMaxObjects; // objects on both screens together
+};
+
+class Report {
+public:
+    ~Report() { detach(); if (log_) fclose(log_); if (csv_) fclose(csv_); }
+
+    bool open_log(const char* path) {
+        log_ = fopen(path, "w");
+        if (log_) fputs("frame,screen,scope,kind,sheet,image,x,y,w,h\n", log_);
+        return log_ != nullptr;
+    }
+    bool open_report(const char* path) {
+        csv_ = fopen(path, "w");
+        if (csv_) fputs("frame,top_objects,top_rects,top_sprites,top_glyphs,top_texts,"
+                        "bottom_objects,bottom_rects,bottom_sprites,bottom_glyphs,bottom_texts,objects\n", csv_);
+        return csv_ != nullptr;
+    }
+    void set_budget(const Budget& b) { budget_ = b; }
+
+    void attach() { hw_host_set_draw_sinks(&Report::on_draw, &Report::on_frame, this); }
+    void detach() { hw_host_set_draw_sinks(nullptr, nullptr, nullptr); }
+
+    // Totals, peaks and (if any) the first frame over budget; false when a budget was exceeded
+    bool summarize(FILE* out) const {
+        if (!frames_) return true;
+        for (int s = 0; s < 2; ++s) {
+            const Peak& p = peak_[s];
+            fprintf(out, "  %s screen: %.1f objects per frame, peak %u at frame %llu",
+                    s ? "bottom" : "top", (double)sum_[s] / frames_, p.objects, (unsigned long long)p.frame);
+            if (budget_.screen[s]) fprintf(out, " (budget %u)", budget_.screen[s]);
+            fputc('\n', out);
+            for (const ScopeCount& c : p.scopes) fprintf(out, "    %-12s %u\n", c.scope, c.objects);
+        }
+        fprintf(out, "  both screens: peak %u objects (budget %u)\n", peakFrame_, budget_.frame);
+        if (!overFrames_) return true;
+        fprintf(out, "  %llu frame(s) over budget, first at frame %llu: top %u, bottom %u, both %u\n",
+                (unsigned long long)overFrames_, (unsigned long long)firstOver_.frame,
+                firstOver_.objects(0), firstOver_.objects(1), firstOver_.objects());
+        for (int s = 0; s < 2; ++s)
+            for (const ScopeCount& c : firstOverScopes_[s]) fprintf(out, "    %-6s %-12s %u\n", s ? "bottom" : "top", c.scope, c.objects);
+        return false;
+    }
+
+private:
+    struct ScopeCount { const char* scope; uint32_t objects; };
+    struct Peak { uint32_t objects = 0; uint64_t frame = 0; std::vector<ScopeCount> scopes; };
+
+    static std::vector<ScopeCount> sorted(const std::vector<ScopeCount>& v) {
+        std::vector<ScopeCount> out = v;
+        std::sort(out.begin(), out.end(), [](const ScopeCount& a, const ScopeCount& b) { return a.objects > b.objects; });
+        return out;
+    }
+
+    static void on_draw(const HwDrawCall& c, void* user) {
+        Report& r = *static_cast<Report*>(user);
+        std::vector<ScopeCount>& v = r.scopes_[c.screen];
+        auto it = v.begin();
+        while (it != v.end() && strcmp(it->scope, c.scope) != 0) ++it;
+        if (it == v.end()) v.push_back(ScopeCount{ c.scope, 1 });
+        else ++it->objects;
+        if (!r.log_) return;
+        static const char* const kKinds[] = { "rect", "sprite", "glyph" };
+        fprintf(r.log_, "%llu,%s,%s,%s,%s,%d,%g,%g,%g,%g\n", (unsigned long long)hw_host_stats().frames,
+                c.screen ? "bottom" : "top", c.scope, kKinds[(int)c.kind], c.sheet ? c.sheet : "",
+                c.image, c.x, c.y, c.w, c.h);
+    }
+
+    static void on_frame(const HwFrameDraws& f, void* user) {
+        Report& r = *static_cast<Report*>(user);
+        if (r.csv_) {
+            fprintf(r.csv_, "%llu", (unsigned long long)f.frame);
+            for (int s = 0; s < 2; ++s)
+                fprintf(r.csv_, ",%u,%u,%u,%u,%u", f.objects(s), f.rects[s], f.sprites[s], f.glyphs[s], f.texts[s]);
+            fprintf(r.csv_, ",%u\n", f.objects());
+        }
+        bool over = r.budget_.frame && f.objects() > r.budget_.frame;
+        for (int s = 0; s < 2; ++s)
+            if (r.budget_.screen[s] && f.objects(s) > r.budget_.screen[s]) over = true;
+        if (over && r.overFrames_++ == 0) {
+            r.firstOver_ = f;
+            for (int s = 0; s < 2; ++s) r.firstOverScopes_[s] = sorted(r.scopes_[s]);
+        }
+        for (int s = 0; s < 2; ++s) {
+            const uint32_t n = f.objects(s);
+            r.sum_[s] += n;
+            if (n > r.peak_[s].objects || r.frames_ == 0) {
+                r.peak_[s].objects = n;
+                r.peak_[s].frame = f.frame;
+                r.peak_[s].scopes = sorted(r.scopes_[s]);
+            }
+            r.scopes_[s].clear();
+        }
+        if (f.objects() > r.peakFrame_) r.peakFrame_ = f.objects();
+        ++r.frames_;
+    }
+
+    FILE* log_ = nullptr;
+    FILE* csv_ = nullptr;
+    Budget budget_;
+    uint64_t frames_ = 0, overFrames_ = 0;
+    uint64_t sum_[2] = { 0, 0 };
+    uint32_t peakFrame_ = 0;
+    Peak peak_[2];
+    HwFrameDraws firstOver_;
+    std::vector<ScopeCount> firstOverScopes_[2];
+    std::vector<ScopeCount> scopes_[2]; // current frame, per screen
+};
+
+} // namespace draw_report
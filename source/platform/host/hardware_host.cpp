@@ -0,0 +1,277 @@
+// Headless host platform (PLATFORM=host): hardware.hpp plus the libctru / citro2d stand-ins
+// declared in source/platform/host/include, so the shared game code runs on Linux with no
+// window. Input comes from hw_host_set_input(), draws are only counted and optionally recorded
+// (text is laid out into rectangles by font5x6.hpp as on the console, so its cost is real)
+// with hw_host_set_draw_sinks(), audio goes to the software NDSP in ndsp_host.cpp (disabled
+// unless enabled) and sdmc:/ / romfs:/ paths are mapped onto local directories by wrapping
+// fopen/opendir/mkdir/stat at link time (-Wl,--wrap, see Makefile.host).
+
+#include "hardware.hpp"
+#ifdef PLATFORM_HOST
+#include <3ds.h>
+#include <citro2d.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include "font5x6.hpp"
+#include "host_sheets.h" // generated by scripts/gen_host_headers.py
+
+namespace {
+    InputState g_input;
+    HwHostStats g_stats;
+    bool g_logToStderr = false;
+    int g_targetWidth = 400; // top 400, bottom 320 (text clipping as on the console)
+    int g_screen = 0;        // 0 top, 1 bottom
+    std::string g_sdmcDir = "host_sdmc";
+    std::string g_romfsDir = "romfs";
+    std::string g_audioDir;  // romfs:/audio override, empty for none
+    const std::chrono::steady_clock::time_point g_start = std::chrono::steady_clock::now();
+
+    // One subtexture per image of every generated sheet; images share a dummy texture so
+    // "tex != nullptr" checks in the shared code see a loaded sheet
+    C3D_Tex g_tex = { 1024, 1024 };
+    struct Sheet { const HostSheet* desc = nullptr; Tex3DS_SubTexture* subtex = nullptr; };
+    Sheet g_sheets[(int)HwSheet::MenuBottom + 1];
+
+    const char* sheet_name(HwSheet s) {
+        switch (s) {
+            case HwSheet::Image: return "IMAGE";
+            case HwSheet::Break: return "BREAK";
+            case HwSheet::Title: return "TITLE";
+            case HwSheet::High: return "HIGH";
+            case HwSheet::Instruct: return "INSTRUCT";
+            case HwSheet::Designer: return "DESIGNER";
+            case HwSheet::Touch: return "TOUCH";
+            case HwSheet::Options: return "OPTIONS";
+            case HwSheet::Background: return "BACKGROUND";
+            case HwSheet::MenuBottom: return "MENUBOTTOM";
+        }
+        return "";
+    }
+
+    void load_sheet(HwSheet s) {
+        Sheet& sh = g_sheets[(int)s];
+        for (const HostSheet& d : kHostSheets) {
+            if (strcmp(d.name, sheet_name(s)) != 0) continue;
+            sh.desc = &d;
+            sh.subtex = new Tex3DS_SubTexture[d.count];
+            for (int i = 0; i < d.count; ++i) {
+                Tex3DS_SubTexture& t = sh.subtex[i];
+                t.width = d.images[i].w; t.height = d.images[i].h;
+                t.left = 0.0f; t.top = 1.0f; t.right = 1.0f; t.bottom = 0.0f;
+            }
+            return;
+        }
+    }
+
+    // Draw recording (hardware.hpp); draws outside any HwDrawScope belong to "frame"
+    const char* g_scope = "frame";
+    HwFrameDraws g_frame;
+    HwDrawSink g_onDraw = nullptr;
+    HwFrameSink g_onFrame = nullptr;
+    void* g_sinkUser = nullptr;
+
+    void record(HwDrawKind kind, float x, float y, float w, float h, const char* sheet = nullptr, int image = -1) {
+        switch (kind) {
+            case HwDrawKind::Rect: ++g_frame.rects[g_screen]; break;
+            case HwDrawKind::Sprite: ++g_frame.sprites[g_screen]; break;
+            case HwDrawKind::Glyph: ++g_frame.glyphs[g_screen]; break;
+        }
+        if (!g_onDraw) return;
+        HwDrawCall c = { kind, g_screen, g_scope, sheet, image, x, y, w, h };
+        g_onDraw(c, g_sinkUser);
+    }
+
+    // Sheet and image index of a subtexture handed out by hw_image_from()
+    const char* image_source(const Tex3DS_SubTexture* t, int& index) {
+        index = -1;
+        for (const Sheet& sh : g_sheets) {
+            if (!sh.desc || !t || t < sh.subtex || t >= sh.subtex + sh.desc->count) continue;
+            index = (int)(t - sh.subtex);
+            return sh.desc->name;
+        }
+        return nullptr;
+    }
+
+    // sdmc:/x -> <sdmcDir>/x, romfs:/x -> <romfsDir>/x (romfs:/audio/x -> <audioDir>/x if set),
+    // anything else unchanged
+    const char* map_path(const char* path, std::string& buf) {
+        if (!path) return path;
+        const char* rest = nullptr;
+        const std::string* root = nullptr;
+        if (!g_audioDir.empty() && strncmp(path, "romfs:/audio/", 13) == 0) { rest = path + 13; root = &g_audioDir; }
+        else if (strncmp(path, "sdmc:/", 6) == 0) { rest = path + 6; root = &g_sdmcDir; }
+        else if (strncmp(path, "romfs:/", 7) == 0) { rest = path + 7; root = &g_romfsDir; }
+        if (!root) return path;
+        buf = *root;
+        if (*rest) { buf += '/'; buf += rest; }
+        return buf.c_str();
+    }
+}
+
+// ---- sdmc:/ and romfs:/ mapping (linked with -Wl,--wrap=fopen,--wrap=opendir,...) ----------
+extern "C" {
+FILE* __real_fopen(const char* path, const char* mode);
+DIR* __real_opendir(const char* path);
+int __real_mkdir(const char* path, mode_t mode);
+int __real_stat(const char* path, struct stat* st);
+
+FILE* __wrap_fopen(const char* path, const char* mode) { std::string b; return __real_fopen(map_path(path, b), mode); }
+DIR* __wrap_opendir(const char* path) { std::string b; return __real_opendir(map_path(path, b)); }
+int __wrap_mkdir(const char* path, mode_t mode) { std::string b; return __real_mkdir(map_path(path, b), mode); }
+int __wrap_stat(const char* path, struct stat* st) { std::string b; return __real_stat(map_path(path, b), st); }
+}
+
+// ---- libctru stand-ins ---------------------------------------------------------------------
+u64 osGetTime(void) {
+    if (hw_host_audio_enabled()) return (u64)hw_host_audio_ms();
+    return (u64)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - g_start).count();
+}
+Result svcOutputDebugString(const char* str, s32 length) {
+    if (g_logToStderr && str) fwrite(str, 1, (size_t)length, stderr);
+    return 0;
+}
+void* linearAlloc(size_t size) { return malloc(size); }
+void linearFree(void* mem) { free(mem); }
+Result DSP_FlushDataCache(const void*, u32) { return 0; }
+
+void swkbdInit(SwkbdState* swkbd, SwkbdType type, int numButtons, int maxTextLength) {
+    swkbd->type = type; swkbd->numButtons = numButtons; swkbd->maxTextLength = maxTextLength;
+}
+void swkbdSetHintText(SwkbdState*, const char*) {}
+void swkbdSetInitialText(SwkbdState*, const char*) {}
+void swkbdSetValidation(SwkbdState*, SwkbdValidInput, u32, int) {}
+SwkbdButton swkbdInputText(SwkbdState*, char* buf, size_t bufsize) {
+    if (buf && bufsize) buf[0] = '\0';
+    return SWKBD_BUTTON_LEFT;
+}
+
+// ---- citro2d stand-ins ---------------------------------------------------------------------
+bool C2D_DrawRectSolid(float x, float y, float, float w, float h, u32) {
+    ++g_stats.rects;
+    record(HwDrawKind::Rect, x, y, w, h);
+    return true;
+}
+bool C2D_DrawImageAt(C2D_Image img, float x, float y, float, const C2D_ImageTint*, float sx, float sy) {
+    ++g_stats.sprites;
+    int index;
+    const char* sheet = image_source(img.subtex, index);
+    const float w = img.subtex ? img.subtex->width * sx : 0.0f, h = img.subtex ? img.subtex->height * sy : 0.0f;
+    record(HwDrawKind::Sprite, x, y, w, h, sheet, index);
+    return true;
+}
+
+// ---- hardware.hpp --------------------------------------------------------------------------
+bool hw_init() {
+    for (int s = 0; s <= (int)HwSheet::MenuBottom; ++s) load_sheet((HwSheet)s);
+    __real_mkdir(g_sdmcDir.c_str(), 0777);
+    return g_sheets[(int)HwSheet::Image].desc != nullptr;
+}
+
+void hw_shutdown() {
+    for (Sheet& sh : g_sheets) { delete[] sh.subtex; sh.subtex = nullptr; sh.desc = nullptr; }
+}
+
+void hw_poll_input(InputState& out) { out = g_input; }
+
+void hw_begin_frame() {
+    g_frame = HwFrameDraws();
+    g_frame.frame = g_stats.frames;
+}
+void hw_end_frame() {
+    if (g_onFrame) g_onFrame(g_frame, g_sinkUser);
+    ++g_stats.frames;
+}
+
+uint64_t hw_ticks() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - g_start).count();
+}
+uint64_t hw_ticks_per_second() { return 1000000000ull; }
+
+void hw_draw_sprite(C2D_Image img, float x, float y, float z, float sx, float sy) {
+    C2D_DrawImageAt(img, x, y, z, nullptr, sx, sy);
+}
+
+C2D_Image hw_image(int index) { return hw_image_from(HwSheet::Image, index); }
+
+bool hw_sheet_loaded(HwSheet sheet) { return g_sheets[(int)sheet].desc != nullptr; }
+
+C2D_Image hw_image_from(HwSheet sheet, int index) {
+    const Sheet& sh = g_sheets[(int)sheet];
+    if (!sh.desc || index < 0 || index >= sh.desc->count) return C2D_Image{};
+    C2D_Image img;
+    img.tex = &g_tex;
+    img.subtex = &sh.subtex[index];
+    return img;
+}
+
+namespace {
+    void draw_rect(float x, float y, float w, float h) {
+        ++g_stats.rects;
+        record(HwDrawKind::Glyph, x, y, w, h);
+    }
+}
+
+void hw_draw_text(int x, int y, const char* text, uint32_t) {
+    if (!text) return;
+    ++g_stats.texts;
+    ++g_frame.texts[g_screen];
+    font5x6::layout(x, y, text, g_targetWidth, draw_rect);
+}
+void hw_draw_text_scaled(int x, int y, const char* text, uint32_t rgba, float scale) {
+    if (!text) return;
+    if (scale <= 1.01f) { hw_draw_text(x, y, text, rgba); return; }
+    ++g_stats.texts;
+    ++g_frame.texts[g_screen];
+    font5x6::layout_scaled(x, y, text, scale, draw_rect);
+}
+void hw_draw_text_shadow_scaled(int x, int y, const char* text, uint32_t mainRGBA, uint32_t shadowRGBA, float scale) {
+    if (!text) return;
+    if (scale <= 1.01f) {
+        if ((shadowRGBA & 0xFF) != 0) hw_draw_text(x + 1, y + 1, text, shadowRGBA);
+        hw_draw_text(x, y, text, mainRGBA);
+        return;
+    }
+    ++g_stats.texts;
+    ++g_frame.texts[g_screen];
+    if ((shadowRGBA & 0xFF) != 0) font5x6::layout_scaled_runs(x + 1, y + 1, text, scale, draw_rect);
+    if ((mainRGBA & 0xFF) != 0) font5x6::layout_scaled_runs(x, y, text, scale, draw_rect);
+}
+
+int hw_text_width(const char* text) {
+    if(!text) return 0;
+    int len=0; for(const char* p=text; *p && *p!='\n'; ++p) ++len; return len*6; // fixed advance of 6 per glyph
+}
+
+void hw_draw_logs(int, int, int) {}
+void hw_set_top() { g_targetWidth = 400; g_screen = 0; }
+void hw_set_bottom() { g_targetWidth = 320; g_screen = 1; }
+
+void hw_log(const char* msg) {
+    if (g_logToStderr && msg) fputs(msg, stderr);
+}
+
+// ---- host controls -------------------------------------------------------------------------
+void hw_host_set_input(const InputState& in) { g_input = in; }
+void hw_host_set_dirs(const char* sdmcDir, const char* romfsDir, const char* audioDir) {
+    if (sdmcDir && *sdmcDir) g_sdmcDir = sdmcDir;
+    if (romfsDir && *romfsDir) g_romfsDir = romfsDir;
+    if (audioDir && *audioDir) g_audioDir = audioDir;
+}
+void hw_host_set_log(bool toStderr) { g_logToStderr = toStderr; }
+const HwHostStats& hw_host_stats() { return g_stats; }
+void hw_host_set_draw_sinks(HwDrawSink onDraw, HwFrameSink onFrame, void* user) {
+    g_onDraw = onDraw; g_onFrame = onFrame; g_sinkUser = user;
+}
+const char* hw_host_draw_scope(const char* name) {
+    const char* prev = g_scope;
+    g_scope = name;
+    return prev;
+}
+
+#endif // PLATFORM_HOST
@@ -0,0 +1,29 @@
+// host_script.hpp - scripted player input shared by the host runner and benchmarks
+#pragma once
+#include "hardware.hpp"
+#include "game.hpp"
+
+namespace host_script {
+
+// Input for frame f given the mode the game is in
+inline InputState input(long f, GameMode mode, bool wasTouching) {
+    InputState in;
+    if (mode == GameMode::Title) {
+        in.startPressed = (f % 30) == 0;
+    } else if (mode == GameMode::Playing) {
+        // A 40-frame drag across the bottom screen, alternating direction, moves the bat so
+        // the ball meets it off-centre; the release launches a locked ball.
+        // START/A every second also dismisses the game-over screen.
+        const long phase = f % 150;
+        const bool right = ((f / 150) & 1) == 0;
+        in.touching = phase < 40;
+        in.touchPressed = in.touching && !wasTouching;
+        if (in.touching) { in.stylusX = (int)(right ? 100 + phase * 3 : 220 - phase * 3); in.stylusY = 200; }
+        in.aPressed = (f % 60) == 30;
+    } else {
+        in.bPressed = (f % 30) == 0; // leave the editor / options if ever entered
+    }
+    return in;
+}
+
+} // namespace host_script
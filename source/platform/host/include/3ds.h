@@ -0,0 +1,44 @@
+// 3ds.h - host stand-in for the parts of libctru the shared game code uses
+//
+// Only what game.cpp, levels.cpp, editor.cpp, options.cpp, sound.cpp and highscores.cpp
+// touch is declared here; source/platform/host/hardware_host.cpp implements it headless.
+// Layouts and constants follow libctru so the shared code compiles unchanged.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+typedef int8_t s8;
+typedef int16_t s16;
+typedef int32_t s32;
+typedef int64_t s64;
+typedef s32 Result;
+
+#define SYSCLOCK_ARM11 268111856
+
+// Milliseconds since start-up (sound.cpp debounce); the DSP clock while host audio is on
+u64 osGetTime(void);
+Result svcOutputDebugString(const char* str, s32 length);
+
+// Linear (DSP-visible) heap: plain malloc on the host
+void* linearAlloc(size_t size);
+void linearFree(void* mem);
+Result DSP_FlushDataCache(const void* addr, u32 size);
+
+// Software keyboard: never shown on the host; input returns SWKBD_BUTTON_LEFT (cancel)
+typedef enum { SWKBD_TYPE_NORMAL = 0, SWKBD_TYPE_QWERTY, SWKBD_TYPE_NUMPAD, SWKBD_TYPE_WESTERN } SwkbdType;
+typedef enum { SWKBD_BUTTON_NONE = -1, SWKBD_BUTTON_LEFT = 0, SWKBD_BUTTON_MIDDLE, SWKBD_BUTTON_RIGHT,
+               SWKBD_BUTTON_CONFIRM = SWKBD_BUTTON_RIGHT } SwkbdButton;
+typedef enum { SWKBD_ANYTHING = 0, SWKBD_NOTEMPTY, SWKBD_NOTEMPTY_NOTBLANK, SWKBD_NOTBLANK_NOTEMPTY = SWKBD_NOTEMPTY_NOTBLANK,
+               SWKBD_NOTBLANK, SWKBD_FIXEDLEN } SwkbdValidInput;
+typedef struct { int type, numButtons, maxTextLength; } SwkbdState;
+void swkbdInit(SwkbdState* swkbd, SwkbdType type, int numButtons, int maxTextLength);
+void swkbdSetHintText(SwkbdState* swkbd, const char* text);
+void swkbdSetInitialText(SwkbdState* swkbd, const char* text);
+void swkbdSetValidation(SwkbdState* swkbd, SwkbdValidInput validInput, u32 filterFlags, int maxDigits);
+SwkbdButton swkbdInputText(SwkbdState* swkbd, char* buf, size_t bufsize);
+
+#include "3ds/ndsp/ndsp.h"
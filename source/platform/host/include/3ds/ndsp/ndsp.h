@@ -0,0 +1,34 @@
+// ndsp.h - host stand-in for libctru's NDSP audio service
+//
+// Implemented by the software mixer in source/platform/host/ndsp_host.cpp. ndspInit() fails
+// (sound.cpp runs with audio disabled) unless hw_host_audio_enable() was called first.
+#pragma once
+#include "../../3ds.h"
+
+enum { NDSP_WBUF_FREE = 0, NDSP_WBUF_QUEUED, NDSP_WBUF_PLAYING, NDSP_WBUF_DONE };
+typedef enum { NDSP_OUTPUT_MONO = 0, NDSP_OUTPUT_STEREO, NDSP_OUTPUT_SURROUND } ndspOutputMode;
+enum { NDSP_INTERP_POLYPHASE = 0, NDSP_INTERP_LINEAR, NDSP_INTERP_NONE };
+enum { NDSP_FORMAT_MONO_PCM8 = 1, NDSP_FORMAT_MONO_PCM16 = 5, NDSP_FORMAT_STEREO_PCM8 = 2, NDSP_FORMAT_STEREO_PCM16 = 6 };
+
+typedef struct ndspWaveBuf {
+    union { s8* data_pcm8; s16* data_pcm16; u8* data_adpcm; void* data_vaddr; };
+    u32 nsamples;
+    void* adpcm_data;
+    u32 offset;
+    bool looping;
+    u8 status;
+    u16 sequence_id;
+    struct ndspWaveBuf* next;
+} ndspWaveBuf;
+
+Result ndspInit(void);
+void ndspExit(void);
+void ndspSetOutputMode(ndspOutputMode mode);
+void ndspSetMasterVol(float volume);
+void ndspChnReset(int id);
+void ndspChnSetInterp(int id, int type);
+void ndspChnSetRate(int id, float rate);
+void ndspChnSetFormat(int id, u16 format);
+void ndspChnSetMix(int id, float mix[12]);
+void ndspChnWaveBufAdd(int id, ndspWaveBuf* buf);
+void ndspChnWaveBufClear(int id);
@@ -0,0 +1,31 @@
+// citro2d.h - host stand-in for the citro2d types and calls the shared game code uses
+//
+// Images carry real sprite sizes (from the generated sheet tables) so gameplay that reads
+// subtex->width/height behaves as on hardware. Draw calls are counted, not rasterised.
+#pragma once
+#include "3ds.h"
+
+typedef struct Tex3DS_SubTexture {
+    u16 width, height;
+    float left, top, right, bottom;
+} Tex3DS_SubTexture;
+
+typedef struct C3D_Tex { u16 width, height; } C3D_Tex;
+
+typedef struct {
+    C3D_Tex* tex;
+    const Tex3DS_SubTexture* subtex;
+} C2D_Image;
+
+typedef struct C2D_ImageTint C2D_ImageTint;
+
+#define C2D_DEFAULT_MAX_OBJECTS 4096
+
+static inline u32 C2D_Color32(u8 r, u8 g, u8 b, u8 a)
+{
+    return r | (g << (u32)8) | (b << (u32)16) | (a << (u32)24);
+}
+
+bool C2D_DrawRectSolid(float x, float y, float z, float w, float h, u32 clr);
+bool C2D_DrawImageAt(C2D_Image img, float x, float y, float depth,
+                     const C2D_ImageTint* tint = nullptr, float scaleX = 1.0f, float scaleY = 1.0f);
@@ -0,0 +1,202 @@
+// Headless host runner: drives the real game code with scripted input as fast as it runs.
+//
+// One game_update() per frame with no frame pacing, optionally followed by game_render()
+// into the counting citro2d stand-ins. The built-in script starts a game from the title
+// screen, drags the bat to and fro every couple of seconds (launching a locked ball) and
+// confirms the game-over screen, so long runs cycle through play, death and high scores.
+// --record saves the run as a replay; --replay feeds a recording back in place of the script
+// (for as many frames as it holds) and checks the state hash after every tick, exiting 1 at
+// the first tick that diverges.
+// --render draws both screens each frame as the 3DS build does (game_render_frame). The draw
+// options imply it: --draw-log writes every draw as CSV, --draw-report every frame's totals per
+// screen, and --draw-budget TOP,BOTTOM[,FRAME] exits 1 if any frame submits more citro2d
+// objects than that to a screen (or to both together, default kHwMaxObjects; 0 = no limit).
+// --audio turns on the software NDSP: sound effects (and --music NAME, streamed and looped) are
+// mixed 1/60 s per frame from --audio-dir (default sounds/), optionally into --wav FILE, and
+// the run ends with per-channel buffer counts, cut-off sounds, underruns and the time spent in
+// sound::update(). --audio-hitch N,MS lets the DSP run MS extra every N frames, as when a frame
+// is late, to provoke underruns in the music stream.
+//
+// Usage: ballistica_host [--frames N] [--render] [--log] [--sdmc DIR] [--romfs DIR]
+//                        [--seed N] [--record FILE | --replay FILE]
+//                        [--draw-log FILE] [--draw-report FILE] [--draw-budget TOP,BOTTOM[,FRAME]]
+//                        [--audio] [--wav FILE] [--audio-dir DIR] [--music NAME] [--audio-hitch N,MS]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "hardware.hpp"
+#include "game.hpp"
+#include "sound.hpp"
+#include "options.hpp"
+#include "replay_session.hpp"
+#include "host_script.hpp"
+#include "draw_report.hpp"
+#include "simclock.hpp"
+
+// Per-channel NDSP counters for the channels that were used, and the sound::update() cost
+static void print_audio(double updateSecs, double updateMax, long updates) {
+    const HwAudioStats& a = hw_host_audio_stats();
+    printf("  audio: %.1f s mixed, hash %08x, %llu clipped; sound::update %.0f ns mean, %.0f ns max\n",
+           hw_host_audio_ms() / 1000.0, a.hash, (unsigned long long)a.clipped,
+           updates ? updateSecs * 1e9 / updates : 0.0, updateMax * 1e9);
+    printf("    ndsp  queued    done  cut-off  underruns  dry ms\n");
+    for (int i = 0; i < 24; ++i) {
+        const HwAudioChannelStats& c = a.channel[i];
+        if (!c.queued) continue;
+        printf("    %4d %7llu %7llu %8llu %10llu %7.0f\n", i, (unsigned long long)c.queued, (unsigned long long)c.done,
+               (unsigned long long)c.cutOff, (unsigned long long)c.underruns, c.drySamples * 1000.0 / 32728.498);
+    }
+}
+
+int main(int argc, char** argv) {
+    long frames = 36000;
+    bool render = false;
+    const char* sdmc = nullptr;
+    const char* romfs = nullptr;
+    const char* recordPath = nullptr;
+    const char* replayPath = nullptr;
+    uint32_t seed = 0;
+    const char* drawLogPath = nullptr;
+    const char* drawReportPath = nullptr;
+    bool budgetCheck = false;
+    draw_report::Budget budget;
+    bool audio = false;
+    const char* wavPath = nullptr;
+    const char* audioDir = "sounds";
+    const char* music = nullptr;
+    long hitchEvery = 0, hitchMs = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--frames") && i + 1 < argc) frames = atol(argv[++i]);
+        else if (!strcmp(argv[i], "--render")) render = true;
+        else if (!strcmp(argv[i], "--log")) hw_host_set_log(true);
+        else if (!strcmp(argv[i], "--sdmc") && i + 1 < argc) sdmc = argv[++i];
+        else if (!strcmp(argv[i], "--romfs") && i + 1 < argc) romfs = argv[++i];
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc) seed = (uint32_t)strtoul(argv[++i], nullptr, 0);
+        else if (!strcmp(argv[i], "--record") && i + 1 < argc) recordPath = argv[++i];
+        else if (!strcmp(argv[i], "--replay") && i + 1 < argc) replayPath = argv[++i];
+        else if (!strcmp(argv[i], "--draw-log") && i + 1 < argc) drawLogPath = argv[++i];
+        else if (!strcmp(argv[i], "--draw-report") && i + 1 < argc) drawReportPath = argv[++i];
+        else if (!strcmp(argv[i], "--draw-budget") && i + 1 < argc &&
+                 sscanf(argv[++i], "%u,%u,%u", &budget.screen[0], &budget.screen[1], &budget.frame) >= 2) budgetCheck = true;
+        else if (!strcmp(argv[i], "--audio")) audio = true;
+        else if (!strcmp(argv[i], "--wav") && i + 1 < argc) { wavPath = argv[++i]; audio = true; }
+        else if (!strcmp(argv[i], "--audio-dir") && i + 1 < argc) audioDir = argv[++i];
+        else if (!strcmp(argv[i], "--music") && i + 1 < argc) { music = argv[++i]; audio = true; }
+        else if (!strcmp(argv[i], "--audio-hitch") && i + 1 < argc &&
+                 sscanf(argv[++i], "%ld,%ld", &hitchEvery, &hitchMs) == 2) audio = true;
+        else {
+            fprintf(stderr, "usage: %s [--frames N] [--render] [--log] [--sdmc DIR] [--romfs DIR] [--seed N]"
+                            " [--record FILE | --replay FILE] [--draw-log FILE] [--draw-report FILE]"
+                            " [--draw-budget TOP,BOTTOM[,FRAME]] [--audio] [--wav FILE] [--audio-dir DIR]"
+                            " [--music NAME] [--audio-hitch N,MS]\n", argv[0]);
+            return 2;
+        }
+    }
+    replay::Reader player;
+    if (replayPath) {
+        if (!player.load(replayPath)) { fprintf(stderr, "cannot read replay %s\n", replayPath); return 1; }
+        frames = player.header().ticks;
+    }
+    draw_report::Report draws;
+    const bool drawStats = drawLogPath || drawReportPath || budgetCheck;
+    if (drawStats) {
+        render = true;
+        if (drawLogPath && !draws.open_log(drawLogPath)) { fprintf(stderr, "cannot write %s\n", drawLogPath); return 1; }
+        if (drawReportPath && !draws.open_report(drawReportPath)) { fprintf(stderr, "cannot write %s\n", drawReportPath); return 1; }
+        draws.set_budget(budget);
+        draws.attach();
+    }
+    hw_host_set_dirs(sdmc, romfs, audio ? audioDir : nullptr);
+    if (audio && !hw_host_audio_enable(wavPath)) { fprintf(stderr, "cannot write %s\n", wavPath); return 1; }
+    if (!hw_init()) { fprintf(stderr, "hw_init failed (no IMAGE sheet table)\n"); return 1; }
+    options::load_settings();
+    sound::init();
+    if (music && !sound::play_music(music, /*loop=*/true, /*volume=*/0.8f)) { fprintf(stderr, "cannot stream %s\n", music); return 1; }
+    game_init();
+    game_set_seed(seed);
+    const replay::ApplyResult applied = replayPath ? replay::apply_header(player.header()) : replay::ApplyResult::Ok;
+    if (applied == replay::ApplyResult::SimMismatch) {
+        fprintf(stderr, "%s was recorded with FIXED_SIM=%d; rebuild to match\n", replayPath,
+                (player.header().flags & replay::kFlagFixedSim) ? 1 : 0);
+        return 1;
+    }
+    if (applied == replay::ApplyResult::LevelMissing) {
+        fprintf(stderr, "replay needs level pack %s level %d\n", player.header().levelFile, player.header().startLevel + 1);
+        return 1;
+    }
+    replay::Writer recorder;
+    if (recordPath) recorder.begin(replay::capture_header());
+
+    long modeFrames[4] = { 0, 0, 0, 0 };
+    double updateSecs = 0.0, updateMax = 0.0;
+    long updates = 0;
+    bool touching = false;
+    auto t0 = std::chrono::steady_clock::now();
+    for (long f = 0; f < frames && !exit_requested(); ++f) {
+        GameMode mode = game_mode();
+        ++modeFrames[(int)mode];
+        InputState in;
+        if (replayPath) {
+            replay::Frame rf;
+            if (!player.next(rf)) break;
+            in = replay::unpack(rf);
+        } else {
+            in = host_script::input(f, mode, touching);
+        }
+        touching = in.touching;
+        hw_host_set_input(in);
+        hw_poll_input(in);
+        game_update(in);
+        if (recordPath) recorder.tick(replay::pack(in), game_state_hash());
+        if (replayPath && !player.check(game_state_hash())) {
+            fprintf(stderr, "replay diverged at tick %d (mode %d)\n", player.first_mismatch(), (int)game_mode());
+            return 1;
+        }
+        if (audio) {
+            auto u0 = std::chrono::steady_clock::now();
+            sound::update();
+            const double us = std::chrono::duration<double>(std::chrono::steady_clock::now() - u0).count();
+            updateSecs += us;
+            if (us > updateMax) updateMax = us;
+            ++updates;
+            double dsp = 1.0 / simclock::kSimHz;
+            if (hitchEvery > 0 && (f + 1) % hitchEvery == 0) dsp += hitchMs / 1000.0;
+            hw_host_audio_advance(dsp);
+        } else {
+            sound::update();
+        }
+        if (render) {
+            hw_begin_frame();
+            game_render_frame(in, false, false);
+            hw_end_frame();
+        }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    const double secs = std::chrono::duration<double>(t1 - t0).count();
+    if (replayPath && (!player.valid() || !player.done())) {
+        fprintf(stderr, "replay %s is truncated or malformed at tick %u\n", replayPath, player.tick());
+        return 1;
+    }
+    const HwHostStats& st = hw_host_stats();
+    printf("ballistica_host: %ld frames in %.3f s (%.0f frames/s)\n", frames, secs, secs > 0 ? frames / secs : 0.0);
+    printf("  frames by mode: title %ld, playing %ld, editor %ld, options %ld\n",
+           modeFrames[0], modeFrames[1], modeFrames[2], modeFrames[3]);
+    if (render && st.frames)
+        printf("  per rendered frame: %.1f rects, %.1f sprites, %.1f text strings\n",
+               (double)st.rects / st.frames, (double)st.sprites / st.frames, (double)st.texts / st.frames);
+    bool withinBudget = true;
+    if (drawStats) {
+        draws.detach();
+        withinBudget = draws.summarize(stdout);
+    }
+    if (audio) print_audio(updateSecs, updateMax, updates);
+    if (replayPath) printf("  replay: %u ticks match %s\n", player.tick(), replayPath);
+    if (recordPath) {
+        if (!recorder.save(recordPath)) { fprintf(stderr, "cannot write %s\n", recordPath); return 1; }
+        printf("  recorded %u ticks to %s (%zu bytes)\n", recorder.ticks(), recordPath, recorder.serialize().size());
+    }
+    sound::shutdown();
+    hw_shutdown();
+    return withinBudget ? 0 : 1;
+}
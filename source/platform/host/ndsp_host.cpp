@@ -0,0 +1,223 @@
+// Software stand-in for the part of libctru's NDSP that sound.cpp uses, mixed on the CPU.
+//
+// Off until hw_host_audio_enable(): ndspInit() then fails and sound.cpp runs with audio
+// disabled, as every host tool did before. Enabled, nothing plays by itself: the caller moves
+// the DSP clock on with hw_host_audio_advance() (a frame's worth per frame, so time is
+// simulated, not wall clock). Each advance plays the queued wave buffers of all 24 channels at
+// their own rate into the NDSP output rate, nearest-sample or linear (polyphase is treated as
+// linear), scaled by the front left/right mix volumes and the master volume. Buffers go
+// QUEUED -> PLAYING -> DONE as on the console; the aux mixes, ADPCM and the sequence ids are
+// not modelled. The stereo output is optionally appended to a 16-bit WAV file and hashed, and
+// per-channel counters record stolen sounds and underruns (see HwAudioStats).
+
+#include "hardware.hpp"
+#ifdef PLATFORM_HOST
+#include <3ds.h>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+    constexpr double kOutputRate = 32728.498046875; // NDSP sample rate (Hz)
+    constexpr int kChannels = 24;
+
+    struct Channel {
+        float rate = 32000.0f;
+        int interp = NDSP_INTERP_POLYPHASE;
+        u16 format = NDSP_FORMAT_MONO_PCM16;
+        float mix[12] = { 1.0f, 1.0f };
+        ndspWaveBuf* head = nullptr; // playing buffer, the rest queued behind it through ->next
+        double pos = 0.0;            // position in head, in source sample frames
+        bool dry = false;            // ran out of buffers since the last reset/clear
+        uint64_t dryFrom = 0;        // output sample at which it ran out
+    };
+
+    bool g_enabled = false;
+    bool g_open = false;             // between ndspInit and ndspExit
+    FILE* g_wav = nullptr;
+    uint32_t g_wavFrames = 0;
+    bool g_mono = false;
+    float g_master = 1.0f;
+    double g_owed = 0.0;             // fraction of an output sample carried between advances
+    Channel g_chn[kChannels];
+    HwAudioStats g_stats;
+    std::vector<float> g_mixL, g_mixR;
+    std::vector<int16_t> g_out;
+
+    void put_u16(uint8_t* p, uint16_t v) { p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); }
+    void put_u32(uint8_t* p, uint32_t v) { for (int i = 0; i < 4; ++i) p[i] = (uint8_t)(v >> (8 * i)); }
+
+    // Canonical 44-byte PCM16 stereo header; written with zero sizes and patched on close
+    void write_wav_header(FILE* f, uint32_t frames) {
+        uint8_t h[44];
+        memcpy(h, "RIFF", 4); put_u32(h + 4, 36 + frames * 4); memcpy(h + 8, "WAVEfmt ", 8);
+        put_u32(h + 16, 16); put_u16(h + 20, 1); put_u16(h + 22, 2);
+        put_u32(h + 24, (uint32_t)kOutputRate); put_u32(h + 28, (uint32_t)kOutputRate * 4);
+        put_u16(h + 32, 4); put_u16(h + 34, 16);
+        memcpy(h + 36, "data", 4); put_u32(h + 40, frames * 4);
+        fseek(f, 0, SEEK_SET);
+        fwrite(h, 1, sizeof h, f);
+    }
+
+    bool valid(int id) { return g_open && id >= 0 && id < kChannels; }
+
+    // Drop every queued buffer; ones that had not finished count as cut off
+    void clear_queue(int id) {
+        Channel& c = g_chn[id];
+        for (ndspWaveBuf* b = c.head; b; b = b->next) {
+            if (b->status != NDSP_WBUF_DONE) ++g_stats.channel[id].cutOff;
+            b->status = NDSP_WBUF_DONE;
+        }
+        c.head = nullptr;
+        c.pos = 0.0;
+        c.dry = false;
+    }
+
+    // Left/right sample of frame i of b, as floats in -1..1
+    void fetch(const Channel& c, const ndspWaveBuf* b, u32 i, float& l, float& r) {
+        const bool stereo = c.format == NDSP_FORMAT_STEREO_PCM16 || c.format == NDSP_FORMAT_STEREO_PCM8;
+        const bool pcm8 = c.format == NDSP_FORMAT_MONO_PCM8 || c.format == NDSP_FORMAT_STEREO_PCM8;
+        const u32 at = (b->offset + i) * (stereo ? 2 : 1);
+        if (pcm8) {
+            l = b->data_pcm8[at] / 128.0f;
+            r = stereo ? b->data_pcm8[at + 1] / 128.0f : l;
+        } else {
+            l = b->data_pcm16[at] / 32768.0f;
+            r = stereo ? b->data_pcm16[at + 1] / 32768.0f : l;
+        }
+    }
+
+    // Add n output samples of channel id to the mix buffers, advancing its queue
+    void mix_channel(int id, int n) {
+        Channel& c = g_chn[id];
+        const double step = c.rate / kOutputRate;
+        for (int i = 0; i < n && c.head; ) {
+            ndspWaveBuf* b = c.head;
+            if (b->status == NDSP_WBUF_QUEUED) b->status = NDSP_WBUF_PLAYING;
+            const u32 len = b->nsamples > b->offset ? b->nsamples - b->offset : 0;
+            if (c.pos >= len) {
+                c.pos -= len;
+                if (b->looping && len) continue;
+                b->status = NDSP_WBUF_DONE;
+                ++g_stats.channel[id].done;
+                c.head = b->next;
+                if (!c.head) { c.dry = true; c.dryFrom = g_stats.samples + i; c.pos = 0.0; }
+                continue;
+            }
+            const u32 k = (u32)c.pos;
+            float l, r;
+            fetch(c, b, k, l, r);
+            if (c.interp != NDSP_INTERP_NONE && k + 1 < len) {
+                float l1, r1;
+                fetch(c, b, k + 1, l1, r1);
+                const float t = (float)(c.pos - k);
+                l += (l1 - l) * t;
+                r += (r1 - r) * t;
+            }
+            g_mixL[i] += l * c.mix[0];
+            g_mixR[i] += r * c.mix[1];
+            c.pos += step;
+            ++i;
+        }
+    }
+}
+
+// ---- libctru NDSP ---------------------------------------------------------------------------
+Result ndspInit(void) {
+    if (!g_enabled) return -1; // no audio device: sound.cpp stays disabled
+    g_open = true;
+    g_mono = false;
+    g_master = 1.0f;
+    for (int i = 0; i < kChannels; ++i) g_chn[i] = Channel();
+    return 0;
+}
+void ndspExit(void) {
+    if (!g_open) return;
+    for (int i = 0; i < kChannels; ++i) clear_queue(i);
+    g_open = false;
+    if (g_wav) {
+        write_wav_header(g_wav, g_wavFrames);
+        fclose(g_wav);
+        g_wav = nullptr;
+    }
+}
+void ndspSetOutputMode(ndspOutputMode mode) { g_mono = mode == NDSP_OUTPUT_MONO; }
+void ndspSetMasterVol(float volume) { g_master = volume; }
+
+void ndspChnReset(int id) {
+    if (!valid(id)) return;
+    clear_queue(id);
+    g_chn[id] = Channel();
+}
+void ndspChnSetInterp(int id, int type) { if (valid(id)) g_chn[id].interp = type; }
+void ndspChnSetRate(int id, float rate) { if (valid(id)) g_chn[id].rate = rate > 0.0f ? rate : 0.0f; }
+void ndspChnSetFormat(int id, u16 format) { if (valid(id)) g_chn[id].format = format; }
+void ndspChnSetMix(int id, float mix[12]) { if (valid(id)) memcpy(g_chn[id].mix, mix, sizeof g_chn[id].mix); }
+
+void ndspChnWaveBufAdd(int id, ndspWaveBuf* buf) {
+    if (!buf) return;
+    if (!valid(id)) { buf->status = NDSP_WBUF_DONE; return; }
+    Channel& c = g_chn[id];
+    HwAudioChannelStats& st = g_stats.channel[id];
+    buf->next = nullptr;
+    buf->status = NDSP_WBUF_QUEUED;
+    ++st.queued;
+    if (c.dry) {
+        // The channel ran out before this buffer arrived: a gap the listener hears
+        ++st.underruns;
+        st.drySamples += g_stats.samples - c.dryFrom;
+        c.dry = false;
+    }
+    if (!c.head) { c.head = buf; c.pos = 0.0; return; }
+    ndspWaveBuf* t = c.head;
+    while (t->next) t = t->next;
+    t->next = buf;
+}
+void ndspChnWaveBufClear(int id) { if (valid(id)) clear_queue(id); }
+
+// ---- hardware.hpp (host controls) -----------------------------------------------------------
+bool hw_host_audio_enable(const char* wavPath) {
+    g_enabled = true;
+    if (!wavPath) return true;
+    g_wav = fopen(wavPath, "wb");
+    if (!g_wav) return false;
+    write_wav_header(g_wav, 0);
+    return true;
+}
+bool hw_host_audio_enabled() { return g_enabled; }
+uint64_t hw_host_audio_ms() { return (uint64_t)(g_stats.samples * 1000.0 / kOutputRate); }
+const HwAudioStats& hw_host_audio_stats() { return g_stats; }
+
+void hw_host_audio_advance(double seconds) {
+    if (!g_open || seconds <= 0.0) return;
+    g_owed += seconds * kOutputRate;
+    const int n = (int)g_owed;
+    g_owed -= n;
+    if (n <= 0) return;
+    g_mixL.assign(n, 0.0f);
+    g_mixR.assign(n, 0.0f);
+    for (int id = 0; id < kChannels; ++id) mix_channel(id, n);
+    g_out.resize((size_t)n * 2);
+    uint32_t h = g_stats.hash;
+    for (int i = 0; i < n; ++i) {
+        float l = g_mixL[i] * g_master, r = g_mixR[i] * g_master;
+        if (g_mono) l = r = (l + r) * 0.5f;
+        const float s[2] = { l, r };
+        for (int k = 0; k < 2; ++k) {
+            long v = lrintf(s[k] * 32767.0f);
+            if (v > 32767 || v < -32768) { ++g_stats.clipped; v = v > 0 ? 32767 : -32768; }
+            g_out[(size_t)i * 2 + k] = (int16_t)v;
+            h = (h ^ (uint32_t)(v & 0xFF)) * 16777619u;
+            h = (h ^ (uint32_t)((v >> 8) & 0xFF)) * 16777619u;
+        }
+    }
+    g_stats.hash = h;
+    g_stats.samples += (uint64_t)n;
+    if (g_wav) {
+        fwrite(g_out.data(), sizeof(int16_t), g_out.size(), g_wav);
+        g_wavFrames += (uint32_t)n;
+    }
+}
+
+#endif // PLATFORM_HOST
@@ -0,0 +1,104 @@
+// worksteal.hpp - runs a numbered batch of independent jobs over worker threads
+#pragma once
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Jobs 0..count-1 are dealt out as one contiguous range per worker. A worker takes jobs from
+// the front of its own range; when that is empty it steals the back half of the largest range
+// left, so workers that drew cheap jobs end up helping with the expensive ones. No job is ever
+// added once the batch starts, so a worker that finds every range empty is done.
+namespace worksteal {
+
+struct WorkerStats {
+    long jobs = 0;
+    long steals = 0;
+    double busySeconds = 0.0; // time spent inside fn
+};
+
+class Pool {
+public:
+    explicit Pool(int threads) : workers_(threads < 1 ? 1 : threads) {}
+
+    int threads() const { return (int)workers_.size(); }
+    const WorkerStats &stats(int worker) const { return workers_[worker].stats; }
+
+    // Calls fn(worker, job) once for every job, worker in 0..threads()-1. Calls on one worker
+    // are sequential, so fn can keep per-worker state (a game world) indexed by worker.
+    template <typename Fn>
+    void run(int count, Fn fn) {
+        const int n = threads();
+        for (int w = 0; w < n; ++w) {
+            workers_[w].lo = (int)((long)count * w / n);
+            workers_[w].hi = (int)((long)count * (w + 1) / n);
+            workers_[w].stats = WorkerStats();
+        }
+        std::vector<std::thread> pool;
+        for (int w = 1; w < n; ++w) pool.emplace_back([this, w, &fn]() { work(w, fn); });
+        work(0, fn);
+        for (std::thread &t : pool) t.join();
+    }
+
+private:
+    struct Worker {
+        std::mutex m;
+        int lo = 0, hi = 0; // jobs [lo, hi) still queued here
+        WorkerStats stats;
+    };
+
+    bool pop(int w, int &job) {
+        Worker &k = workers_[w];
+        std::lock_guard<std::mutex> lock(k.m);
+        if (k.lo >= k.hi) return false;
+        job = k.lo++;
+        return true;
+    }
+
+    // Move the back half of the fullest other range to worker w; false when all are empty
+    bool steal(int w) {
+        for (;;) {
+            int victim = -1, most = 0;
+            for (int v = 0; v < threads(); ++v) {
+                if (v == w) continue;
+                std::lock_guard<std::mutex> lock(workers_[v].m);
+                if (workers_[v].hi - workers_[v].lo > most) { most = workers_[v].hi - workers_[v].lo; victim = v; }
+            }
+            if (victim < 0) return false;
+            int lo, hi;
+            {
+                Worker &v = workers_[victim];
+                std::lock_guard<std::mutex> lock(v.m);
+                if (v.hi <= v.lo) continue; // drained meanwhile: look again
+                const int mid = v.hi - (v.hi - v.lo + 1) / 2;
+                lo = mid; hi = v.hi;
+                v.hi = mid;
+            }
+            Worker &k = workers_[w];
+            std::lock_guard<std::mutex> lock(k.m);
+            k.lo = lo; k.hi = hi;
+            ++k.stats.steals;
+            return true;
+        }
+    }
+
+    template <typename Fn>
+    void work(int w, Fn &fn) {
+        int job;
+        for (;;) {
+            if (!pop(w, job)) {
+                if (!steal(w)) return;
+                continue;
+            }
+            auto t0 = std::chrono::steady_clock::now();
+            fn(w, job);
+            auto t1 = std::chrono::steady_clock::now();
+            workers_[w].stats.busySeconds += std::chrono::duration<double>(t1 - t0).count();
+            ++workers_[w].stats.jobs;
+        }
+    }
+
+    std::vector<Worker> workers_;
+};
+
+} // namespace worksteal
@@ -0,0 +1,80 @@
+// replay_session.cpp - InputState packing and game setup capture / restore for replays
+#include "replay_session.hpp"
+#include <cstring>
+#include <sys/stat.h>
+#include "game.hpp"
+#include "levels.hpp"
+#include "options.hpp"
+
+namespace replay {
+
+// Bit order of the packed buttons; append only, the order is part of the file format
+Frame pack(const InputState& in) {
+    const bool bits[] = { in.touching, in.touchPressed, in.fireHeld, in.dpadUpPressed, in.dpadDownPressed,
+                          in.dpadDownHeld, in.startPressed, in.selectPressed, in.aPressed, in.bPressed,
+                          in.xPressed, in.levelPrevPressed, in.levelNextPressed, in.lHeld, in.rHeld };
+    Frame f;
+    for (int i = 0; i < (int)(sizeof bits / sizeof bits[0]); ++i)
+        if (bits[i]) f.buttons |= (uint16_t)(1u << i);
+    f.x = (int16_t)in.stylusX;
+    f.y = (int16_t)in.stylusY;
+    return f;
+}
+
+InputState unpack(const Frame& f) {
+    bool* bits[15];
+    InputState in;
+    bits[0] = &in.touching; bits[1] = &in.touchPressed; bits[2] = &in.fireHeld; bits[3] = &in.dpadUpPressed;
+    bits[4] = &in.dpadDownPressed; bits[5] = &in.dpadDownHeld; bits[6] = &in.startPressed;
+    bits[7] = &in.selectPressed; bits[8] = &in.aPressed; bits[9] = &in.bPressed; bits[10] = &in.xPressed;
+    bits[11] = &in.levelPrevPressed; bits[12] = &in.levelNextPressed; bits[13] = &in.lHeld; bits[14] = &in.rHeld;
+    for (int i = 0; i < 15; ++i) *bits[i] = (f.buttons >> i) & 1;
+    in.stylusX = f.x;
+    in.stylusY = f.y;
+    return in;
+}
+
+Header capture_header() {
+    Header h;
+    const char* pack = levels_get_active_file();
+    if (pack) strncpy(h.levelFile, pack, sizeof h.levelFile - 1);
+    h.startLevel = (int16_t)levels_current();
+    h.device = (uint8_t)options::device_type();
+    if (options::is_music_enabled()) h.flags |= kFlagMusic;
+    if (options::is_aim_guide_enabled()) h.flags |= kFlagAimGuide;
+#ifdef BALLISTICA_FIXED_SIM
+    h.flags |= kFlagFixedSim;
+#endif
+    h.seed = game_seed();
+    return h;
+}
+
+ApplyResult apply_header(const Header& h) {
+#ifdef BALLISTICA_FIXED_SIM
+    const bool fixedBuild = true;
+#else
+    const bool fixedBuild = false;
+#endif
+    if (((h.flags & kFlagFixedSim) != 0) != fixedBuild) return ApplyResult::SimMismatch;
+    const char* active = levels_get_active_file();
+    if (h.levelFile[0] && (!active || strcmp(active, h.levelFile) != 0)) {
+        levels_set_active_file(h.levelFile);
+        levels_reload_active();
+        active = levels_get_active_file();
+        if (!active || strcmp(active, h.levelFile) != 0) return ApplyResult::LevelMissing;
+    }
+    if (h.startLevel < 0 || h.startLevel >= levels_count() || !levels_set_current(h.startLevel)) return ApplyResult::LevelMissing;
+    levels_reset_level(h.startLevel);
+    if (h.device <= (uint8_t)options::DeviceType::ThreeDSXL) options::set_device_type((options::DeviceType)h.device);
+    game_set_seed(h.seed);
+    return ApplyResult::Ok;
+}
+
+bool save(const Writer& w, const char* path) {
+    // On 3DS fopen won't create directories
+    mkdir("sdmc:/ballistica", 0777);
+    mkdir("sdmc:/ballistica/replays", 0777);
+    return w.save(path);
+}
+
+} // namespace replay
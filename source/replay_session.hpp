@@ -0,0 +1,27 @@
+// replay_session.hpp - ties the replay format (replay.hpp) to InputState and the game setup
+#pragma once
+#include "hardware.hpp"
+#include "replay.hpp"
+
+namespace replay {
+
+// Where the 3DS build writes the session it records
+constexpr const char* kLastReplayPath = "sdmc:/ballistica/replays/last.rpl";
+
+// InputState <-> packed Frame (every field game_update reads)
+Frame pack(const InputState& in);
+InputState unpack(const Frame& f);
+
+// Level pack, current level, device type, option flags and game_seed() as they are now
+Header capture_header();
+// Why apply_header() could not restore a recording
+enum class ApplyResult { Ok, SimMismatch, LevelMissing };
+// Put the game back in the recorded setup; call after game_init() and before the first tick.
+// Fails without touching the game if the recording was made with the other simulation type
+// (FIXED_SIM), or if the recorded level pack or level is not available here.
+ApplyResult apply_header(const Header& h);
+
+// Writer::save() to path, creating sdmc:/ballistica/replays first
+bool save(const Writer& w, const char* path = kLastReplayPath);
+
+} // namespace replay
@@ -0,0 +1,124 @@
+// bench_balls.cpp - host benchmark: per-frame ball update, array-of-structs vs balls::Store
+//
+// The AoS side is a reference copy of the old loop: one Ball struct per ball carrying an image
+// handle, integrate + wall bounce with per-ball branches, and the active/regular recount done
+// inside the loop for the barrier check (O(n^2)). The SoA side is balls::integrate() plus one
+// balls::count() per frame, exactly as game.cpp runs it. Both are run at several ball counts
+// (512 matches the in-game stress mode) in float and in fx::Fixed.
+//
+// Build/run: make -C tools run-bench
+//            tools/build/bench_balls [frames]   (default 2000)
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <chrono>
+#include <vector>
+#include "layout.hpp"
+#include "balls.hpp"
+#include "fixed.hpp"
+
+namespace {
+
+const int kBallW = 6;
+
+// Stand-in for C2D_Image (two pointers) so the AoS element has the old footprint
+struct FakeImage { const void *tex; const void *subtex; };
+
+template <typename T>
+struct AosBall {
+    T x, y, vx, vy, px, py;
+    bool active;
+    bool isMurder;
+    FakeImage img;
+};
+
+template <typename T>
+void spawn(int n, std::vector<AosBall<T>> &aos, balls::Store<T> &soa)
+{
+    aos.clear(); soa.clear();
+    uint32_t seed = 777u;
+    for (int i = 0; i < n; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        T x = T(20 + (int)(seed >> 24)), y = T(100 + (int)((seed >> 16) & 0xFF));
+        T vx = T(((int)((seed >> 8) & 0xFF) - 128) / 50.0f), vy = T(-1.5f - (float)(seed & 0x7) * 0.1f);
+        bool murder = (i % 16) == 15;
+        AosBall<T> b = { x, y, vx, vy, x, y, true, murder, { nullptr, nullptr } };
+        aos.push_back(b);
+        soa.add(x, y, vx, vy, murder);
+    }
+}
+
+template <typename T>
+int aos_frame(std::vector<AosBall<T>> &balls, T left, T right, T top, T barrierY)
+{
+    int work = 0;
+    for (size_t bi = 0; bi < balls.size(); ++bi) {
+        AosBall<T> &b = balls[bi];
+        if (!b.active) continue;
+        b.px = b.x; b.py = b.y;
+        b.x += b.vx; b.y += b.vy;
+        if (b.x < left) { b.x = left; b.vx = -b.vx; ++work; }
+        if (b.x > right) { b.x = right; b.vx = -b.vx; ++work; }
+        if (b.y < top) { b.y = top; b.vy = -b.vy; ++work; }
+        int regActive = 0;
+        for (const auto &bb : balls) if (bb.active && !bb.isMurder) ++regActive;
+        if (regActive == 1 && b.y > barrierY) b.vy = -b.vy;
+        if (b.y > barrierY) { b.y = barrierY; b.vy = -b.vy; }
+        work += regActive & 1;
+    }
+    return work;
+}
+
+template <typename T>
+int soa_frame(balls::Store<T> &s, T left, T right, T top, T barrierY)
+{
+    int work = balls::integrate<T>(s, 0, left, right, top);
+    balls::Counts counts = balls::count(s);
+    const int n = s.size();
+    for (int i = 0; i < n; ++i) {
+        if (!s.active(i)) continue;
+        if (counts.regular == 1 && s.y[i] > barrierY) s.vy[i] = -s.vy[i];
+        if (s.y[i] > barrierY) { s.y[i] = barrierY; s.vy[i] = -s.vy[i]; }
+        work += counts.regular & 1;
+    }
+    return work;
+}
+
+template <typename T>
+void run(const char *name, int nBalls, int frames)
+{
+    std::vector<AosBall<T>> aos;
+    balls::Store<T> soa;
+    const T left = T(layout::PLAYFIELD_LEFT_WALL_X), right = T(layout::PLAYFIELD_RIGHT_WALL_X - kBallW);
+    const T top = T(layout::PLAYFIELD_TOP_WALL_Y), barrierY = T(440);
+    long sink = 0;
+
+    spawn(nBalls, aos, soa);
+    auto t0 = std::chrono::steady_clock::now();
+    for (int f = 0; f < frames; ++f) sink += aos_frame(aos, left, right, top, barrierY);
+    auto t1 = std::chrono::steady_clock::now();
+    for (int f = 0; f < frames; ++f) sink += soa_frame(soa, left, right, top, barrierY);
+    auto t2 = std::chrono::steady_clock::now();
+
+    // Same motion in both layouts: final positions must agree
+    int mismatches = 0;
+    for (int i = 0; i < nBalls; ++i)
+        if (!(aos[i].x == soa.x[i]) || !(aos[i].y == soa.y[i])) ++mismatches;
+    double aosNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / frames;
+    double soaNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / frames;
+    printf("%-5s balls=%4d  AoS %10.1f ns/frame  SoA %8.1f ns/frame  x%.1f  mismatches=%d (sink %ld)\n",
+           name, nBalls, aosNs, soaNs, soaNs > 0 ? aosNs / soaNs : 0.0, mismatches, sink & 1);
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    int frames = argc > 1 ? atoi(argv[1]) : 2000;
+    if (frames <= 0) frames = 2000;
+    printf("bench_balls: %d frames per run\n", frames);
+    const int counts[] = { 1, 8, 64, 512 };
+    for (int n : counts) run<float>("float", n, frames);
+    for (int n : counts) run<fx::Fixed>("fixed", n, frames);
+    return 0;
+}
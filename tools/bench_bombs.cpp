@@ -0,0 +1,186 @@
+// bench_bombs.cpp - host check + benchmark: bomb explosions, DFS vs precomputed clusters
+//
+// The DFS side is a reference copy of the old levels_explode_bomb(): a heap-allocated stack of
+// (col,row) pairs walking 8-neighbours from the hit bomb. The cluster side is what levels.cpp
+// now runs: brickgrid::BombClusters (union-find kept in sync by Occupancy::set) gives the
+// bomb cluster, and dilate8() layers give the reach and chain depth. Random boards are
+// exploded both ways and must destroy the same cells. Cluster membership is also checked
+// against a flood fill after random removals and re-adds. Exits non-zero on any mismatch.
+//
+// Build/run: make -C tools run-bench
+//            tools/build/bench_bombs [iterations]   (default 20000)
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <chrono>
+#include <vector>
+#include "brickgrid.hpp"
+#include "bench_check.hpp"
+
+namespace {
+
+using brickgrid::Mask;
+using brickgrid::kCols;
+using brickgrid::kRows;
+using brickgrid::kCells;
+const int kBomb = (int)BrickType::BO;
+const int kPlain = (int)BrickType::YB;
+
+struct Board {
+    uint8_t bricks[kCells];
+    brickgrid::Occupancy occ;
+    void put(int i, int t) { bricks[i] = (uint8_t)t; occ.set(i, t); }
+};
+
+uint32_t g_seed = 2024u;
+uint32_t rnd() { g_seed = g_seed * 1664525u + 1013904223u; return g_seed >> 8; }
+
+// bombPct percent of cells are bombs, the rest of the occupied cells plain bricks
+void random_board(Board &b, int fillPct, int bombPct)
+{
+    for (int i = 0; i < kCells; ++i) {
+        int t = 0;
+        if ((int)(rnd() % 100) < fillPct) t = ((int)(rnd() % 100) < bombPct) ? kBomb : kPlain;
+        b.bricks[i] = (uint8_t)t;
+    }
+    b.occ.rebuild(b.bricks, kCells);
+}
+
+// Old levels_explode_bomb (minus the hp array), returning the destroyed cells
+int explode_dfs(Board &b, int c, int r, Mask &out)
+{
+    out.clear();
+    if (b.bricks[r * kCols + c] != kBomb) return 0;
+    int destroyed = 0;
+    std::vector<std::pair<int,int>> stack;
+    stack.push_back(std::make_pair(c, r));
+    while (!stack.empty()) {
+        std::pair<int,int> pr = stack.back();
+        stack.pop_back();
+        int cc = pr.first, rr = pr.second;
+        if (cc < 0 || cc >= kCols || rr < 0 || rr >= kRows) continue;
+        int i = rr * kCols + cc;
+        int t = b.bricks[i];
+        if (!t) continue;
+        b.put(i, 0);
+        out.set(i);
+        ++destroyed;
+        if (t == kBomb)
+            for (int dy = -1; dy <= 1; ++dy)
+                for (int dx = -1; dx <= 1; ++dx)
+                    if (dx || dy) stack.push_back(std::make_pair(cc + dx, rr + dy));
+    }
+    return destroyed;
+}
+
+// Same walk as levels.cpp, returning the destroyed cells and the deepest chain depth
+int explode_clusters(Board &b, int c, int r, Mask &out, int *maxDepth)
+{
+    out.clear();
+    int idx = r * kCols + c;
+    if (b.bricks[idx] != kBomb) return 0;
+    Mask cluster = b.occ.bombClusters.members(idx, b.occ.bomb);
+    Mask reach = cluster | (brickgrid::dilate8(cluster) & b.occ.any);
+    Mask frontier; frontier.clear(); frontier.set(idx);
+    Mask done = frontier;
+    int destroyed = 0, depth = 0;
+    for (; frontier.any(); ++depth) {
+        for (int i = frontier.next(0); i >= 0; i = frontier.next(i + 1)) { b.put(i, 0); out.set(i); ++destroyed; }
+        Mask bombs = frontier & cluster;
+        frontier = brickgrid::minus(brickgrid::dilate8(bombs) & reach, done);
+        done = done | frontier;
+    }
+    *maxDepth = depth - 1;
+    return destroyed;
+}
+
+// Reference cluster of bomb i by flood fill over the bomb mask
+Mask flood(const Board &b, int i)
+{
+    Mask m; m.clear(); m.set(i);
+    for (;;) {
+        Mask n = brickgrid::dilate8(m) & b.occ.bomb;
+        bool same = true;
+        for (int k = 0; k < brickgrid::kWords; ++k) same = same && n.w[k] == m.w[k];
+        if (same) return m;
+        m = n;
+    }
+}
+
+bool equal(const Mask &a, const Mask &b)
+{
+    for (int k = 0; k < brickgrid::kWords; ++k) if (a.w[k] != b.w[k]) return false;
+    return true;
+}
+
+using bench_check::expect;
+
+void check_dilate()
+{
+    // A corner and a row-end cell must not wrap into the opposite column
+    Mask m; m.clear(); m.set(kCols - 1); m.set(kCols * 5);
+    Mask d = brickgrid::dilate8(m);
+    expect(d.count() == 4 + 6, "dilate8 neighbour count at edges");
+    expect(!d.test(kCols) && !d.test(kCols * 5 - 1 + kCols), "dilate8 does not wrap rows");
+    Mask last; last.clear(); last.set(kCells - 1);
+    expect(brickgrid::dilate8(last).count() == 4, "dilate8 at the last cell");
+}
+
+void check_clusters(int iters)
+{
+    static Board b;
+    for (int it = 0; it < iters; ++it) {
+        random_board(b, 80, 45);
+        // Random removals and re-adds through Occupancy::set, querying in between
+        for (int step = 0; step < 40; ++step) {
+            int i = (int)(rnd() % kCells);
+            int t = (rnd() & 3) ? 0 : kBomb;
+            b.put(i, t);
+            if (step % 5 == 4) {
+                int q = b.occ.bomb.next((int)(rnd() % kCells));
+                if (q >= 0) expect(equal(b.occ.bombClusters.members(q, b.occ.bomb), flood(b, q)), "cluster matches flood fill");
+            }
+        }
+        for (int q = b.occ.bomb.next(0); q >= 0; q = b.occ.bomb.next(q + 1))
+            expect(equal(b.occ.bombClusters.members(q, b.occ.bomb), flood(b, q)), "cluster matches flood fill (full sweep)");
+    }
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    int iters = argc > 1 ? atoi(argv[1]) : 20000;
+    if (iters <= 0) iters = 20000;
+    printf("bench_bombs: %d explosions per run\n", iters);
+    check_dilate();
+    check_clusters(iters / 20 + 1);
+
+    static Board a, b;
+    long sumA = 0, sumB = 0;
+    int deepest = 0;
+    double dfsNs = 0, clusterNs = 0;
+    for (int it = 0; it < iters; ++it) {
+        random_board(a, 85, it & 1 ? 70 : 20);
+        b = a;
+        int start = a.occ.bomb.next((int)(rnd() % kCells));
+        if (start < 0) start = a.occ.bomb.next(0);
+        if (start < 0) continue;
+        Mask ma, mb;
+        int depth = 0;
+        auto t0 = std::chrono::steady_clock::now();
+        sumA += explode_dfs(a, start % kCols, start / kCols, ma);
+        auto t1 = std::chrono::steady_clock::now();
+        sumB += explode_clusters(b, start % kCols, start / kCols, mb, &depth);
+        auto t2 = std::chrono::steady_clock::now();
+        dfsNs += std::chrono::duration<double, std::nano>(t1 - t0).count();
+        clusterNs += std::chrono::duration<double, std::nano>(t2 - t1).count();
+        if (depth > deepest) deepest = depth;
+        expect(equal(ma, mb), "cluster explosion destroys the same cells as the DFS");
+        expect(equal(a.occ.any, b.occ.any), "boards agree after explosion");
+    }
+    printf("DFS      %8.1f ns/explosion\n", dfsNs / iters);
+    printf("clusters %8.1f ns/explosion  x%.1f  (cells destroyed %ld vs %ld, deepest chain %d)\n",
+           clusterNs / iters, clusterNs > 0 ? dfsNs / clusterNs : 0.0, sumA, sumB, deepest);
+    return bench_check::report("bench_bombs");
+}
@@ -0,0 +1,23 @@
+// bench_check.hpp - pass/fail bookkeeping shared by the host tools' correctness checks
+#pragma once
+#include <cstdio>
+
+namespace bench_check {
+
+inline int &failures() { static int n = 0; return n; }
+
+// Count a failed check; only the first ten are printed
+inline void expect(bool ok, const char *what)
+{
+    if (!ok && failures()++ < 10) printf("FAIL: %s\n", what);
+}
+
+// Print "<tool>: OK" or the failure count; main() returns the result as its exit code
+inline int report(const char *tool)
+{
+    if (failures()) { printf("%s: %d failure(s)\n", tool, failures()); return 1; }
+    printf("%s: OK\n", tool);
+    return 0;
+}
+
+} // namespace bench_check
@@ -0,0 +1,289 @@
+// bench_collision.cpp - host benchmark: exact swept grid collision vs legacy 0.5px stepping
+//
+// Loads every .DAT pack from the given directories, fires random ball segments through each
+// level and runs both the old substep loop (reference copy below) and collision::sweep_grid().
+// Reports iteration counts, timing and how often the two disagree on the hit. A second pass
+// slides the SS/SF bricks and compares the old end-point check_moving() test against
+// collision::sweep_sliding_rect(); hits only the sweep finds are counted as tunnelling.
+//
+// Build/run: make -C tools run-bench
+//            tools/build/bench_collision [segmentsPerLevel] [levelDir...]   (default: romfs)
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <cmath>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <dirent.h>
+#include "brick.hpp"
+#include "layout.hpp"
+#include "collision.hpp"
+
+namespace {
+
+const int kCols = 13, kRows = 13, kCells = kCols * kRows;
+const float kBallW = 6.f, kBallH = 6.f;
+
+struct BenchLevel { std::string pack; int index; uint8_t bricks[kCells]; };
+
+// Minimal .DAT reader (same token rules as levels.cpp parseAll)
+const char* kBrickCodes[] = {
+    "NB","YB","GB","CB","TB","PB","RB","LB","SB","FB","F1","F2","B1","B2","B3","B4","B5","BS","BB","ID","RW","RE","IS","IF","AB","FO","LA","MB","BA","T5","BO","OF","ON","SS","SF"
+};
+int code_index(const char* tok) {
+    for (int i = 0; i < (int)BrickType::COUNT; ++i) if (strcmp(kBrickCodes[i], tok) == 0) return i;
+    return 0;
+}
+void load_pack(const std::string& dir, const std::string& name, std::vector<BenchLevel>& out) {
+    std::string path = dir + "/" + name;
+    FILE* f = fopen(path.c_str(), "rb"); if (!f) return;
+    char tok[64]; BenchLevel cur; int n = -1; int idx = 0;
+    auto commit = [&]() { if (n >= 13 * 11) { for (int i = n; i < kCells; ++i) cur.bricks[i] = 0; out.push_back(cur); } };
+    while (fscanf(f, "%63s", tok) == 1) {
+        if (strcmp(tok, "LEVEL") == 0) {
+            int lv; if (fscanf(f, "%d", &lv) != 1) break;
+            commit(); cur = BenchLevel(); cur.pack = name; cur.index = idx++; n = 0;
+        } else if (strcmp(tok, "SPEED") == 0) { int sp; if (fscanf(f, "%d", &sp) != 1) break; }
+        else if (strcmp(tok, "NAME") == 0) { int ch; while ((ch = fgetc(f)) != '\n' && ch != EOF) {} }
+        else if (n >= 0 && n < kCells && strlen(tok) == 2) cur.bricks[n++] = (uint8_t)code_index(tok);
+    }
+    commit();
+    fclose(f);
+}
+
+bool is_moving(int raw) { return raw == (int)BrickType::SS || raw == (int)BrickType::SF; }
+
+struct Result { bool hit; int col, row; float cx, cy; bool preferX; long iters; long lookups; };
+
+// Reflection axis exactly as resolve_hit() picks it from the contact position
+bool resolve_axis(const collision::GridGeom<float>& g, int c, int r, float cx, float cy, float stepDX, float stepDY) {
+    float bx = g.left + c * g.cellW, by = g.top + r * g.cellH;
+    float distL = cx - (bx - g.halfW), distR = (bx + g.cellW + g.halfW) - cx;
+    float distT = cy - (by - g.halfH), distB = (by + g.cellH + g.halfH) - cy;
+    float penX = std::min(distL, distR), penY = std::min(distT, distB);
+    bool preferX = penX < penY;
+    if (std::fabs(penX - penY) < 0.25f) {
+        if (std::fabs(stepDX) > std::fabs(stepDY)) preferX = true;
+        else if (std::fabs(stepDY) > std::fabs(stepDX)) preferX = false;
+    }
+    return preferX;
+}
+
+// Reference copy of the pre-sweep step_and_check_static() loop from game.cpp
+Result legacy_step(const collision::GridGeom<float>& g, const uint8_t* bricks, float sx, float sy, float ex, float ey) {
+    Result res = {false, -1, -1, ex, ey, false, 0, 0};
+    float dx = ex - sx, dy = ey - sy;
+    const float stepSize = 0.5f;
+    int steps = (int)std::ceil(std::max(std::fabs(dx), std::fabs(dy)) / stepSize);
+    if (steps < 1) steps = 1;
+    float stepDX = dx / (float)steps, stepDY = dy / (float)steps;
+    for (int i = 1; i <= steps; ++i) {
+        ++res.iters;
+        float cx = sx + stepDX * (float)i, cy = sy + stepDY * (float)i;
+        int minCol = (int)(((cx - g.halfW) - g.left) / g.cellW); if (minCol < 0) minCol = 0; if (minCol >= kCols) continue;
+        int maxCol = (int)(((cx + g.halfW) - g.left) / g.cellW); if (maxCol < 0) continue; if (maxCol >= kCols) maxCol = kCols - 1;
+        int minRow = (int)(((cy - g.halfH) - g.top) / g.cellH); if (minRow < 0) minRow = 0; if (minRow >= kRows) continue;
+        int maxRow = (int)(((cy + g.halfH) - g.top) / g.cellH); if (maxRow < 0) continue; if (maxRow >= kRows) maxRow = kRows - 1;
+        for (int r = minRow; r <= maxRow; ++r) {
+            for (int c = minCol; c <= maxCol; ++c) {
+                ++res.lookups;
+                int raw = bricks[r * kCols + c];
+                if (raw <= 0 || is_moving(raw)) continue;
+                float bx = g.left + c * g.cellW, by = g.top + r * g.cellH;
+                if (!(cx >= bx - g.halfW && cx <= bx + g.cellW + g.halfW && cy >= by - g.halfH && cy <= by + g.cellH + g.halfH)) continue;
+                res.hit = true; res.col = c; res.row = r; res.cx = cx; res.cy = cy;
+                res.preferX = resolve_axis(g, c, r, cx, cy, stepDX, stepDY);
+                return res;
+            }
+        }
+    }
+    return res;
+}
+
+Result swept(const collision::GridGeom<float>& g, const uint8_t* bricks, float sx, float sy, float ex, float ey) {
+    collision::SweepHit<float> h = collision::sweep_grid(g, sx, sy, ex, ey,
+        [bricks](int c, int r) { int raw = bricks[r * kCols + c]; return raw > 0 && !is_moving(raw); });
+    Result res = {h.hit, h.col, h.row, h.hit ? h.x : ex, h.hit ? h.y : ey, false, h.cellsVisited, h.cellTests};
+    if (h.hit) res.preferX = resolve_axis(g, h.col, h.row, h.x, h.y, ex - sx, ey - sy);
+    return res;
+}
+
+// Sliding brick state for one frame: left edge before/after the advance
+struct Slider { int idx; float prev, now; };
+
+// Same span rule as update_moving_bricks(): contiguous empty cells either side in the row
+void brick_span(const uint8_t* bricks, int idx, float left, float cellW, float& minX, float& maxX) {
+    int r = idx / kCols, c = idx % kCols, lo = c, hi = c;
+    while (lo - 1 >= 0 && bricks[r * kCols + lo - 1] == 0) --lo;
+    while (hi + 1 < kCols && bricks[r * kCols + hi + 1] == 0) ++hi;
+    minX = left + lo * cellW; maxX = left + hi * cellW;
+}
+
+// Reference copy of the pre-sweep check_moving(): ball end point vs every moving cell, row-major
+int legacy_moving(const collision::GridGeom<float>& g, const std::vector<Slider>& sl, float ex, float ey, long& tests) {
+    // The original walked all 169 cells via levels_brick_at(); count those lookups
+    for (const Slider& s : sl) {
+        float by = g.top + (s.idx / kCols) * g.cellH;
+        if (ex >= s.now - g.halfW && ex <= s.now + g.cellW + g.halfW && ey >= by - g.halfH && ey <= by + g.cellH + g.halfH) {
+            tests += s.idx + 1;
+            return s.idx;
+        }
+    }
+    tests += kCells;
+    return -1;
+}
+
+// Swept relative-motion test over the rows the segment crosses (as in handle_ball_bricks)
+int swept_moving(const collision::GridGeom<float>& g, const std::vector<Slider>& sl, const int* rowStart,
+                 float sx, float sy, float ex, float ey, long& tests) {
+    int r0 = (int)std::floor((std::min(sy, ey) - g.halfH - g.top) / g.cellH);
+    int r1 = (int)std::floor((std::max(sy, ey) + g.halfH - g.top) / g.cellH);
+    if (r0 < 0) r0 = 0;
+    if (r1 > kRows - 1) r1 = kRows - 1;
+    float bestT = 2.f; int best = -1;
+    for (int r = r0; r <= r1; ++r) {
+        for (int k = rowStart[r]; k < rowStart[r + 1]; ++k) {
+            ++tests;
+            const Slider& s = sl[k];
+            float t; collision::Face f;
+            if (!collision::sweep_sliding_rect(sx, sy, ex, ey, s.prev, s.now, g.top + r * g.cellH, g.cellW, g.cellH, g.halfW, g.halfH, t, f)) continue;
+            if (t < bestT) { bestT = t; best = s.idx; }
+        }
+    }
+    return best;
+}
+
+struct Rng { uint32_t s; float next() { s ^= s << 13; s ^= s >> 17; s ^= s << 5; return (s & 0xFFFFFF) / 16777216.0f; } };
+
+struct Segment { float sx, sy, ex, ey; };
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int perLevel = argc > 1 ? atoi(argv[1]) : 20000;
+    if (perLevel <= 0) perLevel = 20000;
+    std::vector<std::string> dirs;
+    for (int i = 2; i < argc; ++i) dirs.push_back(argv[i]);
+    if (dirs.empty()) dirs.push_back("romfs");
+
+    std::vector<BenchLevel> levels;
+    int packCount = 0;
+    for (const auto& dir : dirs) {
+        std::vector<std::string> packs;
+        if (DIR* d = opendir(dir.c_str())) {
+            while (dirent* e = readdir(d)) {
+                std::string n = e->d_name;
+                if (n.size() > 4 && (n.substr(n.size() - 4) == ".DAT" || n.substr(n.size() - 4) == ".dat")) packs.push_back(n);
+            }
+            closedir(d);
+        }
+        std::sort(packs.begin(), packs.end());
+        for (const auto& p : packs) load_pack(dir, p, levels);
+        packCount += (int)packs.size();
+    }
+    if (levels.empty()) { fprintf(stderr, "no levels found\n"); return 1; }
+
+    collision::GridGeom<float> g;
+    g.left = (float)((layout::SCREEN_WIDTH - layout::BRICK_CELL_W * kCols) / 2);
+    g.top = (float)layout::BRICK_GRID_TOP;
+    g.cellW = (float)layout::BRICK_CELL_W; g.cellH = (float)layout::BRICK_CELL_H;
+    g.cols = kCols; g.rows = kRows; g.halfW = kBallW * 0.5f; g.halfH = kBallH * 0.5f;
+
+    // Segments start anywhere from the HUD line to just below the grid, at 0.5..12 px/frame
+    Rng rng = {0x2545F491u};
+    std::vector<Segment> segs(perLevel);
+    for (auto& s : segs) {
+        s.sx = rng.next() * layout::SCREEN_WIDTH;
+        s.sy = layout::PLAYFIELD_TOP_WALL_Y + rng.next() * (g.rows * g.cellH + layout::UI_BRICK_OFFSET + 40.f);
+        float ang = rng.next() * 6.2831853f, spd = 0.5f + rng.next() * 11.5f;
+        s.ex = s.sx + std::cos(ang) * spd; s.ey = s.sy + std::sin(ang) * spd;
+    }
+
+    long n = 0, bothHit = 0, sameCell = 0, sameAxis = 0, onlyLegacy = 0, onlySwept = 0;
+    long legacyIters = 0, legacyLookups = 0, sweptCells = 0, sweptTests = 0;
+    double legacyNs = 0, sweptNs = 0;
+    volatile long sink = 0;
+    typedef std::chrono::steady_clock Clock;
+    for (const auto& L : levels) {
+        std::vector<Result> a(segs.size()), b(segs.size());
+        Clock::time_point t0 = Clock::now();
+        for (size_t i = 0; i < segs.size(); ++i) a[i] = legacy_step(g, L.bricks, segs[i].sx, segs[i].sy, segs[i].ex, segs[i].ey);
+        Clock::time_point t1 = Clock::now();
+        for (size_t i = 0; i < segs.size(); ++i) b[i] = swept(g, L.bricks, segs[i].sx, segs[i].sy, segs[i].ex, segs[i].ey);
+        Clock::time_point t2 = Clock::now();
+        legacyNs += std::chrono::duration<double, std::nano>(t1 - t0).count();
+        sweptNs += std::chrono::duration<double, std::nano>(t2 - t1).count();
+        for (size_t i = 0; i < segs.size(); ++i) {
+            ++n;
+            legacyIters += a[i].iters; legacyLookups += a[i].lookups;
+            sweptCells += b[i].iters; sweptTests += b[i].lookups;
+            sink += a[i].col + b[i].col;
+            if (a[i].hit && b[i].hit) {
+                ++bothHit;
+                if (a[i].col == b[i].col && a[i].row == b[i].row) {
+                    ++sameCell;
+                    if (a[i].preferX == b[i].preferX) ++sameAxis;
+                }
+            } else if (a[i].hit) ++onlyLegacy;
+            else if (b[i].hit) ++onlySwept;
+        }
+    }
+
+    // Sliding bricks: each segment sees a random frame of brick motion (SS 0.5px, SF 1px)
+    long mn = 0, mLegacyHit = 0, mSweptHit = 0, mTunnelled = 0, mLegacyTests = 0, mSweptTests = 0;
+    int movingLevels = 0;
+    for (const auto& L : levels) {
+        std::vector<int> movers;
+        for (int i = 0; i < kCells; ++i) if (is_moving(L.bricks[i])) movers.push_back(i);
+        if (movers.empty()) continue;
+        ++movingLevels;
+        const int kFrames = 64;
+        std::vector<std::vector<Slider>> frames(kFrames);
+        for (auto& fr : frames) {
+            for (int idx : movers) {
+                float minX, maxX;
+                brick_span(L.bricks, idx, g.left, g.cellW, minX, maxX);
+                float pos = minX + rng.next() * (maxX - minX);
+                float spd = L.bricks[idx] == (int)BrickType::SS ? 0.5f : 1.0f;
+                float now = pos + (rng.next() < 0.5f ? -spd : spd);
+                if (now < minX) now = minX;
+                if (now > maxX) now = maxX;
+                fr.push_back(Slider{idx, pos, now});
+            }
+        }
+        int rowStart[kRows + 1] = {0};
+        for (int idx : movers) ++rowStart[idx / kCols + 1];
+        for (int r = 0; r < kRows; ++r) rowStart[r + 1] += rowStart[r];
+        for (size_t i = 0; i < segs.size(); ++i) {
+            const auto& fr = frames[i % kFrames];
+            const Segment& sg = segs[i];
+            int a = legacy_moving(g, fr, sg.ex, sg.ey, mLegacyTests);
+            int b = swept_moving(g, fr, rowStart, sg.sx, sg.sy, sg.ex, sg.ey, mSweptTests);
+            ++mn;
+            if (a >= 0) ++mLegacyHit;
+            if (b >= 0) ++mSweptHit;
+            if (b >= 0 && a < 0) ++mTunnelled;
+        }
+    }
+
+    printf("levels=%zu packs=%d segments=%ld\n", levels.size(), packCount, n);
+    printf("legacy 0.5px stepping : %.2f substeps/call  %.2f cell lookups/call  %.1f ns/call\n",
+           (double)legacyIters / n, (double)legacyLookups / n, legacyNs / n);
+    printf("swept grid DDA        : %.2f cells walked/call %.2f cell tests/call   %.1f ns/call\n",
+           (double)sweptCells / n, (double)sweptTests / n, sweptNs / n);
+    printf("hits: both=%ld sameCell=%ld (%.3f%%) sameAxis=%ld (%.3f%%)\n", bothHit, sameCell,
+           bothHit ? 100.0 * sameCell / bothHit : 100.0, sameAxis, sameCell ? 100.0 * sameAxis / sameCell : 100.0);
+    printf("only legacy hit=%ld  only swept hit=%ld (legacy tunnelled past a corner)\n", onlyLegacy, onlySwept);
+    if (mn > 0) {
+        printf("moving bricks (%d levels, %ld segments):\n", movingLevels, mn);
+        printf("  legacy end-point check : %.2f cells scanned/call  hits=%ld\n", (double)mLegacyTests / mn, mLegacyHit);
+        printf("  swept relative motion  : %.2f bricks tested/call  hits=%ld\n", (double)mSweptTests / mn, mSweptHit);
+        printf("  tunnelled (legacy missed a swept hit)=%ld (%.3f%% of swept hits)\n", mTunnelled,
+               mSweptHit ? 100.0 * mTunnelled / mSweptHit : 0.0);
+    }
+    (void)sink;
+    return 0;
+}
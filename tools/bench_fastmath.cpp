@@ -0,0 +1,161 @@
+// bench_fastmath.cpp - host check + benchmark: fastmath.hpp against libm
+//
+// Accuracy: sin/cos over several turns (float and Q16.16), atan2 over a grid of directions,
+// rsqrt and length over a wide range, and the burst direction table for every ring size the
+// game uses. Each is compared with libm in double precision and must stay inside the bound
+// documented in fastmath.hpp. Timing: ns per call for libm, fastmath and the old fx::
+// polynomial versions. Exits non-zero if any bound is exceeded.
+//
+// Build/run: make -C tools run-bench
+//            tools/build/bench_fastmath [calls]   (default 2000000)
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include "fastmath.hpp"
+#include "bench_check.hpp"
+
+namespace {
+
+const double kTwoPi = 6.283185307179586;
+
+using bench_check::expect;
+
+void check_trig()
+{
+    double sinErr = 0, cosErr = 0, fxSinErr = 0, fxCosErr = 0;
+    for (int i = -400000; i <= 400000; ++i) {
+        const double a = i * (4.0 * kTwoPi / 800000.0);   // -4..4 turns
+        sinErr = std::max(sinErr, std::fabs(fastmath::sin((float)a) - std::sin((double)(float)a)));
+        cosErr = std::max(cosErr, std::fabs(fastmath::cos((float)a) - std::cos((double)(float)a)));
+        const fx::Fixed f(a);
+        const double fa = f.raw / 65536.0;   // the angle the Fixed value actually holds
+        fxSinErr = std::max(fxSinErr, std::fabs(fastmath::sin(f).raw / 65536.0 - std::sin(fa)));
+        fxCosErr = std::max(fxCosErr, std::fabs(fastmath::cos(f).raw / 65536.0 - std::cos(fa)));
+    }
+    printf("sin/cos float    max error %.2e / %.2e\n", sinErr, cosErr);
+    printf("sin/cos Q16.16   max error %.2e / %.2e\n", fxSinErr, fxCosErr);
+    expect(sinErr < 2e-5 && cosErr < 2e-5, "float sin/cos within 2e-5");
+    // Q16.16 output adds up to half an lsb of rounding and the angle conversion one more
+    expect(fxSinErr < 4e-5 && fxCosErr < 4e-5, "Q16.16 sin/cos within 4e-5");
+}
+
+void check_atan2()
+{
+    double err = 0, fxErr = 0;
+    for (int i = 0; i < 3600; ++i) {
+        const double a = i * kTwoPi / 3600.0 - kTwoPi * 0.5;
+        for (double r = 0.01; r < 500.0; r *= 3.7) {
+            const float y = (float)(std::sin(a) * r), x = (float)(std::cos(a) * r);
+            const double ref = std::atan2((double)y, (double)x);
+            double e = std::fabs(fastmath::atan2(y, x) - ref);
+            err = std::max(err, std::min(e, kTwoPi - e));   // +-pi are the same direction
+            const fx::Fixed fy(y), fx_(x);
+            if (fy.raw == 0 && fx_.raw == 0) continue;
+            const double fref = std::atan2(fy.raw / 65536.0, fx_.raw / 65536.0);
+            e = std::fabs(fastmath::atan2(fy, fx_).raw / 65536.0 - fref);
+            fxErr = std::max(fxErr, std::min(e, kTwoPi - e));
+        }
+    }
+    printf("atan2 float      max error %.2e rad\n", err);
+    printf("atan2 Q16.16     max error %.2e rad\n", fxErr);
+    expect(err < 0.002, "float atan2 within 0.002 rad");
+    expect(fxErr < 0.005, "Q16.16 atan2 within 0.005 rad");
+    expect(fastmath::atan2(0.0f, 0.0f) == 0.0f, "atan2(0,0) is 0");
+}
+
+void check_rsqrt()
+{
+    double rel = 0, lenRel = 0;
+    for (double v = 1e-6; v < 1e8; v *= 1.013) {
+        const double ref = 1.0 / std::sqrt((double)(float)v);
+        rel = std::max(rel, std::fabs(fastmath::rsqrt((float)v) - ref) / ref);
+    }
+    for (int i = 1; i < 2000; ++i) {
+        const float x = (float)(i * 0.37 - 300.0), y = (float)(i * 0.011 + 0.5);
+        float inv = 0;
+        const float len = fastmath::length(x, y, &inv);
+        const double ref = std::sqrt((double)x * x + (double)y * y);
+        lenRel = std::max(lenRel, std::fabs(len - ref) / ref);
+        lenRel = std::max(lenRel, std::fabs(inv * ref - 1.0));
+    }
+    printf("rsqrt float      max rel error %.2e (length %.2e)\n", rel, lenRel);
+    expect(rel < 1e-5 && lenRel < 1e-5, "rsqrt/length within 1e-5 relative");
+    expect(fastmath::rsqrt(0.0f) == 0.0f && fastmath::rsqrt(-1.0f) == 0.0f, "rsqrt of v <= 0 is 0");
+    fx::Fixed inv;
+    expect(fastmath::length(fx::Fixed(3), fx::Fixed(4), &inv).raw == fx::Fixed(5).raw, "Q16.16 length 3-4-5");
+    expect(std::fabs(inv.to_float() - 0.2f) < 1e-4f, "Q16.16 inverse length");
+}
+
+void check_directions()
+{
+    const int sizes[] = { 8, 12, 16, 150 };   // bomb, dust, and bench_pools bursts
+    double err = 0;
+    for (int n : sizes)
+        for (int k = 0; k < n; ++k) {
+            float dx, dy;
+            fastmath::direction(k, n, dx, dy);
+            const double a = kTwoPi * k / n;
+            err = std::max(err, std::max(std::fabs(dx - std::cos(a)), std::fabs(dy - std::sin(a))));
+            fx::Fixed fdx, fdy;
+            fastmath::direction(k, n, fdx, fdy);
+            expect(fdx.to_float() == dx && fdy.to_float() == dy, "float and Q16.16 directions agree");
+        }
+    printf("burst directions max error %.2e\n", err);
+    expect(err < 4e-5, "burst directions within 4e-5");
+}
+
+volatile float g_sinkF;
+volatile int32_t g_sinkI;
+
+template <typename F>
+double time_calls(int calls, F f)
+{
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / calls;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    int calls = argc > 1 ? atoi(argv[1]) : 2000000;
+    if (calls <= 0) calls = 2000000;
+    printf("bench_fastmath: %d calls per timing\n", calls);
+    check_trig();
+    check_atan2();
+    check_rsqrt();
+    check_directions();
+
+    // Inputs built up front so the loops time only the calls
+    std::vector<float> a(4096), b(4096);
+    std::vector<fx::Fixed> fa(4096), fb(4096);
+    for (int i = 0; i < 4096; ++i) {
+        a[i] = (float)((i * 2654435761u % 100000u) / 100000.0 * 12.0 - 6.0);
+        b[i] = (float)(((i * 40503u) % 100000u) / 100000.0 * 8.0 - 4.0) + 0.01f;
+        fa[i] = fx::Fixed(a[i]);
+        fb[i] = fx::Fixed(b[i]);
+    }
+    const int m = 4095;
+    double libSin = time_calls(calls, [&] { float s = 0; for (int i = 0; i < calls; ++i) s += std::sin(a[i & m]); g_sinkF = s; });
+    double fastSin = time_calls(calls, [&] { float s = 0; for (int i = 0; i < calls; ++i) s += fastmath::sin(a[i & m]); g_sinkF = s; });
+    double fxSin = time_calls(calls, [&] { int32_t s = 0; for (int i = 0; i < calls; ++i) s += fx::sin(fa[i & m]).raw; g_sinkI = s; });
+    double fastFxSin = time_calls(calls, [&] { int32_t s = 0; for (int i = 0; i < calls; ++i) s += fastmath::sin(fa[i & m]).raw; g_sinkI = s; });
+    double libAtan = time_calls(calls, [&] { float s = 0; for (int i = 0; i < calls; ++i) s += std::atan2(a[i & m], b[i & m]); g_sinkF = s; });
+    double fastAtan = time_calls(calls, [&] { float s = 0; for (int i = 0; i < calls; ++i) s += fastmath::atan2(a[i & m], b[i & m]); g_sinkF = s; });
+    double libNorm = time_calls(calls, [&] { float s = 0; for (int i = 0; i < calls; ++i) { float x = a[i & m], y = b[i & m], l = std::sqrt(x * x + y * y); s += x / l + y / l; } g_sinkF = s; });
+    double fastNorm = time_calls(calls, [&] { float s = 0; for (int i = 0; i < calls; ++i) { float x = a[i & m], y = b[i & m], inv; fastmath::length(x, y, &inv); s += x * inv + y * inv; } g_sinkF = s; });
+    double libBurst = time_calls(calls, [&] { float s = 0; for (int i = 0; i < calls; ++i) { float an = (float)(i % 12) / 12.0f * 6.28318f; s += std::cos(an) + std::sin(an); } g_sinkF = s; });
+    const fastmath::Ring ring(12);
+    double fastBurst = time_calls(calls, [&] { float s = 0; for (int i = 0; i < calls; ++i) { float dx, dy; ring.dir(i % 12, dx, dy); s += dx + dy; } g_sinkF = s; });
+
+    printf("sin        libm %6.2f ns  fastmath %6.2f ns  x%.1f\n", libSin, fastSin, fastSin > 0 ? libSin / fastSin : 0.0);
+    printf("sin Q16.16 fx:: %6.2f ns  fastmath %6.2f ns  x%.1f\n", fxSin, fastFxSin, fastFxSin > 0 ? fxSin / fastFxSin : 0.0);
+    printf("atan2      libm %6.2f ns  fastmath %6.2f ns  x%.1f\n", libAtan, fastAtan, fastAtan > 0 ? libAtan / fastAtan : 0.0);
+    printf("normalise  sqrt %6.2f ns  rsqrt    %6.2f ns  x%.1f\n", libNorm, fastNorm, fastNorm > 0 ? libNorm / fastNorm : 0.0);
+    printf("burst dir  libm %6.2f ns  table    %6.2f ns  x%.1f\n", libBurst, fastBurst, fastBurst > 0 ? libBurst / fastBurst : 0.0);
+    return bench_check::report("bench_fastmath");
+}
@@ -0,0 +1,166 @@
+// bench_fixed.cpp - host benchmark: float vs Q16.16 simulation kernel, plus a determinism hash
+//
+// Runs the same per-frame kernel the game uses (ball integration, wall bounces, swept brick
+// collision, falling pickups and particles with gravity, SPEED_MODIFIER scaling, trig for
+// particle bursts) once with T=float and once with T=fx::Fixed. Reports ns per frame for each
+// and a hash of the final state. The Fixed hash depends only on integer math, so it must match
+// across compilers, optimisation levels and the 3DS build; run with -O0 and -O2 to compare.
+//
+// Build/run: make -C tools run-bench
+//            tools/build/bench_fixed [frames] [balls]   (defaults: 20000 64)
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include "layout.hpp"
+#include "collision.hpp"
+#include "fixed.hpp"
+#include "fastmath.hpp"
+
+namespace {
+
+const int kCols = 13, kRows = 13;
+
+// Scalar ops the kernel needs, overloaded per type (same split as sim.hpp)
+inline float k_sin(float v) { return fastmath::sin(v); }
+inline float k_cos(float v) { return fastmath::cos(v); }
+inline fx::Fixed k_sin(fx::Fixed v) { return fastmath::sin(v); }
+inline fx::Fixed k_cos(fx::Fixed v) { return fastmath::cos(v); }
+
+uint32_t bits_of(float v) { uint32_t u; memcpy(&u, &v, 4); return u; }
+uint32_t bits_of(fx::Fixed v) { return (uint32_t)v.raw; }
+
+template <typename T> struct Body { T x, y, vx, vy; int life; };
+
+template <typename T>
+struct World {
+    std::vector<Body<T>> balls, particles, letters;
+    uint8_t solid[kCols * kRows];
+    collision::GridGeom<T> geom;
+};
+
+template <typename T>
+void init_world(World<T> &w, int nBalls)
+{
+    w.geom.left = T(layout::BRICK_GRID_LEFT); w.geom.top = T(layout::BRICK_GRID_TOP);
+    w.geom.cellW = T(layout::BRICK_CELL_W); w.geom.cellH = T(layout::BRICK_CELL_H);
+    w.geom.cols = kCols; w.geom.rows = kRows;
+    w.geom.halfW = T(3); w.geom.halfH = T(3);
+    // Checkerboard band of bricks in rows 2..8 (static; the kernel reflects without removing)
+    for (int r = 0; r < kRows; ++r)
+        for (int c = 0; c < kCols; ++c)
+            w.solid[r * kCols + c] = (r >= 2 && r <= 8 && ((r + c) % 3 != 0)) ? 1 : 0;
+    uint32_t seed = 12345u;
+    for (int i = 0; i < nBalls; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        int sx = (int)(seed >> 24) % 200, sv = (int)((seed >> 8) & 0xFF);
+        Body<T> b;
+        b.x = T(60 + sx); b.y = T(380);
+        b.vx = T((sv - 128) / 64.0f); b.vy = T(-1.5f);
+        b.life = 0;
+        w.balls.push_back(b);
+    }
+}
+
+template <typename T>
+void step_world(World<T> &w, int frame)
+{
+    const T left = T(layout::PLAYFIELD_LEFT_WALL_X), right = T(layout::PLAYFIELD_RIGHT_WALL_X - 6);
+    const T top = T(layout::PLAYFIELD_TOP_WALL_Y), bottom = T(440);
+    for (size_t i = 0; i < w.balls.size(); ++i) {
+        Body<T> &b = w.balls[i];
+        T px = b.x, py = b.y;
+        b.x += b.vx; b.y += b.vy;
+        if (b.x < left) { b.x = left; b.vx = -b.vx; }
+        if (b.x > right) { b.x = right; b.vx = -b.vx; }
+        if (b.y < top) { b.y = top; b.vy = -b.vy; }
+        if (b.y > bottom) { b.y = bottom; b.vy = -b.vy; }
+        const uint8_t *solid = w.solid;
+        collision::SweepHit<T> hit = collision::sweep_grid(w.geom, px + T(3), py + T(3), b.x + T(3), b.y + T(3),
+            [solid](int c, int r) { return solid[r * kCols + c] != 0; });
+        if (hit.hit) {
+            b.x = hit.x - T(3); b.y = hit.y - T(3);
+            if (hit.face == collision::Face::Left || hit.face == collision::Face::Right) b.vx = -b.vx;
+            else b.vy = -b.vy;
+            // Every 8th hit drops a pickup and bursts a few particles
+            if (((hit.col + hit.row + frame) & 7) == 0) {
+                Body<T> l = { hit.x, hit.y, T(0), T(0.5f), 0 };
+                w.letters.push_back(l);
+                for (int k = 0; k < 8; ++k) {
+                    T ang = T(k) / T(8) * T(6.28318f);
+                    T sp = T(0.6f) + T(0.4f) * T(k % 4);
+                    Body<T> p = { hit.x, hit.y, k_cos(ang) * sp, k_sin(ang) * sp, 32 };
+                    w.particles.push_back(p);
+                }
+            }
+        }
+        // Periodic slow/fast pickups scale every ball, as the PK_SLOW / PK_FAST effects do
+        if ((frame % 600) == 300) { b.vx *= T(1.0f - layout::SPEED_MODIFIER); b.vy *= T(1.0f - layout::SPEED_MODIFIER); }
+        if ((frame % 600) == 0) { b.vx *= T(1.0f + layout::SPEED_MODIFIER); b.vy *= T(1.0f + layout::SPEED_MODIFIER); }
+    }
+    for (auto &l : w.letters) { l.y += l.vy; l.vy += T(0.05f); }
+    for (auto &p : w.particles) { if (p.life <= 0) continue; p.x += p.vx; p.y += p.vy; p.vy += T(0.02f); p.life--; }
+    // Compact like the game does (keeps the containers bounded)
+    if (w.letters.size() > 32) {
+        size_t n = 0;
+        for (size_t i = 0; i < w.letters.size(); ++i) if (w.letters[i].y < bottom) w.letters[n++] = w.letters[i];
+        w.letters.resize(n);
+    }
+    if (w.particles.size() > 256) {
+        size_t n = 0;
+        for (size_t i = 0; i < w.particles.size(); ++i) if (w.particles[i].life > 0) w.particles[n++] = w.particles[i];
+        w.particles.resize(n);
+    }
+}
+
+template <typename T>
+uint32_t hash_world(const World<T> &w)
+{
+    uint32_t h = 2166136261u; // FNV-1a over the raw bits of every body
+    auto mix = [&h](uint32_t v) { for (int i = 0; i < 4; ++i) { h ^= (v >> (i * 8)) & 0xFF; h *= 16777619u; } };
+    const std::vector<Body<T>> *lists[] = { &w.balls, &w.particles, &w.letters };
+    for (auto *list : lists) {
+        mix((uint32_t)list->size());
+        for (const auto &b : *list) { mix(bits_of(b.x)); mix(bits_of(b.y)); mix(bits_of(b.vx)); mix(bits_of(b.vy)); }
+    }
+    return h;
+}
+
+template <typename T>
+void run(const char *name, int frames, int nBalls, World<T> &w)
+{
+    init_world(w, nBalls);
+    auto t0 = std::chrono::steady_clock::now();
+    for (int f = 0; f < frames; ++f) step_world(w, f);
+    auto t1 = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+    float sx = 0.f, sy = 0.f;
+    for (const auto &b : w.balls) { sx += fx::to_float(b.x); sy += fx::to_float(b.y); }
+    printf("%-6s %8.1f ns/frame  %7.2f ns/ball  hash=%08x  mean ball=(%.2f, %.2f)\n", name, ns / frames,
+           ns / frames / (nBalls ? nBalls : 1), (unsigned)hash_world(w), sx / nBalls, sy / nBalls);
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    int frames = argc > 1 ? atoi(argv[1]) : 20000;
+    int balls = argc > 2 ? atoi(argv[2]) : 64;
+    if (frames <= 0) frames = 20000;
+    if (balls <= 0) balls = 64;
+    printf("bench_fixed: %d frames, %d balls\n", frames, balls);
+    World<float> wf;
+    run("float", frames, balls, wf);
+    World<fx::Fixed> wx;
+    run("fixed", frames, balls, wx);
+    // Second fixed run from scratch must reproduce the hash bit for bit
+    World<fx::Fixed> wx2;
+    init_world(wx2, balls);
+    for (int f = 0; f < frames; ++f) step_world(wx2, f);
+    bool same = hash_world(wx) == hash_world(wx2);
+    printf("fixed rerun hash %08x (%s)\n", (unsigned)hash_world(wx2), same ? "identical" : "MISMATCH");
+    return same ? 0 : 1;
+}
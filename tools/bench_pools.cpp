@@ -0,0 +1,185 @@
+// bench_pools.cpp - host check + benchmark: entity pools never touch the heap after init
+//
+// Global operator new is replaced with a counting version. The entity pools game.cpp keeps
+// in G (lasers, falling letters, hazards, spawn requests, bomb events) and the particle pool
+// are churned through spawn / despawn / remove_at / full-pool cycles, and the allocation
+// count must not move. The same churn through std::vector with erase(remove_if) is timed
+// alongside for reference. Exits non-zero if a pool allocated or a handle check failed.
+//
+// Build/run: make -C tools run-bench
+//            tools/build/bench_pools [frames]   (default 20000)
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <chrono>
+#include <new>
+#include <vector>
+#include <algorithm>
+#include "pool.hpp"
+#include "particles.hpp"
+#include "fixed.hpp"
+#include "bench_check.hpp"
+
+static long g_allocs = 0;
+void *operator new(std::size_t n)
+{
+    ++g_allocs;
+    if (void *p = std::malloc(n ? n : 1)) return p;
+    std::abort();
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+// Same shapes as the game entities (float build)
+struct Laser { float x, y; };
+struct Letter { float x, y, vy, w, h; int letter; int16_t sprite; };
+struct Spawn { float x, y, vx, vy; bool isMurder; };
+struct Bomb { int c, r, frames; };
+
+using bench_check::expect;
+
+// One simulated frame for letters: spawn a few, fall, drop those past the bottom
+template <typename Letters>
+int letters_frame_pool(Letters &p, uint32_t &seed)
+{
+    for (int k = 0; k < 3; ++k) {
+        seed = seed * 1664525u + 1013904223u;
+        p.spawn(Letter{ (float)(seed >> 24), 0.f, 0.6f + (float)(seed & 7) * 0.1f, 10.f, 11.f, (int)(seed % 5), 3 });
+    }
+    for (int i = 0; i < p.size();) {
+        Letter &L = p[i];
+        L.y += L.vy; L.vy += 0.05f;
+        if (L.y > 480.f) { p.remove_at(i); continue; }
+        ++i;
+    }
+    return p.size();
+}
+
+int letters_frame_vector(std::vector<Letter> &v, uint32_t &seed)
+{
+    for (int k = 0; k < 3; ++k) {
+        seed = seed * 1664525u + 1013904223u;
+        if (v.size() < 64)
+            v.push_back(Letter{ (float)(seed >> 24), 0.f, 0.6f + (float)(seed & 7) * 0.1f, 10.f, 11.f, (int)(seed % 5), 3 });
+    }
+    for (auto &L : v) { L.y += L.vy; L.vy += 0.05f; }
+    v.erase(std::remove_if(v.begin(), v.end(), [](const Letter &L) { return L.y > 480.f; }), v.end());
+    return (int)v.size();
+}
+
+void check_handles()
+{
+    Pool<Laser, 4> p;
+    Pool<Laser, 4>::Handle a, b, c;
+    p.spawn(Laser{ 1, 1 }, &a);
+    p.spawn(Laser{ 2, 2 }, &b);
+    p.spawn(Laser{ 3, 3 }, &c);
+    expect(p.despawn(a), "despawn live handle");
+    expect(!p.get(a), "stale handle after despawn");
+    expect(!p.despawn(a), "double despawn rejected");
+    expect(p.get(c) && p.get(c)->x == 3, "handle follows swap-removed item");
+    expect(p.get(b) && p.get(b)->x == 2, "untouched handle still valid");
+    Pool<Laser, 4>::Handle d;
+    p.spawn(Laser{ 4, 4 }, &d);
+    expect(d.slot == a.slot && d.gen != a.gen, "slot reused with a new generation");
+    expect(!p.get(a), "old handle stays stale after slot reuse");
+    p.spawn(Laser{ 5, 5 });
+    expect(p.full() && !p.spawn(Laser{ 6, 6 }), "spawn into a full pool fails");
+    Pool<Laser, 4>::Handle none;
+    expect(!p.get(none), "default handle is invalid");
+    p.clear();
+    expect(p.empty() && !p.get(b), "clear empties the pool");
+}
+
+void check_particle_recycling()
+{
+    // Spawn four (colour = spawn order), expire the second, then overflow twice
+    particles::Pool<float, 4> q;
+    for (uint32_t k = 0; k < 4; ++k) q.spawn(0.f, 0.f, 0.f, 0.f, k == 1 ? 1 : 10, k);
+    q.integrate(0.f);
+    expect(q.size() == 3, "expired particle removed");
+    q.spawn(0.f, 0.f, 0.f, 0.f, 10, 4);
+    q.spawn(0.f, 0.f, 0.f, 0.f, 10, 5);
+    q.spawn(0.f, 0.f, 0.f, 0.f, 10, 6);
+    uint32_t seen = 0;
+    for (int i = 0; i < q.size(); ++i) seen |= 1u << q.color[i];
+    expect(q.size() == 4 && seen == 0x78u, "full pool recycles the oldest particles first");
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    int frames = argc > 1 ? atoi(argv[1]) : 20000;
+    if (frames <= 0) frames = 20000;
+    printf("bench_pools: %d frames per run\n", frames);
+
+    // Pools live where G keeps them: static storage, constructed before play starts
+    static Pool<Laser, 4> lasers;
+    static Pool<Letter, 64> letters;
+    static Pool<Spawn, 640> spawnQueue;
+    static Pool<Bomb, 364> bombs;
+    static particles::Pool<fx::Fixed, 512> dust;
+    check_handles();
+    check_particle_recycling();
+
+    const long before = g_allocs;
+    uint32_t seed = 12345u;
+    long sink = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int f = 0; f < frames; ++f) {
+        // lasers: fire when empty, travel up, removed at the top
+        if (lasers.empty()) lasers.spawn(Laser{ 100.f, 400.f });
+        for (int i = 0; i < lasers.size();) {
+            lasers[i].y -= 4.f;
+            if (lasers[i].y < 0) { lasers.remove_at(i); continue; }
+            ++i;
+        }
+        sink += letters_frame_pool(letters, seed);
+        // spawn requests: a burst every few frames, drained the same frame
+        if ((f & 7) == 0)
+            for (int k = 0; k < 700; ++k) spawnQueue.spawn(Spawn{ 1.f, 2.f, 0.5f, -1.f, (k & 15) == 0 });
+        for (const auto &req : spawnQueue) sink += req.isMurder;
+        spawnQueue.clear();
+        // bomb events: schedule a chain, count down, remove when done
+        if ((f & 31) == 0)
+            for (int k = 0; k < 40; ++k) bombs.spawn(Bomb{ k % 13, k / 13, k & 7 });
+        for (auto &e : bombs) if (e.frames > 0) --e.frames;
+        bombs.remove_if([](const Bomb &e) { return e.frames <= 0; });
+        // particles: bursts overflow the pool so oldest-first recycling runs too
+        if ((f & 3) == 0) dust.burst(fx::Fixed(160), fx::Fixed(120), 150, fx::Fixed(0.6f), fx::Fixed(0.4f), 4, 32, 0xffffffffu);
+        dust.integrate(fx::Fixed(0.02f));
+        sink += dust.size();
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    const long poolAllocs = g_allocs - before;
+
+    std::vector<Letter> vec;
+    seed = 12345u;
+    long vsink = 0;
+    const long beforeVec = g_allocs;
+    auto t2 = std::chrono::steady_clock::now();
+    for (int f = 0; f < frames; ++f) vsink += letters_frame_vector(vec, seed);
+    auto t3 = std::chrono::steady_clock::now();
+    const long vecAllocs = g_allocs - beforeVec;
+
+    // Reference letter-only timing for the pool, same seed and spawn cap as the vector run
+    letters.clear();
+    seed = 12345u;
+    long psink = 0;
+    auto t4 = std::chrono::steady_clock::now();
+    for (int f = 0; f < frames; ++f) psink += letters_frame_pool(letters, seed);
+    auto t5 = std::chrono::steady_clock::now();
+
+    double allNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / frames;
+    double vecNs = std::chrono::duration<double, std::nano>(t3 - t2).count() / frames;
+    double poolNs = std::chrono::duration<double, std::nano>(t5 - t4).count() / frames;
+    printf("all pools        %8.1f ns/frame  heap allocations after init: %ld (sink %ld)\n", allNs, poolAllocs, sink & 1);
+    printf("letters Pool     %8.1f ns/frame\n", poolNs);
+    printf("letters vector   %8.1f ns/frame  heap allocations: %ld\n", vecNs, vecAllocs);
+    expect(poolAllocs == 0, "pools allocated during steady state");
+    expect(psink == vsink, "pool and vector letter runs diverged");
+    return bench_check::report("bench_pools");
+}
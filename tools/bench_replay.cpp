@@ -0,0 +1,158 @@
+// bench_replay.cpp - host check + benchmark: replay::Writer / replay::Reader round trips
+//
+// Synthetic sessions shaped like play (buttons held for runs of ticks, one-tick edges, stylus
+// drags and idle stretches) are recorded and parsed back; every frame must come back exactly,
+// a changed hash must be reported at its tick, and truncated or corrupted files must be
+// rejected rather than read past their end. Reports bytes per tick and ns per tick for
+// recording and playback. Exits non-zero on any mismatch.
+//
+// Build/run: make -C tools run-bench
+//            tools/build/bench_replay [ticks]   (default 200000)
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "replay.hpp"
+#include "bench_check.hpp"
+
+namespace {
+
+uint32_t g_seed = 7u;
+uint32_t rnd() { g_seed = g_seed * 1664525u + 1013904223u; return g_seed >> 8; }
+
+// Alternates idle stretches, held-button runs with single-tick edges, and stylus drags
+std::vector<replay::Frame> session(int ticks)
+{
+    std::vector<replay::Frame> out;
+    out.reserve(ticks);
+    replay::Frame f;
+    while ((int)out.size() < ticks) {
+        const int len = 1 + (int)(rnd() % 120);
+        const int kind = (int)(rnd() % 3);
+        const uint16_t held = (uint16_t)(rnd() & 0x6024); // fireHeld / dpadDownHeld / L / R
+        for (int t = 0; t < len && (int)out.size() < ticks; ++t) {
+            f.buttons = 0;
+            if (kind == 1) {
+                f.buttons = held;
+                if (t == 0) f.buttons |= (uint16_t)(1u << (3 + rnd() % 10)); // one edge
+            } else if (kind == 2) {
+                f.buttons = 1u | (t == 0 ? 2u : 0u); // touching (+ touchPressed)
+                f.x = (int16_t)(20 + (rnd() % 280));
+                f.y = (int16_t)(150 + t % 60);
+            }
+            if (kind != 2) { f.x = -1; f.y = -1; }
+            out.push_back(f);
+        }
+    }
+    return out;
+}
+
+uint32_t hash_of(int tick) { return (uint32_t)tick * 2654435761u ^ 0x9E3779B9u; }
+
+using bench_check::expect;
+
+replay::Header test_header(uint32_t seed)
+{
+    replay::Header h;
+    snprintf(h.levelFile, sizeof h.levelFile, "LEVELS.DAT");
+    h.startLevel = 3; h.device = 1; h.flags = replay::kFlagMusic; h.seed = seed;
+    return h;
+}
+
+std::vector<uint8_t> record(const std::vector<replay::Frame> &frames, uint32_t seed)
+{
+    replay::Writer w;
+    w.begin(test_header(seed));
+    for (int i = 0; i < (int)frames.size(); ++i) w.tick(frames[i], hash_of(i));
+    return w.serialize();
+}
+
+void check_round_trip(const std::vector<replay::Frame> &frames)
+{
+    std::vector<uint8_t> bytes = record(frames, 1234u);
+    replay::Reader r;
+    expect(r.parse(bytes.data(), bytes.size()), "parse a fresh recording");
+    expect(r.header().ticks == frames.size() && r.header().seed == 1234u && r.header().startLevel == 3 &&
+           std::string(r.header().levelFile) == "LEVELS.DAT", "header round trip");
+    bool same = true, hashes = true;
+    replay::Frame f;
+    for (int i = 0; i < (int)frames.size(); ++i) {
+        if (!r.next(f) || f != frames[i]) { same = false; break; }
+        hashes &= r.check(hash_of(i));
+    }
+    expect(same, "every frame comes back unchanged");
+    expect(hashes && r.first_mismatch() < 0, "recorded hashes match");
+    expect(r.done() && r.valid() && !r.next(f), "stream ends with the recording");
+    printf("round trip %zu ticks -> %zu bytes (%.2f bytes/tick, %.2f of them input)\n", frames.size(), bytes.size(),
+           (double)bytes.size() / frames.size(), (double)bytes.size() / frames.size() - 2.0);
+}
+
+void check_divergence(const std::vector<replay::Frame> &frames)
+{
+    std::vector<uint8_t> bytes = record(frames, 1u);
+    replay::Reader r;
+    r.parse(bytes.data(), bytes.size());
+    const int bad = (int)frames.size() / 2;
+    replay::Frame f;
+    for (int i = 0; r.next(f); ++i) r.check(i >= bad ? hash_of(i) + 1 : hash_of(i));
+    expect(r.first_mismatch() == bad, "first divergent tick is reported");
+}
+
+void check_malformed(const std::vector<replay::Frame> &frames)
+{
+    std::vector<uint8_t> bytes = record(frames, 1u);
+    replay::Reader r;
+    for (size_t cut : { (size_t)0, (size_t)5, (size_t)50, bytes.size() / 3, bytes.size() - 1 })
+        expect(!r.parse(bytes.data(), cut), "truncated file is rejected");
+    std::vector<uint8_t> bad = bytes;
+    bad[0] ^= 0xFF;
+    expect(!r.parse(bad.data(), bad.size()), "wrong magic is rejected");
+    // Random corruption of the input stream must never read out of bounds or loop forever
+    int survived = 0;
+    for (int k = 0; k < 200; ++k) {
+        bad = bytes;
+        bad[52 + rnd() % 64] ^= (uint8_t)(1u << (rnd() % 8));
+        if (!r.parse(bad.data(), bad.size())) continue;
+        replay::Frame f;
+        uint32_t n = 0;
+        while (r.next(f)) ++n;
+        survived += n <= r.header().ticks;
+    }
+    printf("corruption  %d/200 corrupted streams parsed and stayed in bounds\n", survived);
+}
+
+volatile uint32_t g_sink;
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    int ticks = argc > 1 ? atoi(argv[1]) : 200000;
+    if (ticks <= 0) ticks = 200000;
+    printf("bench_replay: %d ticks\n", ticks);
+    std::vector<replay::Frame> frames = session(ticks);
+    check_round_trip(frames);
+    check_divergence(frames);
+    check_malformed(std::vector<replay::Frame>(frames.begin(), frames.begin() + (ticks < 2000 ? ticks : 2000)));
+
+    // Cost per tick on top of game_update: recording while playing, and playback with checks
+    auto t0 = std::chrono::steady_clock::now();
+    replay::Writer w;
+    w.begin(test_header(9u));
+    for (int i = 0; i < ticks; ++i) w.tick(frames[i], hash_of(i));
+    std::vector<uint8_t> bytes = w.serialize();
+    auto t1 = std::chrono::steady_clock::now();
+    replay::Reader r;
+    r.parse(bytes.data(), bytes.size());
+    replay::Frame f;
+    uint32_t sum = 0;
+    for (int i = 0; r.next(f); ++i) { sum += f.buttons + (uint16_t)f.x; r.check(hash_of(i)); }
+    auto t2 = std::chrono::steady_clock::now();
+    g_sink = sum;
+    const double recNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / ticks;
+    const double playNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / ticks;
+    printf("record %6.1f ns/tick  playback %6.1f ns/tick\n", recNs, playNs);
+    return bench_check::report("bench_replay");
+}
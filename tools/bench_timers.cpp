@@ -0,0 +1,189 @@
+// bench_timers.cpp - host benchmark: bomb chain scheduling, scanned vector vs timerwheel::Wheel
+//
+// The vector side is a reference copy of the old process_bomb_events(): every pending event
+// is decremented each tick, due ones are collected into a temporary vector, then the vector
+// is compacted with erase(remove_if), and "already scheduled" is a linear scan. The wheel
+// side is timerwheel::Wheel plus a brickgrid::Mask of pending cells, as game.cpp runs it.
+// Both replay the same chain on a full 13x13 board of bombs with a set of long-running
+// timers pending alongside; the detonation order must match, and the wheel must not allocate.
+//
+// Build/run: make -C tools run-bench
+//            tools/build/bench_timers [runs]   (default 2000)
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <chrono>
+#include <new>
+#include <vector>
+#include <algorithm>
+#include "brickgrid.hpp"
+#include "timerwheel.hpp"
+#include "bench_check.hpp"
+
+static long g_allocs = 0;
+void *operator new(std::size_t n)
+{
+    ++g_allocs;
+    if (void *p = std::malloc(n ? n : 1)) return p;
+    std::abort();
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+const int kCols = brickgrid::kCols, kRows = brickgrid::kRows;
+const int kDelay = 15;       // chain delay used by the game
+const int kIdleTimers = 64;  // long timers pending while the chain runs (never fire)
+
+struct Board {
+    bool bomb[brickgrid::kCells];
+    void fill() { for (int i = 0; i < brickgrid::kCells; ++i) bomb[i] = true; }
+    bool take(int c, int r) {
+        if (c < 0 || r < 0 || c >= kCols || r >= kRows || !bomb[r * kCols + c]) return false;
+        bomb[r * kCols + c] = false;
+        return true;
+    }
+    bool is_bomb(int c, int r) const { return c >= 0 && r >= 0 && c < kCols && r < kRows && bomb[r * kCols + c]; }
+};
+
+// --- old scheme ---------------------------------------------------------------------------
+struct VecEvent { int c, r, frames; };
+
+bool vec_scheduled(const std::vector<VecEvent> &ev, int c, int r)
+{
+    for (const auto &e : ev) if (e.c == c && e.r == r) return true;
+    return false;
+}
+void vec_neighbors(std::vector<VecEvent> &ev, const Board &b, int c, int r)
+{
+    for (int dy = -1; dy <= 1; ++dy)
+        for (int dx = -1; dx <= 1; ++dx)
+            if ((dx || dy) && b.is_bomb(c + dx, r + dy) && !vec_scheduled(ev, c + dx, r + dy))
+                ev.push_back({ c + dx, r + dy, kDelay });
+}
+int run_vector(int *order)
+{
+    Board b; b.fill();
+    std::vector<VecEvent> ev;
+    for (int i = 0; i < kIdleTimers; ++i) ev.push_back({ -1, -1, 1 << 30 });
+    int n = 0;
+    b.take(6, 6); order[n++] = 6 * kCols + 6;
+    vec_neighbors(ev, b, 6, 6);
+    while ((int)ev.size() > kIdleTimers) {
+        for (auto &e : ev) if (e.frames > 0) --e.frames;
+        std::vector<size_t> due;
+        for (size_t i = 0; i < ev.size(); ++i) if (ev[i].frames <= 0) due.push_back(i);
+        for (size_t i : due) {
+            VecEvent e = ev[i];
+            if (!b.take(e.c, e.r)) continue;
+            order[n++] = e.r * kCols + e.c;
+            vec_neighbors(ev, b, e.c, e.r);
+        }
+        ev.erase(std::remove_if(ev.begin(), ev.end(), [](const VecEvent &e) { return e.frames <= 0; }), ev.end());
+    }
+    return n;
+}
+
+// --- wheel --------------------------------------------------------------------------------
+struct Ev { uint16_t cell; };
+typedef timerwheel::Wheel<Ev, 256, brickgrid::kCells + kIdleTimers> Wheel;
+
+struct WheelRun {
+    Wheel wheel;
+    brickgrid::Mask pending;
+    Board b;
+    int *order;
+    int n;
+
+    void neighbors(int c, int r) {
+        for (int dy = -1; dy <= 1; ++dy)
+            for (int dx = -1; dx <= 1; ++dx) {
+                int nc = c + dx, nr = r + dy;
+                if (!(dx || dy) || !b.is_bomb(nc, nr) || pending.test(nr * kCols + nc)) continue;
+                if (wheel.schedule(kDelay, Ev{ (uint16_t)(nr * kCols + nc) })) pending.set(nr * kCols + nc);
+            }
+    }
+    int run() {
+        wheel.clear(); pending.clear(); b.fill(); n = 0;
+        for (int i = 0; i < kIdleTimers; ++i) wheel.schedule(100000 + i, Ev{ 0xFFFF });
+        b.take(6, 6); order[n++] = 6 * kCols + 6;
+        neighbors(6, 6);
+        while (pending.any()) {
+            wheel.advance([this](const Ev &e) {
+                pending.reset(e.cell);
+                int c = e.cell % kCols, r = e.cell / kCols;
+                if (!b.take(c, r)) return;
+                order[n++] = e.cell;
+                neighbors(c, r);
+            });
+        }
+        return n;
+    }
+};
+
+using bench_check::expect;
+
+void check_semantics()
+{
+    timerwheel::Wheel<int, 8, 4> w;
+    timerwheel::Wheel<int, 8, 4>::Handle a, b, c;
+    int fired[8], nf = 0;
+    auto rec = [&](int v) { fired[nf++] = v; };
+    w.schedule(3, 1, &a);
+    w.schedule(11, 2, &b);   // same bucket as a, one turn later
+    w.schedule(3, 3, &c);
+    expect(w.remaining(a) == 3 && w.remaining(b) == 11, "remaining ticks");
+    expect(w.cancel(c) && !w.scheduled(c) && !w.cancel(c), "cancel once");
+    for (int t = 0; t < 3; ++t) w.advance(rec);
+    expect(nf == 1 && fired[0] == 1 && !w.scheduled(a), "due event fires on its tick only");
+    expect(w.scheduled(b) && w.remaining(b) == 8, "later turn stays pending");
+    for (int t = 0; t < 8; ++t) w.advance(rec);
+    expect(nf == 2 && fired[1] == 2 && w.pending() == 0, "later turn fires");
+    // Callbacks may cancel an event due on the same tick, and may clear the wheel
+    w.schedule(1, 10, &a);
+    w.schedule(1, 11, &b);
+    nf = 0;
+    w.advance([&](int v) { fired[nf++] = v; if (v == 10) w.cancel(b); });
+    expect(nf == 1 && w.pending() == 0, "cancel from a callback");
+    w.schedule(1, 20); w.schedule(1, 21); w.schedule(2, 22);
+    nf = 0;
+    w.advance([&](int v) { fired[nf++] = v; w.clear(); });
+    expect(nf == 1 && w.pending() == 0, "clear from a callback");
+    for (int i = 0; i < 4; ++i) w.schedule(1, i);
+    expect(!w.schedule(1, 9), "schedule into a full wheel fails");
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    int runs = argc > 1 ? atoi(argv[1]) : 2000;
+    if (runs <= 0) runs = 2000;
+    printf("bench_timers: %d chain runs, %d idle timers pending\n", runs, kIdleTimers);
+    check_semantics();
+
+    static int vecOrder[brickgrid::kCells], wheelOrder[brickgrid::kCells];
+    static WheelRun wr;
+    wr.order = wheelOrder;
+
+    auto t0 = std::chrono::steady_clock::now();
+    int vn = 0;
+    for (int i = 0; i < runs; ++i) vn = run_vector(vecOrder);
+    auto t1 = std::chrono::steady_clock::now();
+    const long before = g_allocs;
+    int wn = 0;
+    for (int i = 0; i < runs; ++i) wn = wr.run();
+    auto t2 = std::chrono::steady_clock::now();
+    const long wheelAllocs = g_allocs - before;
+
+    bool same = vn == wn;
+    for (int i = 0; same && i < vn; ++i) same = vecOrder[i] == wheelOrder[i];
+    double vecUs = std::chrono::duration<double, std::micro>(t1 - t0).count() / runs;
+    double wheelUs = std::chrono::duration<double, std::micro>(t2 - t1).count() / runs;
+    printf("chain of %d bombs  vector %8.2f us/chain  wheel %8.2f us/chain  x%.1f  wheel allocations: %ld\n",
+           wn, vecUs, wheelUs, wheelUs > 0 ? vecUs / wheelUs : 0.0, wheelAllocs);
+    expect(same, "detonation order differs from the scanned vector");
+    expect(wheelAllocs == 0, "wheel allocated");
+    return bench_check::report("bench_timers");
+}
@@ -0,0 +1,205 @@
+// bench_trajectory.cpp - host check + benchmark: trajectory::predict against per-tick stepping
+//
+// The reference moves the ball one tick at a time the way the game does: sweep_grid over the
+// tick's segment, stop at the first brick contact (pushed clear of the face and reflected),
+// otherwise take the end point and mirror it off the walls. Random boards of static bricks and
+// random launches in the real layout are traced both ways; where the predictor reaches the bat
+// line, the reference must cross it within half a pixel of the predicted x. Cache hits along
+// the first leg, invalidation on velocity and grid changes, and ns per uncached / cached query
+// are reported too. Exits non-zero if agreement or cache behaviour is off.
+//
+// Build/run: make -C tools run-bench
+//            tools/build/bench_trajectory [launches]   (default 20000)
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cmath>
+#include <chrono>
+#include "layout.hpp"
+#include "brickgrid.hpp"
+#include "trajectory.hpp"
+#include "bench_check.hpp"
+
+namespace {
+
+const int kCols = brickgrid::kCols, kRows = brickgrid::kRows, kCells = brickgrid::kCells;
+const float kHalf = 3.0f;        // ball half size (6x6 logical)
+const int kMaxBounces = 12;
+
+struct Scene {
+    uint8_t bricks[kCells];
+    brickgrid::Occupancy occ;
+    collision::GridGeom<float> geom;
+    trajectory::Bounds<float> bounds;
+    bool solid(int c, int r) const { return occ.solid.test(r * kCols + c); }
+};
+
+uint32_t g_seed = 99u;
+uint32_t rnd() { g_seed = g_seed * 1664525u + 1013904223u; return g_seed >> 8; }
+float frand(float lo, float hi) { return lo + (hi - lo) * (float)(rnd() & 0xFFFF) / 65535.0f; }
+
+void setup(Scene &s)
+{
+    s.geom.left = (float)layout::BRICK_GRID_LEFT; s.geom.top = (float)layout::BRICK_GRID_TOP;
+    s.geom.cellW = (float)layout::BRICK_CELL_W; s.geom.cellH = (float)layout::BRICK_CELL_H;
+    s.geom.cols = kCols; s.geom.rows = kRows;
+    s.geom.halfW = kHalf; s.geom.halfH = kHalf;
+    s.bounds.minX = layout::PLAYFIELD_LEFT_WALL_X + kHalf;
+    s.bounds.maxX = layout::PLAYFIELD_RIGHT_WALL_X - 2 * kHalf + kHalf;
+    s.bounds.minY = layout::PLAYFIELD_TOP_WALL_Y + kHalf;
+    s.bounds.batY = layout::kInitialBatY - kHalf;
+}
+
+// Mostly plain bricks, with some indestructible, moving and pass-through ones mixed in
+void random_board(Scene &s, int fillPct)
+{
+    static const BrickType kMix[] = { BrickType::YB, BrickType::GB, BrickType::T5, BrickType::ID,
+                                      BrickType::SS, BrickType::IS, BrickType::AB, BrickType::BO };
+    for (int i = 0; i < kCells; ++i)
+        s.bricks[i] = (int)(rnd() % 100) < fillPct ? (uint8_t)kMix[rnd() % 8] : 0;
+    s.occ.rebuild(s.bricks, kCells);
+}
+
+// Step tick by tick; returns false if the ball ends up inside a brick or runs out of bounces
+bool reference(const Scene &s, float x, float y, float vx, float vy, float &batX)
+{
+    const float eps = 1.0f / 16.0f;
+    int bounces = 0;
+    for (int tick = 0; tick < 20000 && bounces <= kMaxBounces; ++tick) {
+        const float ex = x + vx, ey = y + vy;
+        collision::SweepHit<float> hit = collision::sweep_grid(s.geom, x, y, ex, ey,
+            [&s](int c, int r) { return s.solid(c, r); });
+        if (hit.hit) {
+            if (hit.face == collision::Face::None) return false;
+            x = hit.x; y = hit.y;
+            switch (hit.face) {
+            case collision::Face::Left:  x -= eps; vx = -vx; break;
+            case collision::Face::Right: x += eps; vx = -vx; break;
+            case collision::Face::Top:   y -= eps; vy = -vy; break;
+            default:                     y += eps; vy = -vy; break;
+            }
+            ++bounces;
+            continue;
+        }
+        if (vy > 0 && ey >= s.bounds.batY) {
+            batX = x + vx * ((s.bounds.batY - y) / vy);
+            return true;
+        }
+        x = ex; y = ey;
+        if (x < s.bounds.minX) { x = 2 * s.bounds.minX - x; vx = -vx; ++bounces; }
+        if (x > s.bounds.maxX) { x = 2 * s.bounds.maxX - x; vx = -vx; ++bounces; }
+        if (y < s.bounds.minY) { y = 2 * s.bounds.minY - y; vy = -vy; ++bounces; }
+    }
+    return false;
+}
+
+void random_launch(const Scene &s, float &x, float &y, float &vx, float &vy)
+{
+    // Below the grid, heading anywhere but nearly horizontal
+    x = frand(s.bounds.minX + 1, s.bounds.maxX - 1);
+    y = frand(s.geom.top + s.geom.cellH * kRows + kHalf + 2, s.bounds.batY - 4);
+    const float a = frand(0.3f, 2.84f) * ((rnd() & 1) ? 1.0f : -1.0f);
+    const float speed = frand(1.5f, 5.0f);
+    vx = std::cos(a) * speed; vy = std::sin(a) * speed;
+}
+
+using bench_check::expect;
+
+void check_agreement(int launches)
+{
+    static Scene s;
+    setup(s);
+    int compared = 0, agree = 0, brickBounces = 0;
+    double worst = 0;
+    for (int i = 0; i < launches; ++i) {
+        if (i % 50 == 0) random_board(s, 20 + (int)(rnd() % 50));
+        float x, y, vx, vy;
+        random_launch(s, x, y, vx, vy);
+        trajectory::Path<float> p;
+        trajectory::predict(s.geom, s.bounds, x, y, vx, vy, kMaxBounces,
+                            [&](int c, int r) { return s.solid(c, r); }, p);
+        if (!p.reachesBat) continue;
+        float refX = 0;
+        if (!reference(s, x, y, vx, vy, refX)) continue;
+        ++compared;
+        brickBounces += p.bricks;
+        const double err = std::fabs(refX - p.batX);
+        if (err <= 0.5) ++agree;
+        if (err > worst && err <= 0.5) worst = err;
+    }
+    const double rate = compared ? (double)agree / compared : 0.0;
+    printf("agreement  %d/%d launches within 0.5px (%.2f%%), worst agreeing %.3fpx, %d brick bounces\n",
+           agree, compared, rate * 100.0, worst, brickBounces);
+    // Grazing corner contacts can resolve differently between a whole leg and tick-sized
+    // segments; anything beyond that is a real divergence
+    expect(compared > launches / 4, "enough launches reach the bat to compare");
+    expect(rate >= 0.99, "predictor matches per-tick stepping on 99% of launches");
+}
+
+void check_cache()
+{
+    static Scene s;
+    setup(s);
+    random_board(s, 40);
+    trajectory::Cache<float, 4> cache;
+    auto solid = [&](int c, int r) { return s.solid(c, r); };
+    float x = 160, y = 400, vx = 1.2f, vy = -2.5f;
+    const trajectory::Path<float> *first = &cache.get(0, &s.occ, s.occ.version, s.geom, s.bounds, x, y, vx, vy, 3, solid);
+    expect(first->points >= 2, "path has a first leg");
+    // Walk a few ticks along the first leg: same path back without recomputing
+    for (int t = 1; t <= 5; ++t) cache.get(0, &s.occ, s.occ.version, s.geom, s.bounds, x + vx * t, y + vy * t, vx, vy, 3, solid);
+    expect(cache.stats().misses == 1 && cache.stats().hits == 5, "hits along the first leg");
+    cache.get(0, &s.occ, s.occ.version, s.geom, s.bounds, x, y, -vx, vy, 3, solid);
+    expect(cache.stats().misses == 2, "velocity change misses");
+    const uint32_t before = s.occ.version;
+    int idx = s.occ.any.next(0);
+    s.occ.set(idx < 0 ? 0 : idx, 0);
+    expect(s.occ.version != before, "grid change restamps Occupancy::version");
+    cache.get(0, &s.occ, s.occ.version, s.geom, s.bounds, x, y, -vx, vy, 3, solid);
+    expect(cache.stats().misses == 3, "grid change misses");
+    cache.get(0, &s.occ, s.occ.version, s.geom, s.bounds, x + 40, y, -vx, vy, 3, solid);
+    expect(cache.stats().misses == 4, "ball off the cached leg misses");
+    cache.get(4, &s.occ, s.occ.version, s.geom, s.bounds, x + 40, y, -vx, vy, 3, solid);
+    expect(cache.peek(0) == nullptr && cache.peek(4) != nullptr, "ids sharing a slot evict each other");
+}
+
+volatile float g_sink;
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    int launches = argc > 1 ? atoi(argv[1]) : 20000;
+    if (launches <= 0) launches = 20000;
+    printf("bench_trajectory: %d launches\n", launches);
+    check_agreement(launches);
+    check_cache();
+
+    // Per-frame cost: a fresh prediction against a cached one for a ball moving along its leg
+    static Scene s;
+    setup(s);
+    random_board(s, 50);
+    auto solid = [&](int c, int r) { return s.solid(c, r); };
+    trajectory::Cache<float, 16> cache;
+    const int queries = launches * 10;
+    float x, y, vx, vy;
+    random_launch(s, x, y, vx, vy);
+    auto t0 = std::chrono::steady_clock::now();
+    float sum = 0;
+    for (int i = 0; i < queries; ++i) {
+        trajectory::Path<float> p;
+        trajectory::predict(s.geom, s.bounds, x, y, vx + (i & 7) * 1e-3f, vy, 3, solid, p);
+        sum += p.batX;
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (int i = 0; i < queries; ++i) {
+        const trajectory::Path<float> &p = cache.get(1, &s.occ, s.occ.version, s.geom, s.bounds, x, y, vx, vy, 3, solid);
+        sum += p.batX;
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    g_sink = sum;
+    const double missNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / queries;
+    const double hitNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / queries;
+    printf("predict %8.1f ns/query  cached %6.1f ns/query  x%.0f\n", missNs, hitNs, hitNs > 0 ? missNs / hitNs : 0.0);
+    return bench_check::report("bench_trajectory");
+}